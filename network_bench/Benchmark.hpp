@@ -0,0 +1,264 @@
+#pragma once
+
+#ifndef NETWORK_BENCHMARK_HPP_
+#define NETWORK_BENCHMARK_HPP_
+
+#include "network_core/utility/Numa.hpp"
+#include "network_core/utility/PerfCounters.hpp"
+
+// STL
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bench {
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Result of a single benchmark case
+   */
+  struct Result {
+    std::string name       { };
+    std::string topology   { };
+    std::size_t threads    { 1 };
+    std::size_t iterations { 0 };
+    double      ns_per_op  { 0.0 }; // Mean latency of one operation in one thread
+    double      min_ns     { 0.0 };
+    double      median_ns  { 0.0 };
+    double      ops_per_second { 0.0 }; // Throughput of all threads together
+    network::profiling::Counters counters { }; // Hardware counters of all iterations, filled with --perf
+    double      error      { 0.0 }; // Largest error of an approximation against the exact function, 0 for exact cases
+  };
+
+  class Runner {
+    public:
+      /**
+       * @param t_min_time Minimal measured time of every case in seconds
+       * @param t_filter Only cases whose name contains the filter are run
+       */
+      Runner(double t_min_time, std::string t_filter) : m_min_time(t_min_time), m_filter(std::move(t_filter)) { }
+
+      /**
+       * @brief Count hardware events of the measured iterations
+       */
+      void setPerf(bool t_perf) noexcept { m_perf = t_perf; }
+      bool perf() const noexcept { return m_perf; }
+
+      bool enabled(const std::string& t_name) const
+      {
+        return m_filter.empty() || t_name.find(m_filter) != std::string::npos;
+      }
+
+      /**
+       * @brief Measures the latency of an operation in the calling thread.
+       * @param t_name Name of the case.
+       * @param t_topology Topology or size the case is run on.
+       * @param t_operation Operation to measure.
+       */
+      void latency(const std::string& t_name, const std::string& t_topology, const std::function<void()>& t_operation, double t_error = 0.0)
+      {
+        if(!enabled(t_name)) {
+          return;
+        }
+
+        // Warm up and pick a batch long enough for the clock resolution.
+        std::size_t batch_ { 1 };
+        for(;;) {
+          const auto start_ = Clock::now();
+          for(std::size_t i = 0; i < batch_; ++i) t_operation();
+          if(Clock::now() - start_ > std::chrono::milliseconds(1) || batch_ >= (1u << 20)) break;
+          batch_ *= 2;
+        }
+
+        std::vector<double> samples_ { };
+        std::size_t iterations_ { 0 };
+        double total_ { 0.0 };
+
+        // Counters are opened outside of the measured loop, reading them costs a few system calls per batch.
+        std::unique_ptr<network::profiling::PerfCounters> perf_ { m_perf ? std::make_unique<network::profiling::PerfCounters>() : nullptr };
+        network::profiling::Counters counters_ { };
+
+        while(total_ < m_min_time * 1e9 || samples_.size() < 5) {
+          const auto begin_ = perf_ ? perf_->read() : network::profiling::Counters();
+          const auto start_ = Clock::now();
+          for(std::size_t i = 0; i < batch_; ++i) t_operation();
+          const double elapsed_ = std::chrono::duration<double, std::nano>(Clock::now() - start_).count();
+          if(perf_) counters_ += perf_->read() - begin_;
+
+          samples_.push_back(elapsed_ / static_cast<double>(batch_));
+          iterations_ += batch_;
+          total_ += elapsed_;
+        }
+
+        std::sort(samples_.begin(), samples_.end());
+
+        Result result { };
+        result.name       = t_name;
+        result.topology   = t_topology;
+        result.iterations = iterations_;
+        result.ns_per_op  = total_ / static_cast<double>(iterations_);
+        result.min_ns     = samples_.front();
+        result.median_ns  = samples_[samples_.size() / 2];
+        result.ops_per_second = 1e9 / result.ns_per_op;
+        result.counters   = counters_;
+        result.error      = t_error;
+        add(result);
+      }
+
+      /**
+       * @brief Measures the throughput of independent workers.
+       * @param t_name Name of the case.
+       * @param t_topology Topology the case is run on.
+       * @param t_threads Number of workers.
+       * @param t_operation Operation of a worker, receives the index of the worker and returns the number of processed items.
+       * @param t_cpus CPU every worker is bound to before it starts, empty leaves the workers to the scheduler.
+       */
+      void throughput(const std::string& t_name, const std::string& t_topology, std::size_t t_threads,
+                      const std::function<std::size_t(std::size_t)>& t_operation, const std::vector<std::size_t>& t_cpus = { })
+      {
+        if(!enabled(t_name)) {
+          return;
+        }
+
+        std::atomic<bool> start_ { false };
+        std::vector<std::size_t> items_(t_threads, 0);
+        std::vector<network::profiling::Counters> counters_(t_threads);
+        std::vector<std::thread> workers_ { };
+        const auto deadline_ = std::chrono::duration<double>(m_min_time);
+
+        for(std::size_t t = 0; t < t_threads; ++t) {
+          workers_.emplace_back([&, t]() {
+            if(t < t_cpus.size()) {
+              network::utility::pin(t_cpus[t]);
+            }
+
+            // Counters count only the thread that opened them.
+            std::unique_ptr<network::profiling::PerfCounters> perf_ { m_perf ? std::make_unique<network::profiling::PerfCounters>() : nullptr };
+            while(!start_.load(std::memory_order_acquire)) { std::this_thread::yield(); }
+
+            const auto counters_begin_ = perf_ ? perf_->read() : network::profiling::Counters();
+            const auto begin_ = Clock::now();
+            do {
+              items_[t] += t_operation(t);
+            } while(Clock::now() - begin_ < deadline_);
+            if(perf_) counters_[t] = perf_->read() - counters_begin_;
+          });
+        }
+
+        const auto begin_ = Clock::now();
+        start_.store(true, std::memory_order_release);
+        for(auto& worker : workers_) {
+          worker.join();
+        }
+        const double elapsed_ = std::chrono::duration<double, std::nano>(Clock::now() - begin_).count();
+
+        Result result { };
+        result.name       = t_name;
+        result.topology   = t_topology;
+        result.threads    = t_threads;
+        for(const auto& items : items_) result.iterations += items;
+        for(const auto& counters : counters_) result.counters += counters;
+        result.ns_per_op  = result.iterations ? elapsed_ * static_cast<double>(t_threads) / static_cast<double>(result.iterations) : 0.0;
+        result.min_ns     = result.ns_per_op;
+        result.median_ns  = result.ns_per_op;
+        result.ops_per_second = static_cast<double>(result.iterations) / (elapsed_ * 1e-9);
+        add(result);
+      }
+
+      void add(const Result& t_result)
+      {
+        std::clog << "[BENCH] " << std::left << std::setw(34) << t_result.name << std::setw(18) << t_result.topology
+                  << " threads:" << t_result.threads << " " << std::fixed << std::setprecision(1) << t_result.ns_per_op << " ns/op "
+                  << t_result.ops_per_second << " op/s";
+        if(t_result.error > 0.0) {
+          std::clog << " error:" << std::scientific << std::setprecision(2) << t_result.error << std::fixed;
+        }
+        if(m_perf) {
+          const auto& c = t_result.counters;
+          if(c.has(network::profiling::Event::Cycles) && c.has(network::profiling::Event::Instructions)) {
+            std::clog << " ipc:" << std::setprecision(2) << c.ipc();
+          }
+          if(c.has(network::profiling::Event::CacheMisses) && c.has(network::profiling::Event::CacheReferences)) {
+            std::clog << " cache-miss:" << std::setprecision(3) << c.cacheMissRate();
+          }
+          if(c.has(network::profiling::Event::BranchMisses) && c.has(network::profiling::Event::Branches)) {
+            std::clog << " branch-miss:" << std::setprecision(3) << c.branchMissRate();
+          }
+        }
+        std::clog << std::endl;
+        m_results.push_back(t_result);
+      }
+
+      /**
+       * @brief Writes all results as JSON.
+       * @param t_stream Output stream.
+       * @param t_context Key-value description of the run (version, compiler, host).
+       */
+      void write(std::ostream& t_stream, const std::vector<std::pair<std::string, std::string>>& t_context) const
+      {
+        auto quote = [](const std::string& t_value) {
+          std::string result_ { "\"" };
+          for(const char c : t_value) {
+            if(c == '"' || c == '\\') result_ += '\\';
+            result_ += c;
+          }
+          return result_ + "\"";
+        };
+
+        t_stream << std::setprecision(6) << std::fixed;
+        t_stream << "{\n  \"context\": {";
+        for(std::size_t i = 0; i < t_context.size(); ++i) {
+          t_stream << (i ? "," : "") << "\n    " << quote(t_context[i].first) << ": " << quote(t_context[i].second);
+        }
+        t_stream << "\n  },\n  \"benchmarks\": [";
+        for(std::size_t i = 0; i < m_results.size(); ++i) {
+          const auto& r = m_results[i];
+          t_stream << (i ? "," : "") << "\n    {"
+                   << "\"name\": " << quote(r.name) << ", "
+                   << "\"topology\": " << quote(r.topology) << ", "
+                   << "\"threads\": " << r.threads << ", "
+                   << "\"iterations\": " << r.iterations << ", "
+                   << "\"ns_per_op\": " << r.ns_per_op << ", "
+                   << "\"min_ns\": " << r.min_ns << ", "
+                   << "\"median_ns\": " << r.median_ns << ", "
+                   << "\"ops_per_second\": " << r.ops_per_second;
+          if(r.error > 0.0) {
+            t_stream << ", \"error\": " << std::scientific << r.error << std::fixed;
+          }
+          if(m_perf) {
+            // Events the host can't count are written as null.
+            static const std::array<const char*, network::profiling::Counters::EVENTS> events_ {
+              { "cycles", "instructions", "cache_references", "cache_misses", "branches", "branch_misses" }
+            };
+            const double ops_ = r.iterations ? static_cast<double>(r.iterations) : 1.0;
+            t_stream << ", \"counters_per_op\": {";
+            for(std::size_t e = 0; e < events_.size(); ++e) {
+              t_stream << (e ? ", " : "") << "\"" << events_[e] << "\": ";
+              if(r.counters.available[e]) t_stream << static_cast<double>(r.counters.values[e]) / ops_;
+              else t_stream << "null";
+            }
+            t_stream << "}";
+          }
+          t_stream << "}";
+        }
+        t_stream << "\n  ]\n}\n";
+      }
+
+    private:
+      double              m_min_time { 0.5 };
+      bool                m_perf     { false };
+      std::string         m_filter   { };
+      std::vector<Result> m_results  { };
+  };
+} // namespace bench
+#endif // NETWORK_BENCHMARK_HPP_
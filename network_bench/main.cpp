@@ -0,0 +1,499 @@
+#include "network_core/Network.hpp"
+#include "network_core/InferenceModel.hpp"
+#include "network_core/ModelReplicas.hpp"
+#include "network_core/IncrementalSession.hpp"
+#include "network_core/Ensemble.hpp"
+#include "network_core/utility/Numa.hpp"
+#include "network_core/utility/Kernels.hpp"
+#include "network_core/utility/ThreadPool.hpp"
+#include "Benchmark.hpp"
+
+// Boost
+#include <boost/filesystem.hpp>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace fs = boost::filesystem;
+
+namespace {
+  using Neuron = network::primitives::Neuron;
+  using Layer  = network::primitives::Layer<Neuron>;
+
+  /**
+   * @brief Sizes written as "input-hidden...-output", e.g. "10000-5-1"
+   */
+  std::vector<std::size_t> parseTopology(const std::string& t_topology)
+  {
+    std::vector<std::size_t> sizes { };
+    std::stringstream stream(t_topology);
+    for(std::string size; std::getline(stream, size, '-');) {
+      sizes.push_back(std::stoul(size));
+    }
+    return sizes;
+  }
+
+  int usage(const char* t_name)
+  {
+    std::cout << "Usage: " << t_name << " [--output file.json] [--filter name] [--min-time seconds] [--threads 1-2-4] [--perf]" << std::endl;
+    return 1;
+  }
+
+  std::unique_ptr<network::Network> makeNetwork(const std::vector<std::size_t>& t_sizes)
+  {
+    network::InputLayer  input  { };
+    network::HiddenLayer hidden { };
+    network::OutputLayer output { };
+
+    input.create(t_sizes.front(), std::true_type{});
+    for(std::size_t i = 1; i + 1 < t_sizes.size(); ++i) {
+      hidden.create(t_sizes[i], std::false_type{});
+    }
+    output.create(t_sizes.back(), std::true_type{});
+
+    return std::make_unique<network::Network>(input, hidden, output);
+  }
+
+  /**
+   * @brief Synthetic dataset with one folder of random square images per output neuron
+   */
+  struct Dataset {
+    fs::path                 path      { };
+    std::vector<std::string> categorys { };
+    std::vector<std::string> images    { };
+
+    Dataset(const std::vector<std::size_t>& t_sizes, std::size_t t_images)
+    {
+      const int side_ = static_cast<int>(std::lround(std::sqrt(static_cast<double>(t_sizes.front()))));
+      path = fs::temp_directory_path() / fs::unique_path("network_bench_%%%%-%%%%");
+
+      for(std::size_t c = 0; c < t_sizes.back(); ++c) {
+        categorys.push_back("category_" + std::to_string(c));
+        fs::create_directories(path / categorys.back());
+
+        for(std::size_t i = 0; i < t_images; ++i) {
+          cv::Mat image(side_, side_, CV_8UC3);
+          cv::randu(image, 0, 255);
+
+          images.push_back((path / categorys.back() / (std::to_string(i) + ".png")).string());
+          cv::imwrite(images.back(), image);
+        }
+      }
+    }
+
+    Dataset(const Dataset&) = delete;
+    Dataset& operator=(const Dataset&) = delete;
+
+    ~Dataset()
+    {
+      boost::system::error_code error;
+      fs::remove_all(path, error);
+    }
+  };
+
+  void benchKernels(bench::Runner& t_runner, const std::vector<std::pair<std::size_t, std::size_t>>& t_shapes)
+  {
+    for(const auto& [inputs, outputs] : t_shapes) {
+      const std::string shape_ = std::to_string(inputs) + "x" + std::to_string(outputs);
+
+      Layer input_(inputs);
+      Layer output_(outputs);
+      output_.connect(input_);
+
+      t_runner.latency("Neuron::computeOutputValue", shape_, [&]() { (*output_.begin())->computeOutputValue(); });
+      t_runner.latency("Layer::calculate", shape_, [&]() { output_.calculate(); });
+      t_runner.latency("Layer::update(target)", shape_, [&]() { output_.update(std::size_t { 0 }); });
+      t_runner.latency("Layer::update(Layer)", shape_, [&]() { input_.update(output_); });
+      t_runner.latency("Layer::updateWeight", shape_, [&]() { output_.updateWeight(); });
+
+      // The same layer with 90% of the weights removed calculates in CSR form.
+      std::vector<double> magnitudes_ { };
+      output_.magnitudes(magnitudes_);
+      const auto threshold_ = magnitudes_.begin() + static_cast<std::ptrdiff_t>(magnitudes_.size() * 9 / 10);
+      std::nth_element(magnitudes_.begin(), threshold_, magnitudes_.end());
+      output_.prune(*threshold_);
+
+      t_runner.latency("Layer::calculate(sparse)", shape_, [&]() { output_.calculate(); });
+    }
+  }
+
+  /**
+   * @brief Exact and approximate activations over arrays, the error is relative for exp and absolute otherwise
+   */
+  void benchActivations(bench::Runner& t_runner, const std::vector<std::size_t>& t_sizes)
+  {
+    using network::computation::Approximation;
+    static const std::vector<std::pair<Approximation, std::string>> approximations_ {
+      { Approximation::Exact, "exact" }, { Approximation::Polynomial, "polynomial" }, { Approximation::Table, "table" }
+    };
+
+    using Kernel = void (*)(const double*, double*, std::size_t, Approximation) noexcept;
+    const std::vector<std::tuple<std::string, Kernel, double, bool>> kernels_ {
+      { "computation::vexp",     &network::computation::vexp,     30.0, true  },
+      { "computation::vsigmoid", &network::computation::vsigmoid, 20.0, false },
+      { "computation::vtanh",    &network::computation::vtanh,    10.0, false }
+    };
+
+    for(const auto& size : t_sizes) {
+      // Arguments spread over the range where the functions change.
+      std::vector<double> x_(size), exact_(size), y_(size);
+
+      for(const auto& [name, kernel, range, relative] : kernels_) {
+        for(std::size_t i = 0; i < size; ++i) {
+          x_[i] = range * (2.0 * static_cast<double>(i) / static_cast<double>(size) - 1.0);
+        }
+        kernel(x_.data(), exact_.data(), size, Approximation::Exact);
+
+        for(const auto& [approximation, suffix] : approximations_) {
+          kernel(x_.data(), y_.data(), size, approximation);
+
+          double error_ { 0.0 };
+          for(std::size_t i = 0; i < size; ++i) {
+            const double difference_ = std::abs(y_[i] - exact_[i]);
+            error_ = std::max(error_, relative ? difference_ / exact_[i] : difference_);
+          }
+
+          t_runner.latency(name + "(" + suffix + ")", std::to_string(size), [&, kernel = kernel, approximation = approximation]() {
+            kernel(x_.data(), y_.data(), size, approximation);
+          }, error_);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Augmentation of one square 8-bit image into input values, by kind of transformation
+   */
+  void benchAugmentation(bench::Runner& t_runner, const std::vector<std::size_t>& t_sides)
+  {
+    network::Augmentation geometric_ { };
+    geometric_.flip  = 0.5;
+    geometric_.shift = 2;
+
+    network::Augmentation photometric_ { };
+    photometric_.brightness = 0.1;
+    photometric_.contrast   = 0.1;
+    photometric_.noise      = 0.02;
+
+    network::Augmentation all_ = photometric_;
+    all_.flip     = geometric_.flip;
+    all_.shift    = geometric_.shift;
+    all_.rotation = 10.0;
+
+    const std::vector<std::pair<std::string, network::Augmentation>> kinds_ {
+      { "geometric", geometric_ }, { "photometric", photometric_ }, { "all", all_ }
+    };
+
+    for(const auto side : t_sides) {
+      std::vector<unsigned char> pixels_(side * side);
+      std::vector<double> values_(side * side);
+      for(std::size_t i = 0; i < pixels_.size(); ++i) pixels_[i] = static_cast<unsigned char>(i * 131 % 251);
+
+      for(const auto& [kind, augmentation] : kinds_) {
+        std::uint64_t key_ { 0 };
+        t_runner.latency("augment(" + kind + ")", std::to_string(side) + "x" + std::to_string(side), [&, &augmentation = augmentation]() {
+          network::augment(augmentation, key_++, pixels_.data(), side, side, side, values_.data());
+        });
+      }
+    }
+  }
+
+  /**
+   * @brief Stream of inputs of which a share changes between two calls, recalculated and updated incrementally
+   */
+  void benchIncremental(bench::Runner& t_runner, const std::string& t_topology, const std::vector<double>& t_ratios)
+  {
+    if(!t_runner.enabled("InferenceModel::forward") && !t_runner.enabled("IncrementalSession::forward")) {
+      return;
+    }
+
+    const auto sizes_ = parseTopology(t_topology);
+    auto network_ = makeNetwork(sizes_);
+    std::vector<std::string> labels_ { };
+    for(std::size_t c = 0; c < sizes_.back(); ++c) labels_.push_back("category_" + std::to_string(c));
+    network_->setLabels(labels_);
+    const auto model_ = network_->freeze();
+
+    std::mt19937 random_ { 42 };
+    std::uniform_int_distribution<std::size_t> index_(0, model_->inputs() - 1);
+    std::uniform_int_distribution<int> pixel_(0, 255);
+    std::vector<double> input_(model_->inputs());
+    std::vector<double> output_(model_->outputs());
+    for(auto& value : input_) value = pixel_(random_) / 255.0;
+
+    for(const auto ratio : t_ratios) {
+      const std::size_t changes_ = std::max<std::size_t>(1, static_cast<std::size_t>(ratio * static_cast<double>(input_.size())));
+      const auto change = [&]() {
+        for(std::size_t i = 0; i < changes_; ++i) input_[index_(random_)] = pixel_(random_) / 255.0;
+      };
+
+      std::ostringstream name_;
+      name_ << t_topology << " " << ratio * 100.0 << "%";
+
+      t_runner.latency("InferenceModel::forward", name_.str(), [&]() {
+        change();
+        model_->forward(input_.data(), output_.data());
+      });
+
+      network::IncrementalSession session_(model_);
+      t_runner.latency("IncrementalSession::forward", name_.str(), [&]() {
+        change();
+        session_.forward(input_.data(), output_.data());
+      });
+    }
+  }
+
+  /**
+   * @brief Independently initialized models answering one image file, each on its own or as an ensemble
+   */
+  void benchEnsemble(bench::Runner& t_runner, const std::string& t_topology, std::size_t t_members, std::size_t t_threads)
+  {
+    if(!t_runner.enabled("InferenceModel::perception(members)") && !t_runner.enabled("Ensemble::perception")) {
+      return;
+    }
+
+    const auto sizes_ = parseTopology(t_topology);
+    std::vector<std::string> labels_ { };
+    for(std::size_t c = 0; c < sizes_.back(); ++c) labels_.push_back("category_" + std::to_string(c));
+
+    std::vector<network::InferenceModelPtr> members_ { };
+    for(std::size_t m = 0; m < t_members; ++m) {
+      auto network_ = makeNetwork(sizes_);
+      network_->setLabels(labels_);
+      members_.push_back(network_->freeze());
+    }
+
+    // Members on their own decode the file once each, the ensemble decodes it once.
+    Dataset dataset_(sizes_, 1);
+    const auto& image_ = dataset_.images.front();
+
+    const std::string name_ = t_topology + " x" + std::to_string(t_members);
+    t_runner.latency("InferenceModel::perception(members)", name_, [&]() {
+      for(const auto& member : members_) member->perception(image_, 1);
+    });
+
+    const network::Ensemble ensemble_(members_);
+    t_runner.latency("Ensemble::perception", name_, [&]() { ensemble_.perception(image_, 1); });
+
+    if(t_threads > 1) {
+      const network::Ensemble pooled_(members_, network::Ensemble::Combination::Mean, { },
+                                      std::make_shared<network::utility::ThreadPool>(std::min(t_threads, t_members)));
+      t_runner.latency("Ensemble::perception(pool)", name_, [&]() { pooled_.perception(image_, 1); });
+    }
+  }
+
+  /**
+   * @brief Online step of a softmax classifier against the number of categories, every output updated or only the sampled ones
+   */
+  void benchOutputs(bench::Runner& t_runner, const std::string& t_topology, const std::vector<std::size_t>& t_categorys)
+  {
+    if(!t_runner.enabled("Network::learn") && !t_runner.enabled("Network::learn(sampled)")) {
+      return;
+    }
+
+    auto sizes_ = parseTopology(t_topology);
+    const int side_ = static_cast<int>(std::lround(std::sqrt(static_cast<double>(sizes_.front()))));
+    cv::Mat image_(side_, side_, CV_8UC3);
+    cv::randu(image_, 0, 255);
+
+    for(const auto categorys : t_categorys) {
+      sizes_.push_back(categorys);
+      const std::string name_ = t_topology + "-" + std::to_string(categorys);
+
+      for(const bool sampled : { false, true }) {
+        auto network_ = makeNetwork(sizes_);
+        std::vector<std::string> labels_ { };
+        for(std::size_t c = 0; c < categorys; ++c) labels_.push_back("category_" + std::to_string(c));
+        network_->setLabels(labels_);
+        network_->setOutputFunction(network::OutputFunction::Softmax);
+        if(sampled) {
+          network_->setOutputSampling({ 0.01, 0.05 });
+        }
+
+        std::size_t label_ { 0 };
+        t_runner.latency(sampled ? "Network::learn(sampled)" : "Network::learn", name_, [&]() {
+          network_->learn(image_, label_);
+          label_ = (label_ + 1) % categorys;
+        });
+      }
+
+      sizes_.pop_back();
+    }
+  }
+
+  void benchNetwork(bench::Runner& t_runner, const std::string& t_topology, const std::vector<std::size_t>& t_threads)
+  {
+    const auto sizes_ = parseTopology(t_topology);
+
+    t_runner.latency("Network::Network", t_topology, [&]() { makeNetwork(sizes_); });
+
+    if(!t_runner.enabled("Network::perception") && !t_runner.enabled("InferenceModel::perception")
+    && !t_runner.enabled("Network::education")) {
+      return;
+    }
+
+    Dataset dataset_(sizes_, 4);
+
+    for(const auto threads : t_threads) {
+      std::vector<std::unique_ptr<network::Network>> networks_ { };
+      for(std::size_t t = 0; t < threads; ++t) {
+        networks_.push_back(makeNetwork(sizes_));
+        networks_.back()->setDataset(dataset_.path.string());
+        networks_.back()->setCategorys(dataset_.categorys);
+        networks_.back()->setEpoch(1);
+      }
+
+      t_runner.throughput("Network::perception", t_topology, threads, [&](std::size_t t) {
+        networks_[t]->perception(dataset_.images[t % dataset_.images.size()]);
+        return std::size_t { 1 };
+      });
+
+      // One frozen model is shared by all threads.
+      const auto model_ = networks_.front()->freeze();
+      t_runner.throughput("InferenceModel::perception", t_topology, threads, [&](std::size_t t) {
+        model_->perception(dataset_.images[t % dataset_.images.size()], 1);
+        return std::size_t { 1 };
+      });
+
+      // Threads bound across the NUMA nodes, reading the one model or the replica of their node.
+      const auto cpus_ = network::utility::placement(threads);
+      t_runner.throughput("InferenceModel::perception(pinned)", t_topology, threads, [&](std::size_t t) {
+        model_->perception(dataset_.images[t % dataset_.images.size()], 1);
+        return std::size_t { 1 };
+      }, cpus_);
+
+      if(t_runner.enabled("InferenceModel::perception(replicas)")) {
+        const network::ModelReplicas replicas_(model_);
+        t_runner.throughput("InferenceModel::perception(replicas)", t_topology, threads, [&](std::size_t t) {
+          replicas_.local().perception(dataset_.images[t % dataset_.images.size()], 1);
+          return std::size_t { 1 };
+        }, cpus_);
+      }
+
+      t_runner.throughput("Network::education", t_topology, threads, [&](std::size_t t) {
+        networks_[t]->education();
+        return dataset_.images.size();
+      });
+    }
+
+    // Breakdown of one education pass by phase and layer.
+    if(t_runner.perf() && t_runner.enabled("Network::education")) {
+      auto network_ = makeNetwork(sizes_);
+      network_->setDataset(dataset_.path.string());
+      network_->setCategorys(dataset_.categorys);
+      network_->setEpoch(1);
+
+      auto profiler_ = std::make_shared<network::profiling::Profiler>();
+      network_->setProfiler(profiler_);
+      network_->education();
+
+      std::clog << "[PERF] " << t_topology << "\n" << *profiler_ << std::endl;
+    }
+  }
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+  std::string output_ { };
+  std::string filter_ { };
+  double min_time_ { 0.5 };
+  std::vector<std::size_t> threads_ { };
+  bool perf_ { false };
+
+  // Malformed numbers end in the usage instead of an uncaught exception.
+  try {
+    for(int i = 1; i < argc; ++i) {
+      const std::string arg_ { argv[i] };
+      if(arg_ == "--output" && i + 1 < argc) {
+        output_ = argv[++i];
+      } else if(arg_ == "--filter" && i + 1 < argc) {
+        filter_ = argv[++i];
+      } else if(arg_ == "--min-time" && i + 1 < argc) {
+        min_time_ = std::stod(argv[++i]);
+      } else if(arg_ == "--threads" && i + 1 < argc) {
+        threads_ = parseTopology(argv[++i]);
+      } else if(arg_ == "--perf") {
+        perf_ = true;
+      } else {
+        return usage(argv[0]);
+      }
+    }
+  } catch(const std::invalid_argument&) {
+    return usage(argv[0]);
+  } catch(const std::out_of_range&) {
+    return usage(argv[0]);
+  }
+
+  // Every measurement needs at least one thread and a time to run.
+  if(!std::isfinite(min_time_) || min_time_ < 0.0
+     || std::find(threads_.begin(), threads_.end(), std::size_t { 0 }) != threads_.end()) {
+    return usage(argv[0]);
+  }
+
+  const std::size_t hardware_ = std::max(1u, std::thread::hardware_concurrency());
+  if(threads_.empty()) {
+    threads_.push_back(1);
+    for(std::size_t t = 2; t < hardware_; t *= 2) threads_.push_back(t);
+    if(hardware_ > 1) threads_.push_back(hardware_);
+  }
+
+  bench::Runner runner(min_time_, filter_);
+  runner.setPerf(perf_);
+
+  if(perf_ && !network::profiling::PerfCounters().available()) {
+    std::clog << "\x1b[33m[WARN] Hardware counters are unavailable, only timings are reported.\x1b[0m" << std::endl;
+  }
+
+  // Tiles of the kernels are tuned once, every case below runs with them.
+  const auto tiles_ = network::computation::tune();
+
+  benchKernels(runner, { {10000, 1}, {10000, 5}, {10000, 64}, {1024, 64}, {64, 10} });
+  benchActivations(runner, { 64, 4096 });
+  benchAugmentation(runner, { 28, 100 });
+
+  for(const auto& topology : { "10000-5-1", "10000-5-2", "10000-32-10", "1024-64-10", "4096-128-64-10" }) {
+    benchNetwork(runner, topology, threads_);
+  }
+
+  // Shares below and above the threshold of the session, which recalculates past 10%.
+  benchIncremental(runner, "10000-32-10", { 0.001, 0.01, 0.05, 0.2 });
+
+  benchEnsemble(runner, "1024-64-10", 5, hardware_);
+
+  // Past a few hundred categories most softmax outputs are close to zero, sampling skips most of their updates.
+  benchOutputs(runner, "64-32", { 10, 100, 1000, 4000 });
+
+  const std::vector<std::pair<std::string, std::string>> context_ {
+    { "version",  NETWORK_VERSION },
+    { "compiler", __VERSION__ },
+    { "build",    NETWORK_BUILD_TYPE },
+    { "hardware_concurrency", std::to_string(hardware_) },
+    { "numa_nodes", std::to_string(network::utility::numaNodes().size()) },
+    { "min_time", std::to_string(min_time_) },
+    { "perf",     perf_ ? "true" : "false" },
+    { "tiles",    std::to_string(tiles_.gemv) + " " + std::to_string(tiles_.m) + "x" + std::to_string(tiles_.n) + "x" + std::to_string(tiles_.k) }
+  };
+
+  if(output_.empty()) {
+    runner.write(std::cout, context_);
+  } else {
+    std::ofstream file(output_);
+    runner.write(file, context_);
+  }
+
+  return 0;
+}
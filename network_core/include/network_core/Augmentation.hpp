@@ -0,0 +1,41 @@
+#pragma once
+
+#ifndef NETWORK_AUGMENTATION_HPP_
+#define NETWORK_AUGMENTATION_HPP_
+
+// STL
+#include <cstddef>
+#include <cstdint>
+
+namespace network {
+  /**
+   * @brief Random transformation of every sample during education
+   *
+   * The transformation of a sample depends only on the seed and on the key of the sample, so an education
+   * is reproducible and samples may be augmented by any thread or process in any order.
+   */
+  struct Augmentation {
+    double        flip       { 0.0 }; // Probability of a horizontal flip
+    std::size_t   shift      { 0 };   // Largest shift in pixels along each axis
+    double        rotation   { 0.0 }; // Largest rotation in degrees, either way
+    double        brightness { 0.0 }; // Largest offset added to the values in [0, 1]
+    double        contrast   { 0.0 }; // Largest relative change of the distance of the values from 0.5
+    double        noise      { 0.0 }; // Standard deviation of the noise added to every value
+    std::uint64_t seed       { 0 };
+
+    inline bool enabled() const noexcept
+    {
+      return flip > 0.0 || shift > 0 || rotation > 0.0 || brightness > 0.0 || contrast > 0.0 || noise > 0.0;
+    }
+  };
+
+  /**
+   * @brief Augmented input values of an 8-bit image, laid out as Network::fill() lays out the plain ones
+   * @param t_key Key of the sample, the same key gives the same transformation.
+   * @param t_pixels First byte of the image, value (r, c) is t_pixels[r * t_stride + c].
+   * @param t_values t_rows * t_cols values in [0, 1], pixels moved in from outside the image are 0 before the jitter.
+   */
+  void augment(const Augmentation& t_augmentation, std::uint64_t t_key, const unsigned char* t_pixels, std::size_t t_rows,
+               std::size_t t_cols, std::size_t t_stride, double* t_values) noexcept;
+} // namespace network
+#endif // NETWORK_AUGMENTATION_HPP_
@@ -13,6 +13,9 @@ namespace network {
       static constexpr inline double ESP                     { 0.01 }; // Differentiation step
       static constexpr inline double TRESHOLD_SINGLE_JUMP    { 10.0 }; // Coefficient for single_jump function
       static constexpr inline double DEGREE_FUNCTION         { 1.00 }; // Coefficient for sigmoid function
+      static constexpr inline double DENSITY_SPARSE          { 0.40 }; // Layers with a smaller share of synapses are calculated in CSR form
+      static constexpr inline double SIGMOID_TABLE_RANGE     { 16.0 }; // computation::sigmoid_table() covers [-range, range], outside it is constant
+      static constexpr inline double SIGMOID_TABLE_STEPS     { 128.0 }; // Values of computation::sigmoid_table() per unit
     };
 } /* namespace network */
 #endif /* NETWORK_CONSTANTS_HPP_ */
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#ifndef NETWORK_DATASET_HPP_
+#define NETWORK_DATASET_HPP_
+
+#include "network_core/Forward.hpp"
+
+// STL
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+namespace network {
+  /**
+   * @brief Images of a dataset folder decoded once
+   *
+   * The folder is scanned the way education() scans it: every subfolder named after a category holds its
+   * images. The dataset doesn't change after the construction, networks educated in several threads share
+   * it through Network::setDataset(DatasetPtr) without copying the pixels.
+   */
+  class Dataset {
+    public:
+      using TypeSample = std::pair<cv::Mat, std::size_t>; // Image with the index of its category
+
+      /**
+       * @brief Image files of a dataset folder, in the order of samples()
+       */
+      struct Listing {
+        std::vector<std::string> categorys { }; // Categories that have a folder, in the order they were requested
+        std::vector<std::string> paths     { };
+        std::vector<std::size_t> labels    { }; // Index in categorys of every file
+      };
+
+      /**
+       * @brief Scan the folder as the constructor does without decoding the images
+       * @throws Network::FolderNotFoundError If the folder doesn't exist.
+       */
+      static Listing list(const std::string& t_path, const std::vector<std::string>& t_categorys);
+
+      /**
+       * @param t_path Folder with one subfolder per category.
+       * @param t_categorys Categories to decode, other folders are skipped.
+       * @param t_pool Threads that decode the images together, nullptr decodes one after another.
+       * @throws Network::FolderNotFoundError If the folder doesn't exist.
+       */
+      Dataset(const std::string& t_path, const std::vector<std::string>& t_categorys, const utility::ThreadPoolPtr& t_pool = nullptr);
+
+      Dataset(const Dataset&) = delete;
+      Dataset& operator=(const Dataset&) = delete;
+
+      inline const std::string& path() const noexcept { return m_path; }
+
+      /**
+       * @brief Categories that have a folder, in the order they were requested
+       */
+      inline const std::vector<std::string>& categorys() const noexcept { return m_categorys; }
+
+      /**
+       * @brief Images of every category one after another, the files of a category sorted by name
+       */
+      inline const std::vector<TypeSample>& samples() const noexcept { return m_samples; }
+
+      /**
+       * @brief Bytes of the decoded pixels
+       */
+      std::size_t bytes() const noexcept;
+
+    private:
+      std::string              m_path      { };
+      std::vector<std::string> m_categorys { };
+      std::vector<TypeSample>  m_samples   { };
+  };
+} // namespace network
+#endif // NETWORK_DATASET_HPP_
@@ -0,0 +1,39 @@
+#pragma once
+
+#ifndef NETWORK_EDUCATION_CONTROL_HPP_
+#define NETWORK_EDUCATION_CONTROL_HPP_
+
+// STL
+#include <cstddef>
+
+namespace network {
+  /**
+   * @brief State of a running education, passed after every sample
+   */
+  struct EducationProgress {
+    std::size_t epoch              { 0 };
+    std::size_t epochs             { 0 };
+    std::size_t samples            { 0 };     // Samples of the epoch so far
+    double      loss               { 0.0 };   // Mean loss of the samples of the epoch so far
+    double      samples_per_second { 0.0 };   // Since the start of the epoch
+    bool        end                { false }; // Last call of the epoch, after the pruning
+  };
+
+  /**
+   * @brief Steering of education() from another thread
+   *
+   * proceed() is called from the education loop between two samples, the network is consistent there.
+   * It may block, the education waits until it returns.
+   */
+  class EducationControl {
+    public:
+      virtual ~EducationControl() = default;
+
+      /**
+       * @brief Decide whether the education continues.
+       * @return False stops the education, education() returns false.
+       */
+      virtual bool proceed(const EducationProgress& t_progress) = 0;
+  };
+} // namespace network
+#endif // NETWORK_EDUCATION_CONTROL_HPP_
@@ -0,0 +1,97 @@
+#pragma once
+
+#ifndef NETWORK_ENSEMBLE_HPP_
+#define NETWORK_ENSEMBLE_HPP_
+
+#include "network_core/InferenceModel.hpp"
+#include "network_core/Forward.hpp"
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+namespace network {
+  /**
+   * @brief Frozen models of the same input that answer together
+   *
+   * An image is decoded and turned into input values once, every member calculates from the same values.
+   * When all members start with a fully connected layer, the first layers are stacked into one matrix and
+   * calculated by a single product (the ensemble keeps a copy of them), the rest of every member runs on
+   * the pool. The scores of the members are combined per category: a member without a category adds nothing to it.
+   *
+   * All methods are const, one ensemble may be shared by several threads; the pool serializes their calls.
+   */
+  class Ensemble {
+    public:
+      enum class Combination : std::uint8_t {
+        Mean, // Weighted mean of the scores
+        Vote  // Every member gives its weight to its best category, the scores are the shares of the votes
+      };
+
+      /**
+       * @param t_members Frozen models with the same number of inputs.
+       * @param t_combination How the scores of the members are combined.
+       * @param t_weights Weight of every member, empty weighs all members the same.
+       * @param t_pool Threads that calculate the members together, nullptr calculates one after another.
+       * @throws std::out_of_range If there are no members, their inputs differ or the weights don't match the members.
+       * @throws Network::NetworkError If a weight is negative or all of them are zero.
+       */
+      explicit Ensemble(std::vector<InferenceModelPtr> t_members, Combination t_combination = Combination::Mean,
+                        std::vector<double> t_weights = { }, utility::ThreadPoolPtr t_pool = nullptr);
+
+      Ensemble(const Ensemble&) = delete;
+      Ensemble& operator=(const Ensemble&) = delete;
+
+      inline std::size_t inputs() const noexcept { return m_members.front()->inputs(); }
+      inline std::size_t outputs() const noexcept { return m_labels.size(); }
+      inline Combination combination() const noexcept { return m_combination; }
+      inline const std::vector<InferenceModelPtr>& members() const noexcept { return m_members; }
+      inline const std::vector<double>& weights() const noexcept { return m_weights; }
+
+      /**
+       * @brief Categories of all members, in the order they first appear
+       */
+      inline const std::vector<std::string>& labels() const noexcept { return m_labels; }
+
+      /**
+       * @brief Whether the first layers of the members are calculated as one matrix
+       */
+      inline bool stacked() const noexcept { return !m_stacked.empty(); }
+
+      /**
+       * @brief Combined distribution of input values
+       * @param t_input inputs() values.
+       * @param t_output outputs() combined scores.
+       */
+      void forward(const double* t_input, double* t_output) const;
+
+      /**
+       * @brief Categories of a decoded image sorted by the combined score
+       * @param t_top Number of the best categories to return, 0 returns all of them
+       * @throws std::out_of_range If the image is larger than the input.
+       */
+      std::vector<Prediction> perception(const cv::Mat& t_image, std::size_t t_top) const;
+
+      /**
+       * @brief Categories of an image file sorted by the combined score, empty if the file can't be read
+       */
+      std::vector<Prediction> perception(const std::string& t_data, std::size_t t_top) const;
+
+    private:
+      std::vector<InferenceModelPtr>        m_members     { };
+      Combination                           m_combination { Combination::Mean };
+      std::vector<double>                   m_weights     { }; // Normalized to a sum of one
+      utility::ThreadPoolPtr                m_pool        { };
+      std::vector<std::string>              m_labels      { };
+      std::vector<std::vector<std::size_t>> m_columns     { }; // Index in m_labels of every output of every member
+      std::vector<std::size_t>              m_offsets     { }; // First score of every member, and the total
+      std::vector<double>                   m_stacked     { }; // First layers of all members one under another, empty if not stacked
+      std::vector<std::size_t>              m_rows        { }; // First row of every member in m_stacked, and the total
+  };
+} // namespace network
+#endif // NETWORK_ENSEMBLE_HPP_
@@ -0,0 +1,89 @@
+#pragma once
+
+#ifndef NETWORK_EVALUATION_HPP_
+#define NETWORK_EVALUATION_HPP_
+
+#include "network_core/Forward.hpp"
+
+// STL
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace network {
+  /**
+   * @brief Scores of a model on a labeled dataset
+   *
+   * Rows of the confusion matrix are the true categories, columns the predicted ones. The last column
+   * counts predictions of categories the dataset doesn't have, so every row sums to the support of its category.
+   */
+  struct Evaluation {
+    std::vector<std::string>              categorys { };
+    std::vector<std::vector<std::size_t>> confusion { }; // categorys x (categorys + 1)
+    std::size_t                           samples   { 0 }; // Images scored
+    std::size_t                           correct   { 0 };
+    std::size_t                           skipped   { 0 }; // Files that couldn't be decoded
+    double                                seconds   { 0.0 }; // Wall time including decoding
+
+    double accuracy() const noexcept;
+    double samplesPerSecond() const noexcept;
+
+    /**
+     * @brief Images of a category in the dataset
+     */
+    std::size_t support(std::size_t t_category) const noexcept;
+
+    /**
+     * @brief Share of the predictions of a category that are right, 0 if it is never predicted
+     */
+    double precision(std::size_t t_category) const noexcept;
+
+    /**
+     * @brief Share of the images of a category that are recognized, 0 if it has none
+     */
+    double recall(std::size_t t_category) const noexcept;
+
+    double f1(std::size_t t_category) const noexcept;
+
+    /**
+     * @brief Mean F1 of the categories with images, every category counts the same
+     */
+    double macroF1() const noexcept;
+  };
+
+  /**
+   * @brief Table of the categories, the confusion matrix and the throughput
+   */
+  std::ostream& operator<<(std::ostream& t_stream, const Evaluation& t_evaluation);
+
+  /**
+   * @brief Evaluation as a JSON document
+   */
+  void write(std::ostream& t_stream, const Evaluation& t_evaluation);
+
+  /**
+   * @brief Score a model on decoded images
+   *
+   * The samples are split into batches of t_batch images, every batch goes through InferenceModel::forwardBatch(),
+   * so a fully connected layer is one matrix product per batch, and the pool scores the batches in parallel.
+   * The result doesn't depend on the number of threads or the size of the batches.
+   * @param t_pool Threads that score the batches together, nullptr scores one batch after another.
+   * @throws std::out_of_range If an image is larger than the input of the model.
+   */
+  Evaluation evaluate(const InferenceModel& t_model, const Dataset& t_dataset, const utility::ThreadPoolPtr& t_pool = nullptr,
+                      std::size_t t_batch = 64);
+
+  /**
+   * @brief Score a model on a dataset folder, every batch decodes its images before it scores them
+   *
+   * Only the predictions are kept, the pixels of a batch are released before the next one, so the folder
+   * may be larger than the memory. Files that can't be decoded are counted in Evaluation::skipped.
+   * @param t_categorys Categories to score, other folders are skipped.
+   * @throws Network::FolderNotFoundError If the folder doesn't exist.
+   * @throws std::out_of_range If an image is larger than the input of the model.
+   */
+  Evaluation evaluate(const InferenceModel& t_model, const std::string& t_path, const std::vector<std::string>& t_categorys,
+                      const utility::ThreadPoolPtr& t_pool = nullptr, std::size_t t_batch = 64);
+} // namespace network
+#endif // NETWORK_EVALUATION_HPP_
@@ -35,6 +35,13 @@ namespace network {
     using IOError::IOError;
   };
 
+  /**
+   * @brief Error thrown if the database of the education history can't be opened or written
+   */
+  class DatabaseError : public IOError {
+    using IOError::IOError;
+  };
+
   /**
    * @brief Error thrown if not initialize variable
    */
@@ -15,6 +15,36 @@ namespace network
   using NetworkConstPtr = std::shared_ptr<const Network>;
   using NetworkConstUPtr = std::unique_ptr<const Network>;
 
+  // Frozen network
+  class InferenceModel;
+  using InferenceModelPtr = std::shared_ptr<const InferenceModel>;
+
+  // Decoded images
+  class Dataset;
+  using DatasetPtr = std::shared_ptr<const Dataset>;
+
+  // Pooled decoding
+  class ImagePool;
+  using ImagePoolPtr = std::shared_ptr<ImagePool>;
+
+  // Perception results
+  class ResultCache;
+  using ResultCachePtr = std::shared_ptr<ResultCache>;
+
+  // Scheduling
+  namespace utility {
+    class ThreadPool;
+    using ThreadPoolPtr = std::shared_ptr<ThreadPool>;
+  }
+
+  // Education history
+  class LogSink;
+  using LogSinkPtr = std::shared_ptr<LogSink>;
+
+  // Steering of education
+  class EducationControl;
+  using EducationControlPtr = std::shared_ptr<EducationControl>;
+
   // Neuron
   namespace primitives {
     class Neuron;
@@ -22,6 +52,9 @@ namespace network
     using NeuronUPtr = std::unique_ptr<Neuron>;
     using NeuronConstPtr = std::shared_ptr<const Neuron>;
     using NeuronConstUPtr = std::unique_ptr<const Neuron>;
+
+    class Feature;
+    using FeaturePtr = std::shared_ptr<Feature>;
   }
 
   using Id = int64_t;
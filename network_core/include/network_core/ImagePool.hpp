@@ -0,0 +1,70 @@
+#pragma once
+
+#ifndef NETWORK_IMAGE_POOL_HPP_
+#define NETWORK_IMAGE_POOL_HPP_
+
+#include "network_core/utility/BufferPool.hpp"
+
+// STL
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+namespace network {
+  /**
+   * @brief Decoding of images into reused buffers sized from the dimensions of the network
+   *
+   * The file is read into a buffer of the calling thread and decoded into a block of the pool, so a loop
+   * over images of the configured dimensions reaches a state without heap allocations. Images of other
+   * dimensions are decoded as usual, into memory allocated by OpenCV.
+   */
+  class ImagePool {
+    public:
+      /**
+       * @brief Decoded image, its pixels return to the pool with it
+       */
+      struct Image {
+        utility::BufferPool::Buffer buffer { };
+        cv::Mat                     mat    { }; // Empty if the image couldn't be read or decoded
+      };
+
+      /**
+       * @param t_width Width of the images in pixels, dimensions.width of the config.
+       * @param t_height Height of the images in pixels, dimensions.height of the config.
+       */
+      ImagePool(std::size_t t_width, std::size_t t_height);
+
+      /**
+       * @brief Read and decode an image file as three channel BGR
+       */
+      Image read(const std::string& t_path);
+
+      /**
+       * @brief Decode encoded bytes of an image as three channel BGR
+       */
+      Image decode(const std::vector<unsigned char>& t_bytes);
+
+      /**
+       * @brief Read a whole file into t_bytes, the capacity of t_bytes is kept
+       * @return False if the file can't be read.
+       */
+      static bool load(const std::string& t_path, std::vector<unsigned char>& t_bytes);
+
+      inline std::size_t width() const noexcept { return m_width; }
+      inline std::size_t height() const noexcept { return m_height; }
+
+      /**
+       * @brief Pixel blocks allocated so far
+       */
+      inline std::size_t blocks() const noexcept { return m_pixels.blocks(); }
+
+    private:
+      std::size_t           m_width  { 0 };
+      std::size_t           m_height { 0 };
+      utility::BufferPool   m_pixels;
+  };
+} // namespace network
+#endif // NETWORK_IMAGE_POOL_HPP_
@@ -0,0 +1,83 @@
+#pragma once
+
+#ifndef NETWORK_INCREMENTAL_SESSION_HPP_
+#define NETWORK_INCREMENTAL_SESSION_HPP_
+
+#include "network_core/InferenceModel.hpp"
+
+// STL
+#include <cstddef>
+#include <vector>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+namespace network {
+  /**
+   * @brief Inference over a stream of inputs that change little from one to the next, e.g. video frames
+   *
+   * The session keeps the input and the weighted sums of the first layer of the previous call. When only a
+   * few inputs changed, the sums are updated with the changes times the weight columns of those inputs
+   * instead of being recalculated, the layers behind the first one are calculated as usual. Past
+   * the threshold, and every refresh incremental calls against the rounding errors, everything is recalculated.
+   *
+   * The first layer has to be fully connected, a model that starts with a feature layer is always
+   * recalculated. A session holds a transposed copy of the first layer and serves one stream: it isn't
+   * thread-safe, the model it reads may be shared.
+   */
+  class IncrementalSession {
+    public:
+      /**
+       * @param t_model Frozen model.
+       * @param t_threshold Share of changed inputs above which the sums are recalculated.
+       * @param t_refresh Incremental calls after which the sums are recalculated anyway.
+       */
+      explicit IncrementalSession(const InferenceModelPtr& t_model, double t_threshold = 0.1, std::size_t t_refresh = 1024);
+
+      /**
+       * @brief Direct distribution of input values, as InferenceModel::forward()
+       */
+      void forward(const double* t_input, double* t_output);
+
+      /**
+       * @brief Categories of a decoded image sorted by score, as InferenceModel::perception()
+       * @throws std::out_of_range If the image is larger than the input.
+       */
+      std::vector<Prediction> perception(const cv::Mat& t_image, std::size_t t_top);
+
+      /**
+       * @brief Forget the previous input, the next call recalculates everything
+       */
+      void reset() noexcept;
+
+      /**
+       * @brief Inputs that differed from the previous call, counted up to the first one past the threshold, all inputs after a reset
+       */
+      inline std::size_t changed() const noexcept { return m_changed; }
+
+      /**
+       * @brief Whether the previous call updated the sums instead of recalculating them
+       */
+      inline bool incremental() const noexcept { return m_incremental; }
+
+      inline const InferenceModelPtr& model() const noexcept { return m_model; }
+
+    private:
+      InferenceModelPtr        m_model       { };
+      double                   m_threshold   { 0.1 };
+      std::size_t              m_refresh     { 1024 };
+      std::size_t              m_outputs     { 0 };  // Outputs of the first layer, 0 if it isn't fully connected
+      std::vector<double>      m_columns     { };    // Weights of the first layer, inputs x outputs
+      std::vector<double>      m_input       { };    // Input of the previous call
+      std::vector<double>      m_sums        { };    // Weighted sums of the first layer for m_input
+      std::vector<double>      m_values      { };
+      std::vector<std::size_t> m_changes     { };
+      std::vector<double>      m_frame       { };
+      std::vector<double>      m_output      { };
+      std::size_t              m_calls       { 0 };  // Incremental calls since the last recalculation
+      std::size_t              m_changed     { 0 };
+      bool                     m_valid       { false };
+      bool                     m_incremental { false };
+  };
+} // namespace network
+#endif // NETWORK_INCREMENTAL_SESSION_HPP_
@@ -0,0 +1,153 @@
+#pragma once
+
+#ifndef NETWORK_INFERENCE_MODEL_HPP_
+#define NETWORK_INFERENCE_MODEL_HPP_
+
+#include "network_core/Network.hpp"
+#include "network_core/utility/Memory.hpp"
+#include "network_core/Forward.hpp"
+
+// STL
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <variant>
+#include <vector>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+namespace network {
+  /**
+   * @brief Immutable inference-only copy of an educated Network, created by Network::freeze()
+   *
+   * Weights are packed into contiguous row-major matrices, activations are plain enums and the categories
+   * are kept once in a label table, nothing that only education needs is copied. All methods are const,
+   * so one model may be shared by any number of threads.
+   */
+  class InferenceModel {
+    public:
+      enum class Activation : std::uint8_t { Identity, Sigmoid, SingleJump };
+
+      struct Convolution {
+        primitives::Shape   input      { };
+        primitives::Shape   output     { };
+        std::size_t         kernel     { 1 };
+        std::size_t         stride     { 1 };
+        std::vector<double> weights    { }; // filters x (channels * kernel * kernel)
+        std::vector<double> bias       { }; // filters
+        Activation          activation { Activation::Identity };
+      };
+
+      struct Pooling {
+        primitives::Shape         input  { };
+        primitives::Shape         output { };
+        std::size_t               window { 1 };
+        primitives::Pooling::Mode mode   { primitives::Pooling::Mode::Max };
+      };
+
+      struct Dense {
+        std::size_t         inputs     { 0 };
+        std::size_t         outputs    { 0 };
+        std::vector<double> weights    { }; // outputs x inputs
+        Activation          activation { Activation::Identity };
+      };
+
+      using Stage = std::variant<Convolution, Pooling, Dense>;
+
+      /**
+       * @param t_inputs Number of input values.
+       * @param t_stages Layers from the first feature layer to the output layer.
+       * @param t_function Function of the output layer.
+       * @param t_labels Category of every output.
+       * @param t_approximation Evaluation of the sigmoids and of the softmax.
+       * @throws std::out_of_range If the sizes of the stages don't follow each other.
+       */
+      InferenceModel(std::size_t t_inputs, std::vector<Stage> t_stages, OutputFunction t_function, std::vector<std::string> t_labels,
+                     computation::Approximation t_approximation = computation::Approximation::Exact);
+
+      InferenceModel(const InferenceModel&) = delete;
+      InferenceModel& operator=(const InferenceModel&) = delete;
+      ~InferenceModel() = default;
+
+      /**
+       * @brief Activation of a neuron or convolution, every approximation of the sigmoid is Activation::Sigmoid
+       * @throws Network::NetworkError If the function is not one of network::computation.
+       */
+      static Activation activation(const std::function<double(double)>& t_function);
+
+      /**
+       * @brief Apply an activation with the approximation of the model
+       */
+      void activate(Activation t_activation, double* t_values, std::size_t t_size) const noexcept;
+
+      inline std::size_t inputs() const noexcept { return m_inputs; }
+      inline std::size_t outputs() const noexcept { return m_labels.size(); }
+      inline OutputFunction function() const noexcept { return m_function; }
+      inline computation::Approximation approximation() const noexcept { return m_approximation; }
+      inline const std::vector<std::string>& labels() const noexcept { return m_labels; }
+      inline const std::vector<Stage>& stages() const noexcept { return m_stages; }
+
+      /**
+       * @brief Direct distribution of input values
+       * @param t_input inputs() values.
+       * @param t_output outputs() scores, probabilities with OutputFunction::Softmax.
+       */
+      void forward(const double* t_input, double* t_output) const;
+
+      /**
+       * @brief Distribution from a stage on
+       * @param t_stage Index of the first stage to calculate, stages().size() only applies the output function.
+       * @param t_values Outputs of the stage before it, the inputs if t_stage is 0.
+       * @param t_output outputs() scores, probabilities with OutputFunction::Softmax.
+       */
+      void forward(std::size_t t_stage, const double* t_values, double* t_output) const;
+
+      /**
+       * @brief Direct distribution of a batch of input values, every fully connected stage is one gemm for the whole batch
+       * @param t_batch Number of samples.
+       * @param t_inputs inputs() values of every sample, one after another.
+       * @param t_outputs outputs() scores of every sample, one after another.
+       */
+      void forwardBatch(std::size_t t_batch, const double* t_inputs, double* t_outputs) const;
+
+      /**
+       * @brief Input values of a decoded image, the same as Network::fill()
+       * @throws std::out_of_range If the image is larger than the input.
+       */
+      void fill(const cv::Mat& t_image, std::vector<double>& t_input) const;
+
+      /**
+       * @brief Categories sorted by score
+       * @param t_output outputs() scores.
+       * @param t_top Number of the best categories to return, 0 returns all of them
+       */
+      std::vector<Prediction> rank(const double* t_output, std::size_t t_top) const;
+
+      /**
+       * @brief Categories of a decoded image sorted by score, as Network::perception()
+       * @param t_top Number of the best categories to return, 0 returns all of them
+       * @throws std::out_of_range If the image is larger than the input.
+       */
+      std::vector<Prediction> perception(const cv::Mat& t_image, std::size_t t_top) const;
+
+      /**
+       * @brief Categories of an image file sorted by score, empty if the file can't be read
+       */
+      std::vector<Prediction> perception(const std::string& t_data, std::size_t t_top) const;
+
+      /**
+       * @brief Bytes held by every layer, comparable with Network::memory()
+       */
+      std::vector<LayerMemory> memory() const;
+
+    private:
+      std::size_t                m_inputs        { 0 };
+      std::vector<Stage>         m_stages        { };
+      OutputFunction             m_function      { OutputFunction::Sigmoid };
+      std::vector<std::string>   m_labels        { };
+      std::size_t                m_width         { 0 }; // Largest number of values between two stages
+      computation::Approximation m_approximation { computation::Approximation::Exact };
+  };
+} // namespace network
+#endif // NETWORK_INFERENCE_MODEL_HPP_
@@ -0,0 +1,41 @@
+#pragma once
+
+#ifndef NETWORK_LOG_SINK_HPP_
+#define NETWORK_LOG_SINK_HPP_
+
+// STL
+#include <cstddef>
+#include <cstdint>
+
+namespace network {
+  /**
+   * @brief Summary of a single education epoch
+   */
+  struct EpochRecord {
+    std::size_t   epoch         { 0 };
+    std::size_t   samples       { 0 };
+    double        loss          { 0.0 }; // Mean loss of the output layer over the epoch
+    double        accuracy      { 0.0 }; // Share of samples whose best output matched the category
+    double        seconds       { 0.0 };
+    double        learning_rate { 0.0 };
+    std::int64_t  timestamp     { 0 };   // Milliseconds since the Unix epoch at the end of the epoch
+  };
+
+  /**
+   * @brief Receiver of the education history
+   *
+   * push() is called from the education loop, implementations must return immediately. A sink that is
+   * shared by several networks receives push() from several threads at once.
+   */
+  class LogSink {
+    public:
+      virtual ~LogSink() = default;
+
+      /**
+       * @brief Hand over a record.
+       * @return False if the record was dropped.
+       */
+      virtual bool push(const EpochRecord& t_record) noexcept = 0;
+  };
+} // namespace network
+#endif // NETWORK_LOG_SINK_HPP_
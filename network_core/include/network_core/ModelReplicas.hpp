@@ -0,0 +1,43 @@
+#pragma once
+
+#ifndef NETWORK_MODEL_REPLICAS_HPP_
+#define NETWORK_MODEL_REPLICAS_HPP_
+
+#include "network_core/Forward.hpp"
+
+// STL
+#include <cstddef>
+#include <vector>
+
+namespace network {
+  /**
+   * @brief One copy of a frozen model per NUMA node of the host
+   *
+   * Inference reads every weight for every sample, on a multi-socket host threads of the other sockets
+   * fetch them over the interconnect. Each replica is copied by a thread bound to a CPU of its node, so
+   * its pages are allocated there, and local() hands a thread the replica of the node it runs on.
+   * A host with one node keeps the model itself, nothing is copied.
+   */
+  class ModelReplicas {
+    public:
+      /**
+       * @param t_model Model to replicate, used as the replica of the nodes a copy can't be bound to.
+       */
+      explicit ModelReplicas(const InferenceModelPtr& t_model);
+
+      /**
+       * @brief Replica of the node of the calling thread
+       */
+      const InferenceModel& local() const noexcept;
+
+      /**
+       * @brief Replica of a node, an index in utility::numaNodes()
+       */
+      inline const InferenceModelPtr& replica(std::size_t t_node) const noexcept { return m_replicas[t_node]; }
+      inline std::size_t size() const noexcept { return m_replicas.size(); }
+
+    private:
+      std::vector<InferenceModelPtr> m_replicas { };
+  };
+} // namespace network
+#endif // NETWORK_MODEL_REPLICAS_HPP_
@@ -5,7 +5,18 @@
 
 #include "network_core/primitives/Layer.hpp"
 #include "network_core/primitives/Neuron.hpp"
+#include "network_core/primitives/Feature.hpp"
+#include "network_core/primitives/Convolution.hpp"
+#include "network_core/primitives/Pooling.hpp"
+#include "network_core/utility/Statistics.hpp"
+#include "network_core/utility/PerfCounters.hpp"
+#include "network_core/utility/Memory.hpp"
+#include "network_core/utility/ThreadPool.hpp"
 #include "network_core/Exeption.hpp"
+#include "network_core/LogSink.hpp"
+#include "network_core/EducationControl.hpp"
+#include "network_core/Augmentation.hpp"
+#include "network_core/ImagePool.hpp"
 #include "network_core/Forward.hpp"
 
 // STL
@@ -18,6 +29,9 @@
 #include <type_traits>
 #include <variant>
 #include <algorithm>
+#include <limits>
+#include <random>
+#include <functional>
 
 // Boost
 #include <boost/filesystem.hpp>
@@ -76,6 +90,45 @@ namespace network {
       friend class Network;
   };
 
+  class FeatureLayer final {
+    public:
+      using value = FeatureLayer;
+      using PrimitiveT = primitives::Feature;
+      using PrimitiveTPtr = std::shared_ptr<PrimitiveT>;
+      using LayerImpl = std::vector<PrimitiveTPtr>;
+
+      FeatureLayer() = default;
+      ~FeatureLayer() = default;
+
+      /**
+       * @brief Append a spatial layer (convolution, pooling) after the previous one.
+       * @param t_feature Layer whose input shape matches the output shape of the previous layer.
+       */
+      void create(const PrimitiveTPtr& t_feature);
+
+      inline bool empty() const noexcept { return m_layers.empty(); }
+      inline const LayerImpl& layers() const noexcept { return m_layers; }
+
+    private:
+      friend class Network;
+
+    private:
+      LayerImpl m_layers { };
+  };
+
+  inline void FeatureLayer::create(const PrimitiveTPtr& t_feature)
+  {
+    if(!t_feature) {
+      throw NotInitializeError("Not initialize feature layer.");
+    }
+
+    if(!m_layers.empty() && m_layers.back()->output().size() != t_feature->input().size()) {
+      throw NotInitializeError("Feature layer input doesn't match the previous feature layer output.");
+    }
+
+    m_layers.push_back(t_feature);
+  }
+
   class HiddenLayer final : public PrimitiveLayer<primitives::Layer<primitives::Neuron>> {
     public:
       using value = HiddenLayer;
@@ -103,6 +156,84 @@ namespace network {
       std::is_same<InputLayer,  typename std::remove_cv<T>::type>::value ||
       std::is_same<OutputLayer, typename std::remove_cv<T>::type>::value > {};
 
+  /**
+   * @brief Function applied to the output layer
+   */
+  enum class OutputFunction {
+    Sigmoid, // Independent sigmoid outputs trained on the squared error
+    Softmax  // Softmax outputs trained on the cross-entropy, outputs sum to one
+  };
+
+  /**
+   * @brief Category predicted by the network with its score
+   */
+  struct Prediction {
+    std::string category    { };
+    double      probability { 0.0 };
+  };
+
+  /**
+   * @brief Categories sorted by score
+   * @param t_labels Category of every output.
+   * @param t_scores Score of every output.
+   * @param t_top Number of the best categories to return, 0 returns all of them
+   */
+  std::vector<Prediction> rank(const std::vector<std::string>& t_labels, const double* t_scores, std::size_t t_top);
+
+  /**
+   * @brief Magnitude pruning of the fully connected layers during education
+   */
+  struct Pruning {
+    double      sparsity { 0.0 };  // Share of the weights removed by the last step, 0 disables pruning
+    std::size_t steps    { 1 };    // Epochs that prune, the sparsity grows to the target in equal steps and later epochs fine-tune
+    bool        global   { true }; // One threshold for all layers, otherwise every layer loses the same share
+  };
+
+  /**
+   * @brief Labeled image for Network::learn(), it is decoded from the path if the image is empty
+   */
+  struct Sample {
+    cv::Mat     image    { };
+    std::string path     { };
+    std::string category { };
+  };
+
+  /**
+   * @brief Samples that education() and Network::learn() keep to rehearse them with new samples
+   */
+  struct Replay {
+    std::size_t capacity { 0 }; // Samples kept as a uniform random subset of all samples seen, 0 disables the rehearsal
+    std::size_t replayed { 1 }; // Kept samples educated after every new sample
+  };
+
+  /**
+   * @brief Sampled update of the output neurons with a small error, for outputs with many categories
+   *
+   * After the errors of the output layer are calculated, an output other than the target whose error is below
+   * the threshold in magnitude takes part in the backward pass and in the update only with the probability
+   * rate, its error is then divided by the rate, so the expected step doesn't change. The outputs that aren't
+   * drawn get no error, the backward pass and the update skip them.
+   */
+  struct OutputSampling {
+    double threshold { 0.0 }; // Outputs with a smaller |error| are sampled, 0 disables the sampling
+    double rate      { 1.0 }; // Probability that such an output is updated, 0 drops all of them
+
+    inline bool enabled() const noexcept { return threshold > 0.0 && rate < 1.0; }
+  };
+
+  /**
+   * @brief Layers that every fully connected layer is connected to
+   *
+   * A layer connected to several layers sees their neurons concatenated in the order of its list, which makes
+   * branches, skip connections and merges of branches. Hidden layers are numbered in topological order,
+   * every layer is connected only to Graph::SOURCE and to hidden layers before it.
+   */
+  struct Graph {
+    static constexpr std::size_t SOURCE { std::numeric_limits<std::size_t>::max() }; // The input layer, or the output of the feature layers
+
+    std::vector<std::vector<std::size_t>> inputs { }; // One list per hidden layer and the last one for the output layer, empty for a chain
+  };
+
   class Network {
     public:
       Network() noexcept = default;
@@ -117,6 +248,26 @@ namespace network {
        */
       Network(const InputLayer& t_input, const HiddenLayer& t_hidden, const OutputLayer& t_output);
 
+      /**
+       * @brief Construct from already initialized layers with spatial layers between input and hidden layers
+       * @param new input layer
+       * @param new convolution and pooling layers
+       * @param new hidden layers
+       * @param new output layer
+       */
+      Network(const InputLayer& t_input, const FeatureLayer& t_feature, const HiddenLayer& t_hidden, const OutputLayer& t_output);
+
+      /**
+       * @brief Construct from already initialized layers connected as a directed acyclic graph
+       * @param new input layer
+       * @param new convolution and pooling layers
+       * @param new hidden layers in topological order
+       * @param new output layer
+       * @param new connections of the hidden and output layers
+       * @throws Network::NotInitializeError If a layer has no inputs or the graph isn't in topological order.
+       */
+      Network(const InputLayer& t_input, const FeatureLayer& t_feature, const HiddenLayer& t_hidden, const OutputLayer& t_output, const Graph& t_graph);
+
       Network(Network&& rhs) noexcept = default;
       Network& operator=(Network&& rhs) noexcept = default;
       Network(const Network& rhs) = delete;
@@ -129,6 +280,15 @@ namespace network {
        */
       void setDataset(const std::string& t_dataset) noexcept;
 
+      /**
+       * @brief Set images decoded in advance, education() takes them instead of reading the dataset folder
+       * @param new images, nullptr reads the folder again
+       *
+       * The images are only read, networks educated in several threads may share them. The categories of
+       * the dataset become the labels of the output neurons in their order.
+       */
+      void setDataset(const DatasetPtr& t_dataset) noexcept;
+
       /**
        * @brief Set categorys
        * @param new categorys
@@ -137,17 +297,172 @@ namespace network {
 
       std::vector<std::string> getCategorys() noexcept;
 
+      /**
+       * @brief Set category of every output neuron, education() sets them from the dataset
+       * @param new labels in the order of the output neurons
+       */
+      void setLabels(const std::vector<std::string>& t_labels);
+
+      const std::vector<std::string>& getLabels() const noexcept;
+
+      /**
+       * @brief Set function of the output layer
+       * @param new output function
+       */
+      void setOutputFunction(const OutputFunction& t_function) noexcept;
+
+      OutputFunction getOutputFunction() const noexcept;
+
+      /**
+       * @brief Set evaluation of the sigmoids of the fully connected layers and of the softmax
+       * @param new approximation, the exact libm functions by default
+       *
+       * Layers whose weights don't change and the batched perception apply the sigmoid to the whole layer at once.
+       * freeze() hands the approximation over to the model.
+       */
+      void setApproximation(const computation::Approximation& t_approximation) noexcept;
+
+      computation::Approximation getApproximation() const noexcept;
+
       /**
        * @brief Set epoch for education
        * @param new epoch
        */
       void setEpoch(const std::size_t& t_epoch) noexcept;
 
+      /**
+       * @brief Set coefficient of the weight updates of all layers
+       * @param new rate, Constants::LEARNING_RATE_DEFAULT by default
+       */
+      void setLearningRate(const double& t_rate) noexcept;
+
+      double getLearningRate() const noexcept;
+
+      /**
+       * @brief Set receiver of the loss, accuracy and timing of every epoch
+       * @param new sink, nullptr disables the history
+       */
+      void setLogSink(const LogSinkPtr& t_sink) noexcept;
+
+      /**
+       * @brief Set control asked between the samples of education() whether to go on
+       * @param new control, nullptr educates every epoch
+       */
+      void setEducationControl(const EducationControlPtr& t_control) noexcept;
+
+      /**
+       * @brief Set cache of the perception results
+       * @param new cache, nullptr disables it
+       *
+       * perception(path, top) looks up the bytes of the file before decoding it, the batched perception
+       * looks up the pixels of every image and computes only the images it misses.
+       */
+      void setCache(const ResultCachePtr& t_cache) noexcept;
+
+      const ResultCachePtr& getCache() const noexcept;
+
+      /**
+       * @brief Set buffers the images are decoded into
+       * @param new pool, nullptr lets OpenCV allocate every image
+       *
+       * Education from the folder, learn() and perception() of a path read the files through the pool,
+       * images of the dimensions of the pool then don't allocate once the buffers are in use.
+       */
+      void setImagePool(const ImagePoolPtr& t_images) noexcept;
+
+      const ImagePoolPtr& getImagePool() const noexcept;
+
+      /**
+       * @brief Set threads that calculate independent hidden layers together
+       * @param new pool, nullptr calculates one layer after another
+       *
+       * Hidden layers whose inputs are ready at the same time form a level. Forward, backward and the
+       * batched perception run the layers of a level on the pool, the update runs all layers on it.
+       * A chain has one layer per level and gains nothing.
+       */
+      void setThreadPool(const utility::ThreadPoolPtr& t_pool) noexcept;
+
+      const utility::ThreadPoolPtr& getThreadPool() const noexcept;
+
+      /**
+       * @brief Set pruning performed at the end of the first epochs of education()
+       * @param new pruning, a zero sparsity disables it
+       */
+      void setPruning(const Pruning& t_pruning) noexcept;
+
+      const Pruning& getPruning() const noexcept;
+
+      /**
+       * @brief Remove the weights of the fully connected layers with the smallest magnitude
+       * @param t_sparsity Share of all weights that is removed afterwards, weights removed before count towards it
+       * @param t_global One threshold for all layers, otherwise every layer reaches the sparsity on its own
+       * @return Number of removed synapses
+       *
+       * Removed synapses don't take part in education any more. Layers whose density falls below
+       * Constants::DENSITY_SPARSE calculate in compressed sparse row form.
+       */
+      std::size_t prune(const double& t_sparsity, bool t_global = true);
+
       /**
        * @brief Start education Network
        */
       bool education();
 
+      /**
+       * @brief Set rehearsal of earlier samples during learn()
+       * @param new replay, the first epoch of education() fills the buffer as well
+       */
+      void setReplay(const Replay& t_replay);
+
+      const Replay& getReplay() const noexcept;
+
+      /**
+       * @brief Set random transformation of the images educated by education() and learn()
+       * @param new augmentation, a default one educates the images as they are
+       *
+       * The sample of an epoch is keyed by the epoch and its position, a learn() call by the number of the call.
+       */
+      void setAugmentation(const Augmentation& t_augmentation) noexcept;
+
+      const Augmentation& getAugmentation() const noexcept;
+
+      /**
+       * @brief Set sampling of the output neurons with a small error in education() and learn()
+       * @param new sampling, a default one updates every output neuron
+       */
+      void setOutputSampling(const OutputSampling& t_sampling) noexcept;
+
+      const OutputSampling& getOutputSampling() const noexcept;
+
+      /**
+       * @brief Educate an already educated network on one labeled image
+       * @param t_image Decoded image with at most as many pixels as the input layer has neurons
+       * @param t_category One of the labels of the network
+       * @return Loss on the image before the update
+       * @throws std::out_of_range If the category is unknown or the image is larger than the input layer.
+       *
+       * A call costs one education step plus Replay::replayed steps on remembered samples.
+       */
+      double learn(const cv::Mat& t_image, const std::string& t_category);
+
+      /**
+       * @brief Educate an already educated network on one image labeled by the index of its output neuron
+       * @throws std::out_of_range If the label isn't an output neuron or the image is larger than the input layer.
+       */
+      double learn(const cv::Mat& t_image, std::size_t t_label);
+
+      /**
+       * @brief Educate on one labeled image file
+       * @throws Network::FileNotFoundError If the image can't be read.
+       */
+      double learn(const std::string& t_data, const std::string& t_category);
+
+      /**
+       * @brief Educate on a small batch, one sample after another
+       * @return Mean loss of the samples before their updates
+       */
+      double learn(const std::vector<Sample>& t_samples);
+
       /**
        * @brief Validation of the training of a neural network
        * @param path to data on The path to the card on which the check will be performed
@@ -155,6 +470,75 @@ namespace network {
        */
       std::vector<std::string> perception(const std::string& t_data);
 
+      /**
+       * @brief Validation of the training of a neural network
+       * @param t_data Path to the image
+       * @param t_top Number of the best categories to return, 0 returns all of them
+       * @return Categories sorted by score. With OutputFunction::Softmax the scores are probabilities,
+       * with OutputFunction::Sigmoid they are the raw outputs of the neurons.
+       */
+      std::vector<Prediction> perception(const std::string& t_data, const std::size_t& t_top);
+
+      /**
+       * @brief Validation of a batch of decoded images in one pass
+       * @param t_batch Images with at most as many pixels as the input layer has neurons
+       * @param t_top Number of the best categories to return for every image, 0 returns all of them
+       * @return Predictions of every image in the order of the batch, as perception(t_data, t_top)
+       * @throws std::out_of_range If an image is larger than the input layer.
+       *
+       * The fully connected layers run as one matrix product over the batch, their weights are packed
+       * once and repacked only after they change.
+       */
+      std::vector<std::vector<Prediction>> perception(const std::vector<cv::Mat>& t_batch, const std::size_t& t_top);
+
+      /**
+       * @brief Trainable parameters of all layers, from the first feature layer to the output layer
+       */
+      std::vector<double> parameters();
+
+      /**
+       * @brief Replace the trainable parameters
+       * @param t_parameters Values in the order of parameters()
+       * @throws std::out_of_range If the number of values doesn't match the topology.
+       */
+      void setParameters(const std::vector<double>& t_parameters);
+
+      /**
+       * @brief Immutable inference-only copy of the educated network
+       * @return Packed weights, activations and labels without anything education needs
+       * @throws Network::NetworkError If a layer or activation function can't be frozen, or the layers aren't a chain.
+       *
+       * The model doesn't follow later changes of the network, freeze() again after education.
+       */
+      InferenceModelPtr freeze();
+
+      /**
+       * @brief Bytes held by every layer of the network
+       * @return Layers from input to output, network::total() sums them
+       */
+      std::vector<LayerMemory> memory() const;
+
+      /**
+       * @brief Timings of the phases of education() and perception()
+       * @return Snapshot of the counters, they stay zero unless the library is built with NETWORK_STATISTICS
+       */
+      Statistics statistics() const;
+
+      void resetStatistics() noexcept;
+
+      /**
+       * @brief Print a summary of statistics during education
+       * @param t_samples Number of educated samples between summaries, 0 disables the summary
+       */
+      void setStatisticsInterval(const std::size_t& t_samples) noexcept;
+
+      /**
+       * @brief Attach hardware counters to the phases and layers of education
+       * @param t_profiler Profiler created in the thread that runs education(), nullptr detaches it.
+       * Regions are named "education/<phase>" and "<phase>/<layer>" for forward, backward and update.
+       */
+      void setProfiler(const profiling::ProfilerPtr& t_profiler);
+
       /**
        * @brief Get formats file
        */
@@ -162,7 +546,6 @@ namespace network {
         return m_format;
       }
 
-    private:
       /**
        * @brief Network work with format image
        */
@@ -172,13 +555,202 @@ namespace network {
       }
 
     private:
-      InputLayer  m_input_layer_  { };
-      HiddenLayer m_hidden_layer_ { };
-      OutputLayer m_output_layer_ { };
+      /**
+       * @brief Educate on one decoded image of an epoch and add it to the record
+       * @param t_key Key of the sample for the augmentation
+       * @param t_first The first epoch offers the image to the replay buffer
+       */
+      void educate(const cv::Mat& t_image, const std::size_t& t_label, std::uint64_t t_key, bool t_first, EpochRecord& t_record,
+                   profiling::Profiler* t_profiler);
+
+      /**
+       * @brief Collector of statistics, nullptr unless the library is built with NETWORK_STATISTICS
+       */
+      statistics::Collector* collector();
+
+      /**
+       * @brief Print the summary of statistics when the interval is reached
+       */
+      void report();
+
+      /**
+       * @brief Profiler region of a phase or, with a layer, of the layer within the phase
+       * @param t_layer Index of the layer counted from the first feature layer to the output layer
+       */
+      std::size_t region(Phase t_phase, std::size_t t_layer = std::numeric_limits<std::size_t>::max()) const noexcept;
+
+      /**
+       * @brief Loss of the output layer for the last direct distribution
+       * @param t_label Index of the expected output neuron
+       */
+      double loss(const std::size_t& t_label);
+
+      /**
+       * @brief Fill, forward, backward and update on one image
+       * @param t_key Key of the sample for the augmentation
+       * @return Loss of the image before the update
+       */
+      double step(const cv::Mat& t_image, const std::size_t& t_label, std::uint64_t t_key, profiling::Profiler* t_profiler = nullptr);
+
+      /**
+       * @brief Index of the output neuron educated on the category
+       * @throws std::out_of_range If no output neuron has the category.
+       */
+      std::size_t label(const std::string& t_category);
+
+      /**
+       * @brief Keep the errors of the output neurons with a small error with the probability of the sampling
+       * @param t_label Output neuron of the target, it is always kept.
+       */
+      void sample(std::size_t t_label);
+
+      /**
+       * @brief Offer a sample to the replay buffer
+       */
+      void remember(const cv::Mat& t_image, const std::size_t& t_label);
+
+      /**
+       * @brief Index of the output neuron with the highest value
+       */
+      std::size_t predict();
+
+      /**
+       * @brief Decode an image file through the pool if it is set
+       */
+      ImagePool::Image read(const std::string& t_path);
+
+      /**
+       * @brief Supply image values to the input layer
+       */
+      void fill(const cv::Mat& t_image);
+
+      /**
+       * @brief Supply the values of the augmented image to the input layer
+       * @param t_key Key of the sample, the same key gives the same transformation
+       */
+      void augment(const cv::Mat& t_image, std::uint64_t t_key);
+
+      /**
+       * @brief Fully connected layer of the graph
+       * @param t_index Index of a hidden layer, the number of hidden layers for the output layer or Graph::SOURCE
+       */
+      primitives::Layer<primitives::Neuron>* node(std::size_t t_index);
+
+      /**
+       * @brief Run the task for every index on the thread pool, or one after another without it
+       *
+       * The task is handed over by reference, a std::function holding a lambda with several captures would allocate every step.
+       */
+      template<typename Task>
+      void schedule(const std::vector<std::size_t>& t_layers, const Task& t_task)
+      {
+        dispatch(t_layers, std::cref(t_task));
+      }
+
+      void dispatch(const std::vector<std::size_t>& t_layers, const std::function<void(std::size_t)>& t_task);
+
+      /**
+       * @brief Fully connected layers with the layers they are connected to, from the front hidden layer to the output layer
+       *
+       * A layer connected to several layers appears once for every one of them, in the order of Graph::inputs.
+       */
+      std::vector<std::pair<primitives::Layer<primitives::Neuron>*, primitives::Layer<primitives::Neuron>*>> connections();
+
+      /**
+       * @brief Category of every output neuron, the labels set by setLabels() or else the first category of the neuron
+       */
+      std::vector<std::string> outputLabels() const;
+
+      /**
+       * @brief Batched perception without the cache
+       */
+      std::vector<std::vector<Prediction>> compute(const std::vector<cv::Mat>& t_batch, const std::size_t& t_top);
+
+      /**
+       * @brief Copy the weights of the fully connected layers into contiguous matrices if they changed
+       */
+      void pack();
+
+      /**
+       * @brief Direct distribution Network
+       */
+      void forward(profiling::Profiler* t_profiler = nullptr);
+
+      /**
+       * @brief Back distribution Network
+       * @param t_label Index of the output neuron of the last supplied image category
+       */
+      void backward(const std::size_t& t_label, profiling::Profiler* t_profiler = nullptr);
+
+      /**
+       * @brief Update weight of all layers
+       */
+      void updateWeight(profiling::Profiler* t_profiler = nullptr);
+
+    private:
+      InputLayer   m_input_layer_   { };
+      FeatureLayer m_feature_layer_ { };
+      HiddenLayer  m_hidden_layer_  { };
+      OutputLayer  m_output_layer_  { };
+
+      // Neurons holding the output of the last feature layer, the front hidden layer is connected to them.
+      std::shared_ptr<primitives::Layer<primitives::Neuron>> m_feature_output_ { };
+      std::vector<primitives::Feature::TypeValues>         m_feature_values_ { };
+      std::vector<primitives::Feature::TypeValues>         m_feature_errors_ { };
+
+      std::vector<std::vector<std::size_t>>                           m_graph     { }; // Graph::inputs of every hidden layer and the output layer
+      std::vector<std::vector<std::size_t>>                           m_levels    { }; // Hidden layers whose inputs are ready after the previous levels
+      std::vector<std::vector<primitives::Layer<primitives::Neuron>*>> m_consumers { }; // Layers connected to every hidden layer and, last, to the source
+      std::vector<std::size_t>                                        m_nodes     { }; // Indices of all hidden layers and the output layer
+      utility::ThreadPoolPtr                                          m_thread_pool { };
 
       std::string                 m_dataset   {""};
+      std::string                 m_path      { }; // Path of the image being educated, its capacity is reused
+      ImagePoolPtr                m_images    { };
+      DatasetPtr                  m_decoded   { }; // Images decoded in advance, they replace the folder
       std::vector<std::string>    m_categorys {""};
+      std::vector<std::string>    m_labels    { }; // Category of every output neuron
       std::optional<std::size_t>  m_epoch     { };
+      double                      m_learning_rate { Constants::LEARNING_RATE_DEFAULT };
+      OutputFunction              m_output_function { OutputFunction::Sigmoid };
+      computation::Approximation  m_approximation   { computation::Approximation::Exact };
+      Pruning                     m_pruning   { };
+      OutputSampling              m_output_sampling { };
+
+      Replay                                         m_replay        { };
+      std::vector<std::pair<cv::Mat, std::size_t>>   m_replay_buffer { }; // Images with the index of their output neuron
+      std::size_t                                    m_replay_seen   { 0 };
+      std::mt19937_64                                m_random        { std::random_device{}() };
+      std::uint64_t                                  m_learned       { 0 }; // learn() steps, the keys of their augmentation
+
+      Augmentation                                   m_augmentation  { };
+      std::vector<double>                            m_augmented     { }; // Input values of the augmented image
+
+      LogSinkPtr                             m_log_sink            { };
+      EducationControlPtr                    m_control             { };
+      ResultCachePtr                         m_cache               { };
+      std::shared_ptr<statistics::Collector> m_statistics          { };
+      std::size_t                            m_statistics_interval { 0 };
+      std::size_t                            m_statistics_samples  { 0 };
+
+      profiling::ProfilerPtr                                    m_profiler        { };
+      std::array<std::size_t, Statistics::PHASES>               m_profile_phases  { };
+      std::array<std::vector<std::size_t>, Statistics::PHASES>  m_profile_layers  { };
+
+      // Weights of the fully connected layers as (outputs x inputs) matrices for the batched perception.
+      struct Packed {
+        std::vector<std::vector<double>>              weights     { }; // One matrix per connection
+        std::vector<std::size_t>                      inputs      { };
+        std::vector<std::size_t>                      offsets     { }; // First connection of every layer
+        std::vector<std::function<double(double)>>    activations { }; // One function per layer
+        std::size_t                                   revision    { std::numeric_limits<std::size_t>::max() };
+      };
+
+      std::size_t         m_revision      { 0 }; // Changes with every change of the weights
+      Packed              m_packed        { };
+      std::vector<double> m_batch_values  { };
+      std::vector<double> m_batch_outputs { };
+      std::vector<std::vector<double>> m_batch_layers { }; // Outputs of every hidden layer and the output layer
 
       const std::array<std::string, 3> &m_format = formats();
   };
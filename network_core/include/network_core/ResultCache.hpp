@@ -0,0 +1,111 @@
+#pragma once
+
+#ifndef NETWORK_RESULT_CACHE_HPP_
+#define NETWORK_RESULT_CACHE_HPP_
+
+#include "network_core/Network.hpp"
+#include "network_core/Forward.hpp"
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+namespace network {
+  /**
+   * @brief Counters of a ResultCache
+   */
+  struct CacheStatistics {
+    std::uint64_t hits          { 0 };
+    std::uint64_t misses        { 0 };
+    std::uint64_t invalidations { 0 }; // Entries dropped because the weights changed after they were stored
+    std::uint64_t evictions     { 0 }; // Least recently used entries dropped to stay within the capacity
+    std::size_t   size          { 0 };
+    std::size_t   capacity      { 0 };
+
+    double hitRate() const noexcept;
+
+    CacheStatistics& operator+=(const CacheStatistics& t_statistics) noexcept;
+  };
+
+  std::ostream& operator<<(std::ostream& t_stream, const CacheStatistics& t_statistics);
+
+  /**
+   * @brief Bounded LRU cache of perception results keyed by the content of the input
+   *
+   * Entries remember the revision of the weights they were computed with, a lookup with another
+   * revision drops the entry, so results never outlive an education or setParameters().
+   * The cache is split into shards with a lock each, it may be shared by several networks of the same
+   * model as long as they are at the same revision.
+   */
+  class ResultCache {
+    public:
+      using Key = std::uint64_t;
+
+      /**
+       * @param t_capacity Maximum number of entries.
+       * @param t_shards Number of independently locked parts, at most t_capacity.
+       */
+      explicit ResultCache(std::size_t t_capacity, std::size_t t_shards = 16);
+      ResultCache(const ResultCache&) = delete;
+      ResultCache& operator=(const ResultCache&) = delete;
+      ~ResultCache() = default;
+
+      /**
+       * @brief 64-bit hash of raw bytes, e.g. the content of an image file
+       */
+      static Key hash(const void* t_data, std::size_t t_size, Key t_seed = 0) noexcept;
+
+      /**
+       * @brief 64-bit hash of the pixels, size and type of a decoded image
+       */
+      static Key hash(const cv::Mat& t_image) noexcept;
+
+      /**
+       * @brief Stored result of the input and top, std::nullopt on a miss
+       */
+      std::optional<std::vector<Prediction>> find(Key t_key, std::size_t t_top, std::size_t t_revision);
+
+      void insert(Key t_key, std::size_t t_top, std::size_t t_revision, std::vector<Prediction> t_predictions);
+
+      void clear();
+
+      CacheStatistics statistics() const;
+
+      void resetStatistics();
+
+    private:
+      struct Entry {
+        Key                     key         { 0 };
+        std::size_t             revision    { 0 };
+        std::vector<Prediction> predictions { };
+      };
+
+      struct Shard {
+        mutable std::mutex                                     mutex    { };
+        std::list<Entry>                                       entries  { }; // Most recently used first
+        std::unordered_map<Key, std::list<Entry>::iterator>    index    { };
+        CacheStatistics                                        counters { };
+      };
+
+      /**
+       * @brief Key of the input combined with the number of returned categories
+       */
+      static Key combine(Key t_key, std::size_t t_top) noexcept;
+
+      Shard& shard(Key t_key) noexcept;
+
+      std::vector<std::unique_ptr<Shard>> m_shards   { };
+      std::size_t                         m_capacity { 0 }; // Entries per shard
+  };
+} // namespace network
+#endif // NETWORK_RESULT_CACHE_HPP_
@@ -0,0 +1,87 @@
+#pragma once
+
+#ifndef NETWORK_TRAINING_JOB_HPP_
+#define NETWORK_TRAINING_JOB_HPP_
+
+#include "network_core/EducationControl.hpp"
+#include "network_core/Forward.hpp"
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace network {
+  /**
+   * @brief Education of a network on a thread of its own, observed and steered from another thread
+   *
+   * The job runs Network::education() and queues its progress every few samples and at the end of every
+   * epoch. poll() takes the queued progress and result() tells whether the job is over without blocking,
+   * so one loop may drive any number of jobs. pause() and cancel() take effect at the next sample, the
+   * weights are consistent there; a cancelled network keeps what it learned so far.
+   *
+   * The network belongs to the job until result() is ready, it must not be used meanwhile.
+   */
+  class TrainingJob {
+    public:
+      enum class State : std::uint8_t { Running, Paused, Finished, Cancelled, Failed };
+
+      /**
+       * @brief Progress kept by the queue, the oldest is dropped when poll() isn't called often enough
+       */
+      static constexpr std::size_t CAPACITY { 1024 };
+
+      /**
+       * @brief Start the education
+       * @param t_network Network with the dataset, the categories and the epochs set.
+       * @param t_interval Samples between two progress updates within an epoch, 0 reports only the ends of the epochs.
+       */
+      explicit TrainingJob(const NetworkPtr& t_network, std::size_t t_interval = 64);
+
+      TrainingJob(const TrainingJob&) = delete;
+      TrainingJob& operator=(const TrainingJob&) = delete;
+
+      /**
+       * @brief Cancel the education and wait for its thread
+       */
+      ~TrainingJob();
+
+      /**
+       * @brief Hold the education at the next sample until resume() or cancel()
+       */
+      void pause() noexcept;
+      void resume() noexcept;
+      void cancel() noexcept;
+
+      /**
+       * @brief Paused once the education waits, Finished, Cancelled or Failed once result() is ready
+       */
+      State state() const noexcept;
+
+      /**
+       * @brief Progress queued since the last call, the oldest first
+       */
+      std::vector<EducationProgress> poll();
+
+      /**
+       * @brief True once every epoch is educated, false if the job was cancelled
+       * @throws The exception of Network::education() when the future is read.
+       */
+      inline const std::shared_future<bool>& result() const noexcept { return m_result; }
+      inline const NetworkPtr& network() const noexcept { return m_network; }
+
+    private:
+      class Control;
+
+      NetworkPtr               m_network { };
+      std::shared_ptr<Control> m_control { };
+      std::shared_future<bool> m_result  { };
+      std::thread              m_thread  { };
+  };
+
+  using TrainingJobPtr = std::unique_ptr<TrainingJob>;
+} // namespace network
+#endif // NETWORK_TRAINING_JOB_HPP_
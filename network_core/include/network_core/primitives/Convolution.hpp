@@ -0,0 +1,67 @@
+#pragma once
+
+#ifndef NETWORK_CONVOLUTION_HPP_
+#define NETWORK_CONVOLUTION_HPP_
+
+#include "network_core/primitives/Feature.hpp"
+#include "network_core/utility/ActivationFunctions.hpp"
+
+// STL
+#include <functional>
+
+namespace network {
+  namespace primitives {
+    /**
+     * @brief Convolution layer without padding, computed as im2col + gemm.
+     */
+    class Convolution final : public Feature {
+      public:
+        /**
+         * @param t_input Shape of the input feature map.
+         * @param t_filters Number of output channels.
+         * @param t_kernel Side of the square kernel.
+         * @param t_stride Step of the kernel.
+         * @param t_func Activation function.
+         */
+        Convolution(const Shape& t_input, std::size_t t_filters, std::size_t t_kernel, std::size_t t_stride = 1,
+                    std::function<double(double)> t_func = computation::sigmoid);
+
+        Convolution() = delete;
+        ~Convolution() override = default;
+
+        Shape input()  const noexcept override;
+        Shape output() const noexcept override;
+
+        void calculate(const TypeValues& t_input, TypeValues& t_output) noexcept override;
+        void update(const TypeValues& t_input, const TypeValues& t_output,
+                    const TypeValues& t_error, TypeValues& t_error_input) noexcept override;
+        void updateWeight(const double& t_rate) noexcept override;
+
+        std::size_t size() const noexcept override;
+        void parameters(TypeValueFeature* t_parameters) const noexcept override;
+        void setParameters(const TypeValueFeature* t_parameters) noexcept override;
+        MemoryUsage memory() const noexcept override;
+
+        inline std::size_t kernel() const noexcept { return m_kernel; }
+        inline std::size_t stride() const noexcept { return m_stride; }
+        inline const std::function<double(double)>& activation() const noexcept { return m_active_func; }
+
+      private:
+        Shape       m_input   { };
+        Shape       m_output  { };
+        std::size_t m_kernel  { 1 };
+        std::size_t m_stride  { 1 };
+
+        TypeValues m_weights         { }; // filters x (channels * kernel * kernel)
+        TypeValues m_bias            { }; // filters
+        TypeValues m_gradient        { };
+        TypeValues m_gradient_bias   { };
+        TypeValues m_columns         { }; // im2col of the last input
+        TypeValues m_delta           { };
+        TypeValues m_error_columns   { };
+
+        std::function<double(double)> m_active_func { };
+    };
+  } // namespace primitives
+} // namespace network
+#endif // NETWORK_CONVOLUTION_HPP_
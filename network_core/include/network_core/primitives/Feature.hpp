@@ -0,0 +1,94 @@
+#pragma once
+
+#ifndef NETWORK_FEATURE_HPP_
+#define NETWORK_FEATURE_HPP_
+
+#include "network_core/Forward.hpp"
+#include "network_core/utility/Memory.hpp"
+
+// STL
+#include <vector>
+#include <cstddef>
+
+namespace network {
+  namespace primitives {
+    /**
+     * @brief Dimensions of a feature map in (channels x height x width) layout.
+     */
+    struct Shape {
+      std::size_t channels { 1 };
+      std::size_t height   { 0 };
+      std::size_t width    { 0 };
+
+      inline std::size_t size() const noexcept { return channels * height * width; }
+    };
+
+    /**
+     * @brief Spatial layer that works on whole feature maps instead of single neurons (convolution, pooling).
+     *
+     * Errors follow the same convention as Neuron: the error is the difference between
+     * the desired and the actual output, weights move along it.
+     */
+    class Feature {
+      public:
+        using TypeValueFeature = double;
+        using TypeValues       = std::vector<TypeValueFeature>;
+
+        virtual ~Feature() = default;
+
+        /**
+         * @brief Shape of the feature map accepted by the layer.
+         */
+        virtual Shape input() const noexcept = 0;
+
+        /**
+         * @brief Shape of the feature map produced by the layer.
+         */
+        virtual Shape output() const noexcept = 0;
+
+        /**
+         * @brief Direct distribution.
+         * @param t_input Values of input() shape.
+         * @param t_output Values of output() shape.
+         */
+        virtual void calculate(const TypeValues& t_input, TypeValues& t_output) noexcept = 0;
+
+        /**
+         * @brief Back distribution.
+         * @param t_input Values passed to the last calculate().
+         * @param t_output Values produced by the last calculate().
+         * @param t_error Error of the output values.
+         * @param t_error_input Error of the input values.
+         */
+        virtual void update(const TypeValues& t_input, const TypeValues& t_output,
+                            const TypeValues& t_error, TypeValues& t_error_input) noexcept = 0;
+
+        /**
+         * @brief Applies the gradient accumulated by the last update().
+         * @param t_rate Coefficient of the gradient.
+         */
+        virtual void updateWeight(const double& t_rate) noexcept = 0;
+
+        /**
+         * @brief Number of trainable parameters.
+         */
+        virtual std::size_t size() const noexcept = 0;
+
+        /**
+         * @brief Copies the size() trainable parameters to the output.
+         */
+        virtual void parameters(TypeValueFeature* t_parameters) const noexcept = 0;
+
+        /**
+         * @brief Replaces the size() trainable parameters.
+         */
+        virtual void setParameters(const TypeValueFeature* t_parameters) noexcept = 0;
+
+        /**
+         * @brief Bytes held by the parameters and buffers of the layer.
+         */
+        virtual MemoryUsage memory() const noexcept = 0;
+    };
+  } // namespace primitives
+} // namespace network
+#endif // NETWORK_FEATURE_HPP_
@@ -5,11 +5,19 @@
 
 #include "network_core/Constants.hpp"
 #include "network_core/Forward.hpp"
+#include "network_core/utility/ActivationFunctions.hpp"
+#include "network_core/utility/Memory.hpp"
+#include "network_core/utility/Kernels.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <functional>
+#include <unordered_map>
 
 namespace {
   std::atomic<network::Id> unique_id_neuron_ { 0 };
@@ -28,26 +36,177 @@ namespace network {
           explicit Layer() = default;
           explicit Layer(const std::size_t& size) noexcept;
 
+          /**
+           * @brief Creates synapses of every neuron with every neuron of the layer.
+           * @param t_layer Previous layer, a layer connected to several layers sees their neurons
+           * concatenated in the order of the calls.
+           */
           void connect(Layer& t_layer)                  noexcept;
           void connect(std::shared_ptr<Layer>& t_layer) noexcept;
 
           void set(const std::size_t& t_pose, const double& t_value);
 
           void calculate() noexcept;
+          void softmax(computation::Approximation t_approximation = computation::Approximation::Exact) noexcept;
           void update(const std::string& t_category)    noexcept;
+          void update(const std::size_t& t_target)      noexcept;
           void update(Layer& t_layer)               noexcept;
 
-          void updateWeight() noexcept;
+          /**
+           * @brief Error of the neurons summed over all layers connected to this one.
+           * @param t_layers Following layers, their errors are already calculated.
+           */
+          void update(const std::vector<Layer*>& t_layers) noexcept;
+
+          /**
+           * @brief Moves the weights of all neurons along their errors.
+           * @param t_rate Coefficient of the step.
+           * @note Once calculate() packed the weights, the step is a rank-one update of the packed matrix
+           * and the synapses are brought up to date only when they are read.
+           */
+          void updateWeight(const double& t_rate = Constants::LEARNING_RATE_DEFAULT) noexcept;
+
+          /**
+           * @brief Sets the activation function of all neurons.
+           */
+          void setActivationFunction(const std::function<double(double)>& t_func) noexcept;
+
+          /**
+           * @brief Copies the weights of the synapses with the previous layer.
+           * @param t_layer Previous layer.
+           * @param t_weights Output matrix (size() x t_layer.size()) in row-major order, missing synapses are zero.
+           */
+          void weights(Layer& t_layer, typename _Tp::TypeValueNeuron* t_weights) noexcept;
+
+          /**
+           * @brief Replaces the weights of the synapses with the previous layer.
+           * @param t_layer Previous layer.
+           * @param t_weights Matrix (size() x t_layer.size()) in row-major order.
+           */
+          void setWeights(Layer& t_layer, const typename _Tp::TypeValueNeuron* t_weights) noexcept;
+
+          /**
+           * @brief Copies the weights of the synapses with the previous layer in compressed sparse row form.
+           * @param t_layer Previous layer.
+           * @param t_offsets size() + 1 offsets of the rows in t_columns and t_values.
+           * @param t_columns Index of the neuron of the previous layer for every weight.
+           */
+          void weights(Layer& t_layer, std::vector<std::size_t>& t_offsets, std::vector<std::uint32_t>& t_columns,
+                       std::vector<typename _Tp::TypeValueNeuron>& t_values);
+
+          /**
+           * @brief Removes the synapses whose weight is smaller in magnitude than the threshold.
+           * @return Number of removed synapses.
+           */
+          std::size_t prune(const typename _Tp::TypeValueNeuron& t_threshold) noexcept;
+
+          /**
+           * @brief Appends the magnitudes of the weights of all synapses.
+           */
+          void magnitudes(std::vector<typename _Tp::TypeValueNeuron>& t_magnitudes) const;
+
+          /**
+           * @brief Number of synapses of all neurons.
+           */
+          std::size_t synapses() const noexcept;
+
+          /**
+           * @brief Share of the possible synapses with the previous layers that exist, 1 before connect().
+           */
+          double density() const noexcept;
+
+          /**
+           * @brief calculate() runs on the weights in compressed sparse row form.
+           */
+          inline bool sparse() const noexcept { return packed() && m_packed.sparse; }
+
+          /**
+           * @brief The weights live in the packed matrix, calculate() and updateWeight() run on it.
+           */
+          inline bool packed() const noexcept { return m_packed.state != Packed::State::Changed; }
 
           inline std::size_t size() const noexcept { return m_neurons.size(); }
 
+          /**
+           * @brief Number of neurons of all previous layers.
+           */
+          inline std::size_t inputs() const noexcept { return m_inputs.size(); }
+
+          /**
+           * @brief Bytes held by the layer and its neurons.
+           */
+          MemoryUsage memory() const noexcept;
+
+          /**
+           * @brief Bytes held by a fully connected layer before it is created.
+           * @param t_size Number of neurons.
+           * @param t_inputs Number of neurons in the previous layer.
+           */
+          static MemoryUsage estimate(const std::size_t& t_size, const std::size_t& t_inputs) noexcept;
+
           const_iterator begin();
           const_iterator end();
 
           void setCategory(const std::size_t& t_pose, const std::string& t_category);
 
         protected:
+          /**
+           * @brief Copies the synapses into the packed weights, in CSR form below Constants::DENSITY_SPARSE.
+           */
+          void pack();
+
+          /**
+           * @brief Writes the packed weights trained by updateWeight() back into the synapses.
+           */
+          void sync() noexcept;
+
+          /**
+           * @brief The synapses changed, the next calculate() packs them again.
+           */
+          inline void invalidate() noexcept { sync(); m_packed.state = Packed::State::Changed; }
+
+          /**
+           * @brief Column of the first neuron of a previous layer in the packed matrix.
+           */
+          std::optional<std::size_t> offset(const Layer& t_layer) const noexcept;
+
+          /**
+           * @brief Adds the errors of a following layer, weighted by its synapses with this layer, to t_errors.
+           */
+          void accumulate(Layer& t_layer, typename _Tp::TypeValueNeuron* t_errors) const noexcept;
+
+          /**
+           * @brief Compressed sparse row form of the synapses with the given neurons.
+           */
+          void compress(const std::vector<std::shared_ptr<_Tp>>& t_inputs, std::vector<std::size_t>& t_offsets,
+                        std::vector<std::uint32_t>& t_columns, std::vector<typename _Tp::TypeValueNeuron>& t_values) const;
+
+        protected:
+          // Weights of the synapses copied out for calculate(), education keeps training them in place.
+          struct Packed {
+            enum class State : std::uint8_t {
+              Changed, // The synapses changed after the last pack()
+              Ready,   // The packed weights and the synapses are equal
+              Trained  // updateWeight() moved the packed weights, the synapses are behind
+            };
+
+            State                                      state   { State::Changed };
+            bool                                       sparse  { false };
+            std::optional<computation::Approximation>  sigmoid { }; // All neurons share a sigmoid, it runs over the whole array
+            std::vector<typename _Tp::TypeValueNeuron> values  { }; // size() x inputs, or the stored values in CSR form
+            std::vector<std::uint32_t>                 columns { };
+            std::vector<std::size_t>                   offsets { };
+            std::vector<typename _Tp::TypeValueNeuron> inputs  { }; // Outputs of the previous layer
+            std::vector<typename _Tp::TypeValueNeuron> outputs { }; // Weighted sums
+            std::vector<typename _Tp::TypeValueNeuron> steps   { }; // Step of every neuron per unit of input
+            std::vector<std::size_t>                   holes   { }; // Missing synapses of the dense matrix, kept at zero
+          };
+
           std::vector<std::shared_ptr<_Tp>> m_neurons { };
+          std::vector<std::shared_ptr<_Tp>> m_inputs  { }; // Neurons of the previous layers, appended by connect()
+          std::vector<std::pair<const _Tp*, std::size_t>> m_sources { }; // First neuron and column of every previous layer
+          std::vector<typename _Tp::TypeValueNeuron> m_values { };
+          Packed m_packed { };
       };
 
     template<typename _Tp>
@@ -72,6 +231,12 @@ namespace network {
             neuron->createSynapse(e, random(-0.5, 0.5));
           }
         }
+
+        if(!t_layer.m_neurons.empty()) {
+          m_sources.emplace_back(t_layer.m_neurons.front().get(), m_inputs.size());
+        }
+        m_inputs.insert(m_inputs.end(), t_layer.m_neurons.begin(), t_layer.m_neurons.end());
+        invalidate();
       }
 
     template<typename _Tp>
@@ -95,8 +260,67 @@ namespace network {
     template<typename _Tp>
       void Layer<_Tp>::calculate() noexcept
       {
-        for(const auto& neuron : m_neurons) {
-          neuron->computeOutputValue();
+        // Education trains the packed weights in place, they are copied out of the synapses only after those changed.
+        if(!packed() && !m_inputs.empty()) {
+          pack();
+        }
+
+        if(!packed()) {
+          for(const auto& neuron : m_neurons) {
+            neuron->computeOutputValue();
+          }
+          return;
+        }
+
+        for(std::size_t j = 0; j < m_inputs.size(); ++j) {
+          m_packed.inputs[j] = m_inputs[j]->getOutputValue();
+        }
+
+        if(m_packed.sparse) {
+          computation::spmv(m_neurons.size(), m_packed.offsets.data(), m_packed.columns.data(), m_packed.values.data(),
+                            m_packed.inputs.data(), m_packed.outputs.data());
+        } else {
+          computation::gemv(m_neurons.size(), m_inputs.size(), m_packed.values.data(), m_packed.inputs.data(), m_packed.outputs.data());
+        }
+
+        if(m_packed.sigmoid) {
+          computation::vsigmoid(m_packed.outputs.data(), m_packed.outputs.data(), m_neurons.size(), *m_packed.sigmoid);
+          for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+            m_neurons[i]->setOutputValue(m_packed.outputs[i]);
+          }
+          return;
+        }
+
+        for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+          if(const auto& function_ = m_neurons[i]->getActivationFunction()) {
+            m_neurons[i]->setOutputValue(function_(m_packed.outputs[i]));
+          }
+        }
+      }
+
+    template<typename _Tp>
+      void Layer<_Tp>::softmax(computation::Approximation t_approximation) noexcept
+      {
+        m_values.resize(m_neurons.size());
+        for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+          m_values[i] = m_neurons[i]->getOutputValue();
+        }
+
+        computation::softmax(m_values.data(), m_values.size(), t_approximation);
+
+        for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+          m_neurons[i]->setOutputValue(m_values[i]);
+        }
+      }
+
+    template<typename _Tp>
+      void Layer<_Tp>::update(const std::size_t& t_target) noexcept
+      {
+        // The target is one-hot, so the error doesn't need the category of every neuron.
+        // With softmax outputs this is also the cross-entropy gradient of the logits.
+        for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+          const typename _Tp::TypeValueNeuron target_ = (i == t_target) ? 1.0 : 0.0;
+          m_neurons[i]->computeError(target_ - m_neurons[i]->getOutputValue());
         }
       }
 
@@ -111,25 +335,382 @@ namespace network {
     template<typename _Tp>
       void Layer<_Tp>::update(Layer& t_layer) noexcept
       {
-        for(auto& neuron_before : m_neurons) {
-          typename _Tp::TypeValueNeuron acc { 0.0 };
+        m_values.assign(m_neurons.size(), 0.0);
+        accumulate(t_layer, m_values.data());
+
+        for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+          m_neurons[i]->computeError(m_values[i]);
+        }
+      }
+
+    template<typename _Tp>
+      void Layer<_Tp>::update(const std::vector<Layer*>& t_layers) noexcept
+      {
+        m_values.assign(m_neurons.size(), 0.0);
+        for(const auto& layer : t_layers) {
+          accumulate(*layer, m_values.data());
+        }
+
+        for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+          m_neurons[i]->computeError(m_values[i]);
+        }
+      }
 
-          for(const auto& neuron_after : t_layer) {
-            if(auto weight = neuron_after->getWeight(neuron_before)) {
-              acc += (*weight) * neuron_after->getError();
+    template<typename _Tp>
+      void Layer<_Tp>::accumulate(Layer& t_layer, typename _Tp::TypeValueNeuron* t_errors) const noexcept
+      {
+        if(!t_layer.packed()) {
+          for(std::size_t j = 0; j < m_neurons.size(); ++j) {
+            for(const auto& neuron_after : t_layer) {
+              // Neurons without an error, e.g. outputs left out by the sampling, add nothing.
+              if(neuron_after->getError() == 0.0) {
+                continue;
+              }
+              if(auto weight = neuron_after->getWeight(m_neurons[j])) {
+                t_errors[j] += (*weight) * neuron_after->getError();
+              }
             }
           }
+          return;
+        }
+
+        const auto offset_ = t_layer.offset(*this);
+        if(!offset_) {
+          return;
+        }
 
-          neuron_before->computeError(acc);
+        // Layers of one level run in parallel and read the same following layer, the errors are gathered per thread.
+        thread_local std::vector<typename _Tp::TypeValueNeuron> errors_ { };
+        errors_.resize(t_layer.m_neurons.size());
+        for(std::size_t i = 0; i < t_layer.m_neurons.size(); ++i) {
+          errors_[i] = t_layer.m_neurons[i]->getError();
+        }
+
+        const auto& packed_ = t_layer.m_packed;
+        if(!packed_.sparse) {
+          computation::gemvt(t_layer.m_neurons.size(), m_neurons.size(), t_layer.m_inputs.size(),
+                             packed_.values.data() + *offset_, errors_.data(), t_errors);
+          return;
+        }
+
+        const std::size_t end_ = *offset_ + m_neurons.size();
+        for(std::size_t i = 0; i < t_layer.m_neurons.size(); ++i) {
+          if(errors_[i] == 0.0) {
+            continue;
+          }
+          for(std::size_t k = packed_.offsets[i]; k < packed_.offsets[i + 1]; ++k) {
+            if(packed_.columns[k] >= *offset_ && packed_.columns[k] < end_) {
+              t_errors[packed_.columns[k] - *offset_] += packed_.values[k] * errors_[i];
+            }
+          }
         }
       }
-    
+
     template<typename _Tp>
-      void Layer<_Tp>::updateWeight() noexcept
+      void Layer<_Tp>::updateWeight(const double& t_rate) noexcept
+      {
+        if(!packed()) {
+          for(const auto& neuron : m_neurons) {
+            neuron->computeWeights(t_rate);
+          }
+
+          invalidate();
+          return;
+        }
+
+        for(std::size_t j = 0; j < m_inputs.size(); ++j) {
+          m_packed.inputs[j] = m_inputs[j]->getOutputValue();
+        }
+        for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+          m_packed.steps[i] = m_neurons[i]->computeGradient(t_rate);
+        }
+
+        if(m_packed.sparse) {
+          for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+            if(m_packed.steps[i] == 0.0) {
+              continue;
+            }
+            for(std::size_t k = m_packed.offsets[i]; k < m_packed.offsets[i + 1]; ++k) {
+              m_packed.values[k] += m_packed.steps[i] * m_packed.inputs[m_packed.columns[k]];
+            }
+          }
+        } else {
+          computation::ger(m_neurons.size(), m_inputs.size(), m_packed.steps.data(), m_packed.inputs.data(), m_packed.values.data());
+          for(const auto hole : m_packed.holes) {
+            m_packed.values[hole] = 0.0;
+          }
+        }
+
+        m_packed.state = Packed::State::Trained;
+      }
+
+    template<typename _Tp>
+      void Layer<_Tp>::sync() noexcept
+      {
+        if(m_packed.state != Packed::State::Trained) {
+          return;
+        }
+
+        // Missing synapses have no weight to set, setWeight() skips them.
+        for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+          if(m_packed.sparse) {
+            for(std::size_t k = m_packed.offsets[i]; k < m_packed.offsets[i + 1]; ++k) {
+              m_neurons[i]->setWeight(m_inputs[m_packed.columns[k]], m_packed.values[k]);
+            }
+          } else {
+            for(std::size_t j = 0; j < m_inputs.size(); ++j) {
+              m_neurons[i]->setWeight(m_inputs[j], m_packed.values[i * m_inputs.size() + j]);
+            }
+          }
+        }
+
+        m_packed.state = Packed::State::Ready;
+      }
+
+    template<typename _Tp>
+      std::optional<std::size_t> Layer<_Tp>::offset(const Layer& t_layer) const noexcept
+      {
+        if(t_layer.m_neurons.empty()) {
+          return std::nullopt;
+        }
+
+        for(const auto& [first, column] : m_sources) {
+          if(first == t_layer.m_neurons.front().get()) {
+            return column;
+          }
+        }
+        return std::nullopt;
+      }
+
+    template<typename _Tp>
+      void Layer<_Tp>::setActivationFunction(const std::function<double(double)>& t_func) noexcept
       {
         for(const auto& neuron : m_neurons) {
-          neuron->computeWeights();
+          neuron->setActivationFunction(t_func);
+        }
+
+        invalidate();
+      }
+
+    template<typename _Tp>
+      void Layer<_Tp>::weights(Layer& t_layer, typename _Tp::TypeValueNeuron* t_weights) noexcept
+      {
+        if(packed() && !m_packed.sparse) {
+          if(const auto offset_ = offset(t_layer)) {
+            for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+              const auto* row_ = m_packed.values.data() + i * m_inputs.size() + *offset_;
+              t_weights = std::copy(row_, row_ + t_layer.m_neurons.size(), t_weights);
+            }
+            return;
+          }
         }
+
+        sync();
+        for(const auto& neuron : m_neurons) {
+          for(const auto& input : t_layer) {
+            *t_weights++ = neuron->getWeight(input).value_or(0.0);
+          }
+        }
+      }
+
+    template<typename _Tp>
+      void Layer<_Tp>::setWeights(Layer& t_layer, const typename _Tp::TypeValueNeuron* t_weights) noexcept
+      {
+        if(packed() && !m_packed.sparse) {
+          if(const auto offset_ = offset(t_layer)) {
+            for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+              std::copy(t_weights, t_weights + t_layer.m_neurons.size(), m_packed.values.data() + i * m_inputs.size() + *offset_);
+              t_weights += t_layer.m_neurons.size();
+            }
+            for(const auto hole : m_packed.holes) {
+              m_packed.values[hole] = 0.0;
+            }
+
+            m_packed.state = Packed::State::Trained;
+            return;
+          }
+        }
+
+        sync();
+        for(const auto& neuron : m_neurons) {
+          for(const auto& input : t_layer) {
+            neuron->setWeight(input, *t_weights++);
+          }
+        }
+
+        invalidate();
+      }
+
+    template<typename _Tp>
+      void Layer<_Tp>::weights(Layer& t_layer, std::vector<std::size_t>& t_offsets, std::vector<std::uint32_t>& t_columns,
+                               std::vector<typename _Tp::TypeValueNeuron>& t_values)
+      {
+        sync();
+        compress(t_layer.m_neurons, t_offsets, t_columns, t_values);
+      }
+
+    template<typename _Tp>
+      std::size_t Layer<_Tp>::prune(const typename _Tp::TypeValueNeuron& t_threshold) noexcept
+      {
+        sync();
+
+        std::size_t removed_ { 0 };
+        for(const auto& neuron : m_neurons) {
+          removed_ += neuron->prune(t_threshold);
+        }
+
+        invalidate();
+        return removed_;
+      }
+
+    template<typename _Tp>
+      void Layer<_Tp>::magnitudes(std::vector<typename _Tp::TypeValueNeuron>& t_magnitudes) const
+      {
+        t_magnitudes.reserve(t_magnitudes.size() + synapses());
+
+        // Trained weights may be ahead of the synapses, the packed ones are read without the holes.
+        if(packed()) {
+          auto hole_ = m_packed.holes.begin();
+          for(std::size_t k = 0; k < m_packed.values.size(); ++k) {
+            if(hole_ != m_packed.holes.end() && *hole_ == k) {
+              ++hole_;
+              continue;
+            }
+            t_magnitudes.push_back(std::abs(m_packed.values[k]));
+          }
+          return;
+        }
+
+        for(const auto& neuron : m_neurons) {
+          for(const auto& [input, weight] : neuron->getSynapses()) {
+            t_magnitudes.push_back(std::abs(weight));
+          }
+        }
+      }
+
+    template<typename _Tp>
+      std::size_t Layer<_Tp>::synapses() const noexcept
+      {
+        std::size_t synapses_ { 0 };
+        for(const auto& neuron : m_neurons) {
+          synapses_ += neuron->size();
+        }
+        return synapses_;
+      }
+
+    template<typename _Tp>
+      double Layer<_Tp>::density() const noexcept
+      {
+        const std::size_t possible_ = m_neurons.size() * m_inputs.size();
+        return possible_ ? static_cast<double>(synapses()) / static_cast<double>(possible_) : 1.0;
+      }
+
+    template<typename _Tp>
+      void Layer<_Tp>::pack()
+      {
+        m_packed.sparse = density() < Constants::DENSITY_SPARSE;
+
+        m_packed.sigmoid.reset();
+        if(!m_neurons.empty()) {
+          m_packed.sigmoid = computation::approximation_of(m_neurons.front()->getActivationFunction());
+          for(const auto& neuron : m_neurons) {
+            if(computation::approximation_of(neuron->getActivationFunction()) != m_packed.sigmoid) {
+              m_packed.sigmoid.reset();
+              break;
+            }
+          }
+        }
+        compress(m_inputs, m_packed.offsets, m_packed.columns, m_packed.values);
+
+        m_packed.holes.clear();
+        if(!m_packed.sparse) {
+          std::vector<typename _Tp::TypeValueNeuron> dense_(m_neurons.size() * m_inputs.size(), 0.0);
+          for(std::size_t i = 0; i < m_neurons.size(); ++i) {
+            std::size_t column_ { 0 };
+            for(std::size_t k = m_packed.offsets[i]; k < m_packed.offsets[i + 1]; ++k) {
+              for(; column_ < m_packed.columns[k]; ++column_) {
+                m_packed.holes.push_back(i * m_inputs.size() + column_);
+              }
+              dense_[i * m_inputs.size() + m_packed.columns[k]] = m_packed.values[k];
+              ++column_;
+            }
+            for(; column_ < m_inputs.size(); ++column_) {
+              m_packed.holes.push_back(i * m_inputs.size() + column_);
+            }
+          }
+
+          m_packed.values.swap(dense_);
+          m_packed.offsets = { };
+          m_packed.columns = { };
+        }
+
+        m_packed.inputs.resize(m_inputs.size());
+        m_packed.outputs.resize(m_neurons.size());
+        m_packed.steps.resize(m_neurons.size());
+        m_packed.state = Packed::State::Ready;
+      }
+
+    template<typename _Tp>
+      void Layer<_Tp>::compress(const std::vector<std::shared_ptr<_Tp>>& t_inputs, std::vector<std::size_t>& t_offsets,
+                                std::vector<std::uint32_t>& t_columns, std::vector<typename _Tp::TypeValueNeuron>& t_values) const
+      {
+        std::unordered_map<const _Tp*, std::uint32_t> columns_ { };
+        columns_.reserve(t_inputs.size());
+        for(std::size_t j = 0; j < t_inputs.size(); ++j) {
+          columns_.emplace(t_inputs[j].get(), static_cast<std::uint32_t>(j));
+        }
+
+        t_offsets.assign(1, 0);
+        t_columns.clear();
+        t_values.clear();
+        t_columns.reserve(synapses());
+        t_values.reserve(synapses());
+
+        // Synapses are ordered by address, the columns of a row are sorted to read x in order.
+        std::vector<std::pair<std::uint32_t, typename _Tp::TypeValueNeuron>> row_ { };
+        for(const auto& neuron : m_neurons) {
+          row_.clear();
+          for(const auto& [input, weight] : neuron->getSynapses()) {
+            if(const auto it_ = columns_.find(input.get()); it_ != columns_.end()) {
+              row_.emplace_back(it_->second, weight);
+            }
+          }
+          std::sort(row_.begin(), row_.end());
+
+          for(const auto& [column, weight] : row_) {
+            t_columns.push_back(column);
+            t_values.push_back(weight);
+          }
+          t_offsets.push_back(t_values.size());
+        }
+      }
+
+    template<typename _Tp>
+      MemoryUsage Layer<_Tp>::memory() const noexcept
+      {
+        MemoryUsage usage_ { };
+        for(const auto& neuron : m_neurons) {
+          usage_ += neuron->memory();
+        }
+
+        usage_.activations += m_values.capacity() * sizeof(typename decltype(m_values)::value_type);
+        usage_.overhead    += sizeof(Layer) + (m_neurons.capacity() + m_inputs.capacity()) * sizeof(typename decltype(m_neurons)::value_type)
+                            + m_sources.capacity() * sizeof(typename decltype(m_sources)::value_type);
+
+        // Packed weights are a copy of the synapses.
+        usage_.overhead    += (m_packed.values.capacity() + m_packed.inputs.capacity() + m_packed.outputs.capacity() + m_packed.steps.capacity())
+                              * sizeof(typename _Tp::TypeValueNeuron)
+                            + m_packed.columns.capacity() * sizeof(std::uint32_t)
+                            + (m_packed.offsets.capacity() + m_packed.holes.capacity()) * sizeof(std::size_t);
+        return usage_;
+      }
+
+    template<typename _Tp>
+      MemoryUsage Layer<_Tp>::estimate(const std::size_t& t_size, const std::size_t& t_inputs) noexcept
+      {
+        MemoryUsage usage_ = _Tp::estimate(t_inputs) * t_size;
+        usage_.overhead += sizeof(Layer) + t_size * sizeof(std::shared_ptr<_Tp>);
+        return usage_;
       }
 
     template<typename _Tp>
@@ -6,6 +6,7 @@
 #include "network_core/Forward.hpp"
 #include "network_core/Constants.hpp"
 #include "network_core/utility/ActivationFunctions.hpp"
+#include "network_core/utility/Memory.hpp"
 
 // STL
 #include <optional>
@@ -124,8 +125,16 @@ namespace network {
 
         /**
          * @brief Calculates weight relationships based on the error layer of the child.
+         * @param t_rate Coefficient of the step.
          */
-        void computeWeights() noexcept;
+        void computeWeights(const TypeValueNeuron& t_rate = Constants::LEARNING_RATE_DEFAULT) noexcept;
+
+        /**
+         * @brief Step of the weights per unit of the input, the same for every synapse of the neuron.
+         * @param t_rate Coefficient of the step.
+         * @return Zero without an activation function or an error.
+         */
+        TypeValueNeuron computeGradient(const TypeValueNeuron& t_rate = Constants::LEARNING_RATE_DEFAULT) const noexcept;
 
         /**
          * @brief Returns the weight value if the received neuron exists among the existing links.
@@ -134,12 +143,31 @@ namespace network {
          */
         std::optional<TypeValueNeuron> getWeight(const NeuronPtr& t_neuron) noexcept;
 
+        /**
+         * @brief Replaces the weight of an existing synapse.
+         * @param t_neuron The neuron with which the connection with the current neuron is formed.
+         * @param t_weight New weight.
+         * @return false if there is no synapse with the neuron.
+         */
+        bool setWeight(const NeuronPtr& t_neuron, const TypeValueNeuron& t_weight) noexcept;
+
+        /**
+         * @brief Removes the synapses whose weight is smaller in magnitude than the threshold.
+         * @param t_threshold Smallest magnitude of a weight that is kept.
+         * @return Number of removed synapses.
+         */
+        std::size_t prune(const TypeValueNeuron& t_threshold) noexcept;
+
+        const TypeSynapses& getSynapses() const noexcept;
+
         /**
          * @brief Set activation function for neuron.
          * @param t_func activation function.
          */
         void setActivationFunction(std::function<double(double)> t_func) noexcept;
 
+        const std::function<double(double)>& getActivationFunction() const noexcept;
+
         /**
          * @brief Get Id neuron
          * @return id neuron
@@ -147,6 +175,18 @@ namespace network {
         Id getId() const noexcept;
 
         std::size_t size() const noexcept;
+
+        /**
+         * @brief Bytes held by the neuron, including synapse nodes and categories.
+         */
+        MemoryUsage memory() const noexcept;
+
+        /**
+         * @brief Bytes held by a neuron with the given number of synapses and no categories.
+         * @param t_synapses Number of synapses.
+         */
+        static MemoryUsage estimate(const std::size_t& t_synapses) noexcept;
+
         friend inline std::ostream& operator<<(std::ostream& t_stream, Neuron& t_neuron);
         bool operator ==(const Neuron& t_neuron) noexcept;
 
@@ -0,0 +1,53 @@
+#pragma once
+
+#ifndef NETWORK_POOLING_HPP_
+#define NETWORK_POOLING_HPP_
+
+#include "network_core/primitives/Feature.hpp"
+
+namespace network {
+  namespace primitives {
+    /**
+     * @brief Non-overlapping pooling layer (window equals stride).
+     */
+    class Pooling final : public Feature {
+      public:
+        enum class Mode { Max, Average };
+
+        /**
+         * @param t_input Shape of the input feature map.
+         * @param t_size Side of the pooling window.
+         * @param t_mode Max or average pooling.
+         */
+        Pooling(const Shape& t_input, std::size_t t_size, Mode t_mode = Mode::Max);
+
+        Pooling() = delete;
+        ~Pooling() override = default;
+
+        Shape input()  const noexcept override;
+        Shape output() const noexcept override;
+
+        void calculate(const TypeValues& t_input, TypeValues& t_output) noexcept override;
+        void update(const TypeValues& t_input, const TypeValues& t_output,
+                    const TypeValues& t_error, TypeValues& t_error_input) noexcept override;
+        void updateWeight(const double& t_rate) noexcept override;
+
+        std::size_t size() const noexcept override;
+        void parameters(TypeValueFeature* t_parameters) const noexcept override;
+        void setParameters(const TypeValueFeature* t_parameters) noexcept override;
+        MemoryUsage memory() const noexcept override;
+
+        inline std::size_t window() const noexcept { return m_size; }
+        inline Mode mode() const noexcept { return m_mode; }
+
+      private:
+        Shape       m_input  { };
+        Shape       m_output { };
+        std::size_t m_size   { 1 };
+        Mode        m_mode   { Mode::Max };
+
+        std::vector<std::size_t> m_argmax { }; // Input index of the maximum for every output value
+    };
+  } // namespace primitives
+} // namespace network
+#endif // NETWORK_POOLING_HPP_
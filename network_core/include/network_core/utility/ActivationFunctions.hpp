@@ -6,12 +6,25 @@
 #include "network_core/Constants.hpp"
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <algorithm>
 #include <functional>
+#include <optional>
 
 namespace network {
 namespace computation {
-  inline double differential(std::function<double(double)> t_func, const double& t_x) noexcept
+  /**
+   * @brief Evaluation of exp, sigmoid and tanh
+   */
+  enum class Approximation : std::uint8_t {
+    Exact,      // libm exp()
+    Polynomial, // Range reduction and a polynomial of degree 7, relative error of exp below 1e-8
+    Table       // Linear interpolation in a table of the sigmoid, absolute error below 1e-6, exp and tanh use Polynomial
+  };
+
+  inline double differential(const std::function<double(double)>& t_func, const double& t_x) noexcept
   {
     return (t_func(t_x + Constants::ESP) - t_func(t_x)) / Constants::ESP;
   }
@@ -21,10 +34,128 @@ namespace computation {
     return 1 / (1 + exp(Constants::DEGREE_FUNCTION * (-t_x)));
   }
 
+  /**
+   * @brief exp() without libm, relative error below 1e-8, the argument is clamped to [-708, 709].
+   *
+   * x = n * ln2 + r with |r| <= ln2 / 2, e^r is a Taylor polynomial and 2^n is written into the exponent bits.
+   * There are no branches and no calls, so loops over arrays vectorize.
+   */
+  inline double exp_approx(const double& t_x) noexcept
+  {
+    constexpr double LOG2E   { 1.44269504088896338700e+00 };
+    constexpr double LN2_HI  { 6.93147180369123816490e-01 };
+    constexpr double LN2_LO  { 1.90821492927058770002e-10 };
+    constexpr double SHIFTER { 6755399441055744.0 }; // 1.5 * 2^52, the sum keeps the rounded integer in the low bits
+
+    const double x_ = t_x < -708.0 ? -708.0 : (t_x > 709.0 ? 709.0 : t_x);
+    const double k_ = x_ * LOG2E + SHIFTER;
+    const double n_ = k_ - SHIFTER;
+    const double r_ = (x_ - n_ * LN2_HI) - n_ * LN2_LO;
+
+    double p_ = 1.0 / 5040.0;
+    p_ = p_ * r_ + 1.0 / 720.0;
+    p_ = p_ * r_ + 1.0 / 120.0;
+    p_ = p_ * r_ + 1.0 / 24.0;
+    p_ = p_ * r_ + 1.0 / 6.0;
+    p_ = p_ * r_ + 0.5;
+    p_ = p_ * r_ + 1.0;
+    p_ = p_ * r_ + 1.0;
+
+    std::uint64_t bits_;
+    std::memcpy(&bits_, &k_, sizeof(bits_));
+    bits_ = (bits_ + 1023) << 52;
+
+    double scale_;
+    std::memcpy(&scale_, &bits_, sizeof(scale_));
+    return p_ * scale_;
+  }
+
+  /**
+   * @brief sigmoid() on exp_approx(), absolute error below 1e-8.
+   */
+  inline double sigmoid_approx(const double& t_x) noexcept
+  {
+    return 1 / (1 + exp_approx(Constants::DEGREE_FUNCTION * (-t_x)));
+  }
+
+  /**
+   * @brief sigmoid() interpolated in a table of Constants::SIGMOID_TABLE_STEPS values per unit, absolute error below 1e-6.
+   */
+  double sigmoid_table(const double& t_x) noexcept;
+
+  /**
+   * @brief tanh() on exp_approx(), absolute error below 1e-8.
+   */
+  inline double tanh_approx(const double& t_x) noexcept
+  {
+    const double e_ = exp_approx(-2.0 * std::abs(t_x));
+    return std::copysign((1 - e_) / (1 + e_), t_x);
+  }
+
+  /**
+   * @brief Element-wise exp of an array, t_x and t_y may be the same array.
+   */
+  void vexp(const double* t_x, double* t_y, std::size_t t_size, Approximation t_approximation) noexcept;
+
+  /**
+   * @brief Element-wise sigmoid of an array, t_x and t_y may be the same array.
+   */
+  void vsigmoid(const double* t_x, double* t_y, std::size_t t_size, Approximation t_approximation) noexcept;
+
+  /**
+   * @brief Element-wise tanh of an array, t_x and t_y may be the same array.
+   */
+  void vtanh(const double* t_x, double* t_y, std::size_t t_size, Approximation t_approximation) noexcept;
+
+  /**
+   * @brief Sigmoid function evaluated with the approximation, for Neuron::setActivationFunction().
+   */
+  double (*sigmoid_of(Approximation t_approximation) noexcept)(const double&) noexcept;
+
+  /**
+   * @brief Approximation of a sigmoid function, std::nullopt if the function isn't one of the sigmoids of network::computation.
+   */
+  std::optional<Approximation> approximation_of(const std::function<double(double)>& t_function) noexcept;
+
   inline double single_jump(const double& t_x) noexcept
   {
     return t_x >= Constants::TRESHOLD_SINGLE_JUMP ? 1.0 : 0.0;
   }
+
+  inline double identity(const double& t_x) noexcept
+  {
+    return t_x;
+  }
+
+  /**
+   * @brief Numerically stable softmax, the maximum is subtracted before exponentiation.
+   * @param t_values Values to normalize in place.
+   * @param t_size Number of values.
+   * @param t_approximation Evaluation of exp.
+   */
+  inline void softmax(double* t_values, std::size_t t_size, Approximation t_approximation = Approximation::Exact) noexcept
+  {
+    if(t_size == 0) {
+      return;
+    }
+
+    const double max_ = *std::max_element(t_values, t_values + t_size);
+
+    for(std::size_t i = 0; i < t_size; ++i) {
+      t_values[i] -= max_;
+    }
+    vexp(t_values, t_values, t_size, t_approximation);
+
+    double sum_ { 0.0 };
+    for(std::size_t i = 0; i < t_size; ++i) {
+      sum_ += t_values[i];
+    }
+
+    const double scale_ = 1.0 / sum_;
+    for(std::size_t i = 0; i < t_size; ++i) {
+      t_values[i] *= scale_;
+    }
+  }
 } // namespace computation
 } // namespace network
 #endif // NETWORK_ACTIVATION_FUNCTIONS_HPP_
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#ifndef NETWORK_BUFFER_POOL_HPP_
+#define NETWORK_BUFFER_POOL_HPP_
+
+// STL
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace network {
+namespace utility {
+  /**
+   * @brief Aligned blocks of one size kept on free lists for reuse
+   *
+   * Every thread takes blocks from its own list and returns them to it, a block released by another thread
+   * joins the list of that thread. A list runs empty only until the thread holds as many blocks as it needs
+   * at once, afterwards acquire() and release make no heap allocation. Blocks live as long as the pool,
+   * a Buffer must not outlive the pool it came from.
+   */
+  class BufferPool {
+    public:
+      static constexpr std::size_t ALIGNMENT { 64 };
+
+      /**
+       * @brief Block taken from a pool, it returns to the pool when the Buffer is destroyed
+       */
+      class Buffer {
+        public:
+          Buffer() = default;
+          Buffer(Buffer&& t_buffer) noexcept;
+          Buffer& operator=(Buffer&& t_buffer) noexcept;
+          Buffer(const Buffer&) = delete;
+          Buffer& operator=(const Buffer&) = delete;
+          ~Buffer();
+
+          inline unsigned char* data() const noexcept { return m_data; }
+          inline explicit operator bool() const noexcept { return m_data != nullptr; }
+
+        private:
+          friend class BufferPool;
+          Buffer(BufferPool* t_pool, unsigned char* t_data) noexcept : m_pool(t_pool), m_data(t_data) { }
+
+          BufferPool*    m_pool { nullptr };
+          unsigned char* m_data { nullptr };
+      };
+
+      /**
+       * @param t_bytes Size of every block.
+       * @param t_alignment Alignment of every block, a power of two.
+       */
+      explicit BufferPool(std::size_t t_bytes, std::size_t t_alignment = ALIGNMENT);
+      BufferPool(const BufferPool&) = delete;
+      BufferPool& operator=(const BufferPool&) = delete;
+      ~BufferPool();
+
+      /**
+       * @brief Block from the list of the calling thread, from the list of another thread if it is empty,
+       *        a new block if all of them are empty
+       */
+      Buffer acquire();
+
+      inline std::size_t bytes() const noexcept { return m_bytes; }
+
+      /**
+       * @brief Blocks allocated so far, a number that stops growing in a loop that reuses its buffers
+       */
+      inline std::size_t blocks() const noexcept { return m_blocks.load(std::memory_order_relaxed); }
+
+    private:
+      static constexpr std::size_t SHARDS { 16 };
+
+      struct alignas(ALIGNMENT) Shard {
+        std::mutex                  mutex { };
+        std::vector<unsigned char*> free  { };
+      };
+
+      void release(unsigned char* t_data) noexcept;
+      Shard& shard() noexcept;
+
+      std::size_t                 m_bytes     { 0 };
+      std::size_t                 m_alignment { ALIGNMENT };
+      std::array<Shard, SHARDS>   m_shards    { };
+      std::atomic<std::size_t>    m_blocks    { 0 };
+      std::mutex                  m_mutex     { };
+      std::vector<unsigned char*> m_all       { }; // Every block ever allocated, guarded by m_mutex
+  };
+} // namespace utility
+} // namespace network
+#endif // NETWORK_BUFFER_POOL_HPP_
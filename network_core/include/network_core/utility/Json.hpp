@@ -0,0 +1,17 @@
+#pragma once
+
+#ifndef NETWORK_JSON_HPP_
+#define NETWORK_JSON_HPP_
+
+// STL
+#include <string>
+
+namespace network {
+namespace utility {
+  /**
+   * @brief Value as a JSON string: quoted, with quotes, backslashes and control characters escaped
+   */
+  std::string quote(const std::string& t_value);
+} // namespace utility
+} // namespace network
+#endif // NETWORK_JSON_HPP_
@@ -0,0 +1,98 @@
+#pragma once
+
+#ifndef NETWORK_KERNELS_HPP_
+#define NETWORK_KERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace network {
+namespace computation {
+  /**
+   * @brief Tile sizes of the cache-blocked kernels
+   */
+  struct Tiles {
+    std::size_t gemv { 2048 }; // Values of x that stay in L1 while all rows of A pass over them
+    std::size_t m    { 64 };   // Rows of the packed panel of op(A) in gemm
+    std::size_t n    { 256 };  // Columns of the packed panel of op(B) in gemm
+    std::size_t k    { 128 };  // Depth of both panels in gemm
+  };
+
+  /**
+   * @brief Tiles in use, derived from the L1 and L2 sizes of the host on the first call.
+   */
+  Tiles tiles() noexcept;
+
+  /**
+   * @brief Replace the tiles in use, zero sizes keep the current ones.
+   */
+  void setTiles(const Tiles& t_tiles) noexcept;
+
+  /**
+   * @brief Time the kernels with tiles around the derived ones and keep the fastest.
+   * @return Tiles in use afterwards.
+   *
+   * Takes a few tens of milliseconds, meant for the start of long-running processes.
+   */
+  Tiles tune();
+
+  /**
+   * @brief Cache-blocked row-major matrix multiplication C = alpha * op(A) * op(B) + beta * C.
+   * @param t_trans_a Use A transposed, A is stored as (k x m) instead of (m x k).
+   * @param t_trans_b Use B transposed, B is stored as (n x k) instead of (k x n).
+   * @param t_m Rows of op(A) and C.
+   * @param t_n Columns of op(B) and C.
+   * @param t_k Columns of op(A) and rows of op(B).
+   */
+  void gemm(bool t_trans_a, bool t_trans_b, std::size_t t_m, std::size_t t_n, std::size_t t_k,
+            double t_alpha, const double* t_a, const double* t_b, double t_beta, double* t_c) noexcept;
+
+  /**
+   * @brief Row-major matrix-vector product y = A * x, x is split into tiles that stay in L1 for all rows.
+   * @param t_m Rows of A and size of y.
+   * @param t_n Columns of A and size of x.
+   */
+  void gemv(std::size_t t_m, std::size_t t_n, const double* t_a, const double* t_x, double* t_y) noexcept;
+
+  /**
+   * @brief Row-major transposed product y += A^T * x, a tile of y stays in L1 while all rows of A pass over it.
+   * @param t_m Rows of A and size of x, rows with a zero in x are skipped.
+   * @param t_n Columns of A used and size of y.
+   * @param t_lda Distance between two rows of A, at least t_n; A may be a block of columns of a wider matrix.
+   */
+  void gemvt(std::size_t t_m, std::size_t t_n, std::size_t t_lda, const double* t_a, const double* t_x, double* t_y) noexcept;
+
+  /**
+   * @brief Row-major rank-one update A += x * y^T, a tile of y stays in L1 while all rows of A pass over it.
+   * @param t_m Rows of A and size of x, rows with a zero in x are skipped.
+   * @param t_n Columns of A and size of y.
+   */
+  void ger(std::size_t t_m, std::size_t t_n, const double* t_x, const double* t_y, double* t_a) noexcept;
+
+  /**
+   * @brief Product y = A * x of a matrix in compressed sparse row form with a dense vector.
+   * @param t_m Rows of A and size of y.
+   * @param t_offsets t_m + 1 offsets of the rows in t_columns and t_values.
+   * @param t_columns Column of every stored value.
+   */
+  void spmv(std::size_t t_m, const std::size_t* t_offsets, const std::uint32_t* t_columns, const double* t_values,
+            const double* t_x, double* t_y) noexcept;
+
+  /**
+   * @brief Unrolls image patches into columns, so that a convolution becomes a single gemm.
+   * @param t_image Image in (channels x height x width) layout.
+   * @param t_columns Output matrix (channels * kernel * kernel) x (out_height * out_width).
+   */
+  void im2col(const double* t_image, std::size_t t_channels, std::size_t t_height, std::size_t t_width,
+              std::size_t t_kernel, std::size_t t_stride, double* t_columns) noexcept;
+
+  /**
+   * @brief Inverse of im2col, accumulates columns back into the image.
+   * @param t_columns Matrix (channels * kernel * kernel) x (out_height * out_width).
+   * @param t_image Image in (channels x height x width) layout, it must be zeroed by the caller.
+   */
+  void col2im(const double* t_columns, std::size_t t_channels, std::size_t t_height, std::size_t t_width,
+              std::size_t t_kernel, std::size_t t_stride, double* t_image) noexcept;
+} // namespace computation
+} // namespace network
+#endif // NETWORK_KERNELS_HPP_
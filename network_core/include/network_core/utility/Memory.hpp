@@ -0,0 +1,98 @@
+#pragma once
+
+#ifndef NETWORK_MEMORY_HPP_
+#define NETWORK_MEMORY_HPP_
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace network {
+  /**
+   * @brief Bytes held by a part of the network
+   */
+  struct MemoryUsage {
+    std::size_t weights     { 0 }; // Trainable parameters
+    std::size_t gradients   { 0 }; // Buffers used only by education
+    std::size_t activations { 0 }; // Outputs, errors and intermediate values of a sample
+    std::size_t overhead    { 0 }; // Containers, control blocks, categories
+
+    inline std::size_t total() const noexcept { return weights + gradients + activations + overhead; }
+
+    inline MemoryUsage& operator+=(const MemoryUsage& t_usage) noexcept
+    {
+      weights     += t_usage.weights;
+      gradients   += t_usage.gradients;
+      activations += t_usage.activations;
+      overhead    += t_usage.overhead;
+      return *this;
+    }
+  };
+
+  inline MemoryUsage operator*(MemoryUsage t_usage, std::size_t t_count) noexcept
+  {
+    t_usage.weights     *= t_count;
+    t_usage.gradients   *= t_count;
+    t_usage.activations *= t_count;
+    t_usage.overhead    *= t_count;
+    return t_usage;
+  }
+
+  /**
+   * @brief Memory of a single layer of the network
+   */
+  struct LayerMemory {
+    std::string layer   { };
+    std::size_t neurons { 0 };
+    MemoryUsage usage   { };
+  };
+
+  inline MemoryUsage total(const std::vector<LayerMemory>& t_layers) noexcept
+  {
+    MemoryUsage usage_ { };
+    for(const auto& layer : t_layers) {
+      usage_ += layer.usage;
+    }
+    return usage_;
+  }
+
+  inline std::ostream& operator<<(std::ostream& t_stream, const MemoryUsage& t_usage)
+  {
+    return t_stream << "weights " << t_usage.weights << " B, gradients " << t_usage.gradients
+                    << " B, activations " << t_usage.activations << " B, overhead " << t_usage.overhead
+                    << " B, total " << t_usage.total() << " B";
+  }
+
+  inline std::ostream& operator<<(std::ostream& t_stream, const std::vector<LayerMemory>& t_layers)
+  {
+    for(const auto& layer : t_layers) {
+      t_stream << layer.layer << " (" << layer.neurons << "): " << layer.usage << '\n';
+    }
+    return t_stream << "total: " << total(t_layers);
+  }
+
+  namespace allocation {
+    /**
+     * @brief Heap operations made by a thread
+     */
+    struct Counters {
+      std::uint64_t allocations   { 0 };
+      std::uint64_t deallocations { 0 };
+      std::uint64_t bytes         { 0 };
+    };
+
+    /**
+     * @brief Whether the library replaces operator new/delete to count allocations (NETWORK_COUNT_ALLOCATIONS).
+     */
+    bool enabled() noexcept;
+
+    /**
+     * @brief Heap operations made by the calling thread since it started, zero if counting is disabled.
+     */
+    Counters counters() noexcept;
+  } // namespace allocation
+} // namespace network
+#endif // NETWORK_MEMORY_HPP_
@@ -0,0 +1,51 @@
+#pragma once
+
+#ifndef NETWORK_NUMA_HPP_
+#define NETWORK_NUMA_HPP_
+
+// STL
+#include <cstddef>
+#include <vector>
+
+namespace network {
+namespace utility {
+  /**
+   * @brief Memory node of the host with the CPUs next to it
+   */
+  struct NumaNode {
+    std::size_t              id   { 0 };
+    std::vector<std::size_t> cpus { }; // CPUs the process may run on, ascending
+  };
+
+  /**
+   * @brief Nodes of the host read once from /sys/devices/system/node
+   *
+   * Only CPUs in the affinity mask of the process are listed, nodes without such CPUs (memory-only nodes,
+   * CPUs excluded by a container) are left out. Without sysfs all allowed CPUs form node 0.
+   */
+  const std::vector<NumaNode>& numaNodes();
+
+  /**
+   * @brief CPUs for workers spread over the nodes: worker i runs on node i % nodes, the CPUs of a node are used in turn
+   * @param t_workers Number of workers.
+   */
+  std::vector<std::size_t> placement(std::size_t t_workers);
+
+  /**
+   * @brief Bind the calling thread to a CPU, threads it creates afterwards inherit the binding
+   * @return False if the CPU doesn't exist or the system refused.
+   */
+  bool pin(std::size_t t_cpu) noexcept;
+
+  /**
+   * @brief Index in numaNodes() of the node of a CPU, 0 if the CPU isn't listed
+   */
+  std::size_t numaNodeOf(std::size_t t_cpu) noexcept;
+
+  /**
+   * @brief Index in numaNodes() of the node the calling thread runs on
+   */
+  std::size_t numaNode() noexcept;
+} // namespace utility
+} // namespace network
+#endif // NETWORK_NUMA_HPP_
@@ -0,0 +1,122 @@
+#pragma once
+
+#ifndef NETWORK_PERF_COUNTERS_HPP_
+#define NETWORK_PERF_COUNTERS_HPP_
+
+// STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace network {
+namespace profiling {
+  /**
+   * @brief Hardware events counted by PerfCounters
+   */
+  enum class Event : std::size_t { Cycles = 0, Instructions, CacheReferences, CacheMisses, Branches, BranchMisses, Size };
+
+  /**
+   * @brief Values of the hardware events, an event is absent if the host or the kernel doesn't provide it
+   */
+  struct Counters {
+    static constexpr std::size_t EVENTS { static_cast<std::size_t>(Event::Size) };
+
+    std::array<std::uint64_t, EVENTS> values    { };
+    std::array<bool, EVENTS>          available { };
+    std::uint64_t                     calls     { 0 };
+
+    inline std::uint64_t operator[](Event t_event) const noexcept { return values[static_cast<std::size_t>(t_event)]; }
+    inline bool has(Event t_event) const noexcept { return available[static_cast<std::size_t>(t_event)]; }
+
+    double ipc() const noexcept;
+    double cacheMissRate() const noexcept;
+    double branchMissRate() const noexcept;
+
+    Counters& operator+=(const Counters& t_counters) noexcept;
+  };
+
+  Counters operator-(const Counters& t_end, const Counters& t_begin) noexcept;
+  std::ostream& operator<<(std::ostream& t_stream, const Counters& t_counters);
+
+  /**
+   * @brief Hardware counters of the calling thread opened with Linux perf_event_open.
+   *
+   * Events that can't be opened (no PMU, virtual machine, perf_event_paranoid, other OS) are skipped,
+   * available() is false if none could be opened and read() then returns empty counters.
+   */
+  class PerfCounters {
+    public:
+      PerfCounters();
+      PerfCounters(const PerfCounters&) = delete;
+      PerfCounters& operator=(const PerfCounters&) = delete;
+      ~PerfCounters();
+
+      bool available() const noexcept;
+
+      /**
+       * @brief Current values, scaled when the kernel multiplexes the counters.
+       */
+      Counters read() const noexcept;
+
+    private:
+      std::array<int, Counters::EVENTS> m_descriptors { };
+  };
+
+  /**
+   * @brief Accumulates counters of named regions (phases, layers) measured in one thread.
+   */
+  class Profiler {
+    public:
+      Profiler();
+      Profiler(const Profiler&) = delete;
+      Profiler& operator=(const Profiler&) = delete;
+      ~Profiler() = default;
+
+      bool available() const noexcept;
+
+      /**
+       * @brief Index of a region, the region is created on the first call.
+       */
+      std::size_t region(const std::string& t_name);
+
+      inline Counters read() const noexcept { return m_counters.read(); }
+      void add(std::size_t t_region, const Counters& t_counters) noexcept;
+
+      /**
+       * @brief Accumulated counters of every region in the order of creation.
+       */
+      std::vector<std::pair<std::string, Counters>> regions() const;
+
+      void reset() noexcept;
+
+    private:
+      PerfCounters                                  m_counters { };
+      std::vector<std::pair<std::string, Counters>> m_regions  { };
+  };
+
+  using ProfilerPtr = std::shared_ptr<Profiler>;
+
+  std::ostream& operator<<(std::ostream& t_stream, const Profiler& t_profiler);
+
+  /**
+   * @brief Adds the counters of its lifetime to a region, does nothing without a profiler
+   */
+  class Scope {
+    public:
+      Scope(Profiler* t_profiler, std::size_t t_region) noexcept;
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+      ~Scope();
+
+    private:
+      Profiler*   m_profiler { nullptr };
+      std::size_t m_region   { 0 };
+      Counters    m_begin    { };
+  };
+} // namespace profiling
+} // namespace network
+#endif // NETWORK_PERF_COUNTERS_HPP_
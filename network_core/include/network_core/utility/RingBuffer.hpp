@@ -0,0 +1,115 @@
+#pragma once
+
+#ifndef NETWORK_RING_BUFFER_HPP_
+#define NETWORK_RING_BUFFER_HPP_
+
+// STL
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace network {
+namespace utility {
+  /**
+   * @brief Bounded lock-free queue for any number of producers and a single consumer.
+   *
+   * Neither side ever blocks: push() fails when the buffer is full and pop() fails when it is empty.
+   * Producers claim a slot by a compare-and-swap on the head, every slot carries a sequence number
+   * that tells the consumer whether its value is already written.
+   */
+  template<typename _Tp>
+    class RingBuffer {
+      static_assert(std::is_nothrow_copy_assignable_v<_Tp>, "RingBuffer requires nothrow copy assignable values");
+
+      public:
+        /**
+         * @param t_capacity Minimal number of stored values, rounded up to a power of two.
+         */
+        explicit RingBuffer(std::size_t t_capacity);
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+        ~RingBuffer() = default;
+
+        /**
+         * @brief Safe to call from several threads at once.
+         */
+        bool push(const _Tp& t_value) noexcept;
+
+        /**
+         * @brief Only one thread may pop.
+         */
+        bool pop(_Tp& t_value) noexcept;
+
+        inline std::size_t capacity() const noexcept { return m_mask + 1; }
+
+      private:
+        struct Slot {
+          std::atomic<std::size_t> sequence { 0 }; // Position that may be written next, position + 1 once written
+          _Tp                      value    { };
+        };
+
+        std::unique_ptr<Slot[]> m_slots { };
+        std::size_t             m_mask  { 0 };
+
+        alignas(64) std::atomic<std::size_t> m_head { 0 }; // Next position to claim, shared by the producers
+        alignas(64) std::atomic<std::size_t> m_tail { 0 }; // Next position to read, owned by the consumer
+    };
+
+  template<typename _Tp>
+    RingBuffer<_Tp>::RingBuffer(std::size_t t_capacity)
+    {
+      std::size_t capacity_ { 1 };
+      while(capacity_ < t_capacity) {
+        capacity_ <<= 1;
+      }
+
+      m_slots = std::make_unique<Slot[]>(capacity_);
+      for(std::size_t i = 0; i < capacity_; ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+      }
+      m_mask = capacity_ - 1;
+    }
+
+  template<typename _Tp>
+    bool RingBuffer<_Tp>::push(const _Tp& t_value) noexcept
+    {
+      std::size_t head_ = m_head.load(std::memory_order_relaxed);
+      for(;;) {
+        Slot& slot_ = m_slots[head_ & m_mask];
+        const std::size_t sequence_ = slot_.sequence.load(std::memory_order_acquire);
+
+        if(sequence_ == head_) {
+          // The slot is free for this position, claim it before another producer does.
+          if(m_head.compare_exchange_weak(head_, head_ + 1, std::memory_order_relaxed)) {
+            slot_.value = t_value;
+            slot_.sequence.store(head_ + 1, std::memory_order_release);
+            return true;
+          }
+        } else if(sequence_ < head_) {
+          // The consumer hasn't read the value of the previous round yet.
+          return false;
+        } else {
+          head_ = m_head.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+  template<typename _Tp>
+    bool RingBuffer<_Tp>::pop(_Tp& t_value) noexcept
+    {
+      const std::size_t tail_ = m_tail.load(std::memory_order_relaxed);
+      Slot& slot_ = m_slots[tail_ & m_mask];
+      if(slot_.sequence.load(std::memory_order_acquire) != tail_ + 1) {
+        return false;
+      }
+
+      t_value = slot_.value;
+      slot_.sequence.store(tail_ + m_mask + 1, std::memory_order_release);
+      m_tail.store(tail_ + 1, std::memory_order_relaxed);
+      return true;
+    }
+} // namespace utility
+} // namespace network
+#endif // NETWORK_RING_BUFFER_HPP_
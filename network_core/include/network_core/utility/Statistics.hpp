@@ -0,0 +1,142 @@
+#pragma once
+
+#ifndef NETWORK_STATISTICS_HPP_
+#define NETWORK_STATISTICS_HPP_
+
+#include "network_core/utility/Memory.hpp"
+
+// STL
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace network {
+  /**
+   * @brief Phases of processing a single sample
+   */
+  enum class Phase : std::size_t { Decode = 0, Fill, Forward, Backward, Update, Size };
+
+  /**
+   * @brief Kind of the processed sample
+   */
+  enum class Mode : std::size_t { Education = 0, Perception, Size };
+
+  /**
+   * @brief Snapshot of the timings collected in education() and perception()
+   *
+   * Filled only when the library is built with NETWORK_STATISTICS, otherwise all counters stay zero.
+   */
+  struct Statistics {
+    static constexpr std::size_t PHASES  { static_cast<std::size_t>(Phase::Size) };
+    static constexpr std::size_t MODES   { static_cast<std::size_t>(Mode::Size) };
+    static constexpr std::size_t BUCKETS { 40 }; // Bucket i counts latencies in [2^i, 2^(i+1)) nanoseconds
+
+    struct Counter {
+      std::uint64_t calls       { 0 };
+      std::uint64_t nanoseconds { 0 };
+    };
+
+    struct Allocations {
+      std::uint64_t count { 0 };
+      std::uint64_t bytes { 0 };
+    };
+
+    std::array<std::array<Counter, PHASES>, MODES>        phases      { };
+    std::array<Counter, MODES>                            samples     { };
+    std::array<std::array<std::uint64_t, BUCKETS>, MODES> latency     { };
+    std::array<Allocations, MODES>                        allocations { }; // Filled only with NETWORK_COUNT_ALLOCATIONS
+
+    const Counter& phase(Mode t_mode, Phase t_phase) const noexcept;
+
+    /**
+     * @brief Processed samples per second of busy time.
+     */
+    double samplesPerSecond(Mode t_mode) const noexcept;
+
+    /**
+     * @brief Upper bound of the per-sample latency percentile in seconds.
+     * @param t_percentile Value in [0, 1].
+     */
+    double percentile(Mode t_mode, double t_percentile) const noexcept;
+
+    /**
+     * @brief Mean number of heap allocations made while processing one sample.
+     */
+    double allocationsPerSample(Mode t_mode) const noexcept;
+  };
+
+  std::ostream& operator<<(std::ostream& t_stream, const Statistics& t_statistics);
+
+  namespace statistics {
+    /**
+     * @brief Collects timings into per-thread accumulators, so threads never contend on a counter
+     */
+    class Collector {
+      public:
+        Collector();
+        Collector(const Collector&) = delete;
+        Collector& operator=(const Collector&) = delete;
+        ~Collector() = default;
+
+        void phase(Mode t_mode, Phase t_phase, std::uint64_t t_nanoseconds) noexcept;
+        void sample(Mode t_mode, std::uint64_t t_nanoseconds, const allocation::Counters& t_allocations = { }) noexcept;
+
+        Statistics snapshot() const;
+        void reset() noexcept;
+
+      private:
+        struct Accumulator {
+          std::array<std::array<std::atomic<std::uint64_t>, Statistics::PHASES>, Statistics::MODES> calls       { };
+          std::array<std::array<std::atomic<std::uint64_t>, Statistics::PHASES>, Statistics::MODES> nanoseconds { };
+          std::array<std::atomic<std::uint64_t>, Statistics::MODES> samples        { };
+          std::array<std::atomic<std::uint64_t>, Statistics::MODES> sample_time    { };
+          std::array<std::array<std::atomic<std::uint64_t>, Statistics::BUCKETS>, Statistics::MODES> latency { };
+          std::array<std::atomic<std::uint64_t>, Statistics::MODES> allocations    { };
+          std::array<std::atomic<std::uint64_t>, Statistics::MODES> allocated      { };
+        };
+
+        Accumulator& local();
+
+      private:
+        const std::uint64_t                       m_id           { 0 };
+        mutable std::mutex                        m_mutex        { };
+        std::vector<std::unique_ptr<Accumulator>> m_accumulators { };
+    };
+
+    /**
+     * @brief Adds the lifetime of the object to a phase or, without a phase, to the sample latency
+     */
+    class ScopedTimer {
+      public:
+        ScopedTimer(Collector* t_collector, Mode t_mode) noexcept;
+        ScopedTimer(Collector* t_collector, Mode t_mode, Phase t_phase) noexcept;
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+        ~ScopedTimer();
+
+      private:
+        Collector*                            m_collector { nullptr };
+        Mode                                  m_mode      { Mode::Education };
+        Phase                                 m_phase     { Phase::Size };
+        std::chrono::steady_clock::time_point m_start     { };
+        allocation::Counters                  m_allocations { };
+    };
+  } // namespace statistics
+} // namespace network
+
+#define NETWORK_STATISTICS_CONCAT_IMPL(a, b) a##b
+#define NETWORK_STATISTICS_CONCAT(a, b) NETWORK_STATISTICS_CONCAT_IMPL(a, b)
+
+#ifdef NETWORK_STATISTICS
+#define NETWORK_STATISTICS_SCOPE(...) \
+  ::network::statistics::ScopedTimer NETWORK_STATISTICS_CONCAT(statistics_timer_, __LINE__)(__VA_ARGS__)
+#else
+#define NETWORK_STATISTICS_SCOPE(...) static_cast<void>(0)
+#endif
+
+#endif // NETWORK_STATISTICS_HPP_
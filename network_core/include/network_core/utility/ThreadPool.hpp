@@ -0,0 +1,76 @@
+#pragma once
+
+#ifndef NETWORK_THREAD_POOL_HPP_
+#define NETWORK_THREAD_POOL_HPP_
+
+// STL
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace network {
+namespace utility {
+  /**
+   * @brief Fixed set of threads that run the independent tasks of one step together with the caller.
+   *
+   * run() hands out the tasks one by one and returns once all of them are done, so the tasks of a step
+   * may read everything the previous step wrote. Calls from several threads are serialized, a task must
+   * not call run() of the same pool.
+   *
+   * A pinned pool binds its threads to the CPUs of utility::placement() and deals the tasks statically:
+   * task i always runs on thread i % size(), the caller of run() being thread 0. Buffers a task allocates
+   * on its first run are touched on the node of its thread and stay local in the steps after.
+   */
+  class ThreadPool {
+    public:
+      /**
+       * @param t_threads Threads that execute the tasks including the caller of run(), at least one.
+       * @param t_pin Bind thread i of the pool to utility::placement(t_threads)[i], the caller of run() keeps its binding.
+       */
+      explicit ThreadPool(std::size_t t_threads, bool t_pin = false);
+
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+      ~ThreadPool();
+
+      /**
+       * @brief Run t_task(0) ... t_task(t_count - 1) and wait for all of them.
+       * @throws The first exception thrown by a task, after the remaining tasks are done.
+       */
+      void run(std::size_t t_count, const std::function<void(std::size_t)>& t_task);
+
+      inline std::size_t size() const noexcept { return m_threads.size() + 1; }
+      inline bool pinned() const noexcept { return !m_cpus.empty(); }
+
+    private:
+      struct Job {
+        const std::function<void(std::size_t)>* task    { nullptr };
+        std::size_t                             count   { 0 };
+        std::atomic<std::size_t>                next    { 0 };
+        std::size_t                             workers { 0 }; // Threads of the pool that took part, guarded by m_mutex
+        std::size_t                             joined  { 0 }; // Threads of the pool that started on the job, guarded by m_mutex
+        std::exception_ptr                      error   { };
+      };
+
+      void work(std::size_t t_slot);
+      void execute(Job& t_job, std::size_t t_slot);
+
+      std::vector<std::thread> m_threads { };
+      std::vector<std::size_t> m_cpus    { }; // CPU of every thread when pinned
+      std::mutex               m_run     { }; // Serializes run()
+      std::mutex               m_mutex   { };
+      std::condition_variable  m_wake    { };
+      std::condition_variable  m_done    { };
+      Job*                     m_job     { nullptr };
+      std::uint64_t            m_runs    { 0 };  // Jobs started, a thread takes part in each job once
+      bool                     m_stop    { false };
+  };
+} // namespace utility
+} // namespace network
+#endif // NETWORK_THREAD_POOL_HPP_
@@ -0,0 +1,97 @@
+#include "network_core/utility/ActivationFunctions.hpp"
+
+// STL
+#include <type_traits>
+#include <vector>
+
+namespace network {
+namespace computation {
+  namespace {
+    using Function = std::remove_reference_t<decltype(sigmoid)>*;
+
+    /**
+     * @brief Values of the exact sigmoid at every step of [-range, range], the last one repeated for the interpolation.
+     */
+    const std::vector<double>& table() noexcept
+    {
+      static const std::vector<double> table_ = [] {
+        const auto size_ = static_cast<std::size_t>(2.0 * Constants::SIGMOID_TABLE_RANGE * Constants::SIGMOID_TABLE_STEPS) + 1;
+
+        std::vector<double> values_(size_ + 1);
+        for(std::size_t i = 0; i < size_; ++i) {
+          values_[i] = sigmoid(static_cast<double>(i) / Constants::SIGMOID_TABLE_STEPS - Constants::SIGMOID_TABLE_RANGE);
+        }
+        values_[size_] = values_[size_ - 1];
+        return values_;
+      }();
+
+      return table_;
+    }
+  } // namespace
+
+  double sigmoid_table(const double& t_x) noexcept
+  {
+    static const std::vector<double>& table_ = table();
+    static const double last_ = static_cast<double>(table_.size() - 2);
+
+    const double u_ = std::min(std::max((t_x + Constants::SIGMOID_TABLE_RANGE) * Constants::SIGMOID_TABLE_STEPS, 0.0), last_);
+    const auto   i_ = static_cast<std::size_t>(u_);
+    return table_[i_] + (u_ - static_cast<double>(i_)) * (table_[i_ + 1] - table_[i_]);
+  }
+
+  void vexp(const double* t_x, double* t_y, std::size_t t_size, Approximation t_approximation) noexcept
+  {
+    if(t_approximation == Approximation::Exact) {
+      for(std::size_t i = 0; i < t_size; ++i) t_y[i] = exp(t_x[i]);
+      return;
+    }
+
+    for(std::size_t i = 0; i < t_size; ++i) t_y[i] = exp_approx(t_x[i]);
+  }
+
+  void vsigmoid(const double* t_x, double* t_y, std::size_t t_size, Approximation t_approximation) noexcept
+  {
+    switch(t_approximation) {
+      case Approximation::Exact:
+        for(std::size_t i = 0; i < t_size; ++i) t_y[i] = sigmoid(t_x[i]);
+        break;
+      case Approximation::Polynomial:
+        for(std::size_t i = 0; i < t_size; ++i) t_y[i] = sigmoid_approx(t_x[i]);
+        break;
+      case Approximation::Table:
+        for(std::size_t i = 0; i < t_size; ++i) t_y[i] = sigmoid_table(t_x[i]);
+        break;
+    }
+  }
+
+  void vtanh(const double* t_x, double* t_y, std::size_t t_size, Approximation t_approximation) noexcept
+  {
+    if(t_approximation == Approximation::Exact) {
+      for(std::size_t i = 0; i < t_size; ++i) t_y[i] = std::tanh(t_x[i]);
+      return;
+    }
+
+    for(std::size_t i = 0; i < t_size; ++i) t_y[i] = tanh_approx(t_x[i]);
+  }
+
+  double (*sigmoid_of(Approximation t_approximation) noexcept)(const double&) noexcept
+  {
+    switch(t_approximation) {
+      case Approximation::Polynomial: return &sigmoid_approx;
+      case Approximation::Table:      return &sigmoid_table;
+      default:                        return &sigmoid;
+    }
+  }
+
+  std::optional<Approximation> approximation_of(const std::function<double(double)>& t_function) noexcept
+  {
+    if(const auto function_ = t_function.target<Function>()) {
+      if(*function_ == &sigmoid)        return Approximation::Exact;
+      if(*function_ == &sigmoid_approx) return Approximation::Polynomial;
+      if(*function_ == &sigmoid_table)  return Approximation::Table;
+    }
+
+    return std::nullopt;
+  }
+} // namespace computation
+} // namespace network
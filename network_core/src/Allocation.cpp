@@ -0,0 +1,95 @@
+#include "network_core/utility/Memory.hpp"
+
+// STL
+#include <cstdlib>
+#include <new>
+
+#ifdef NETWORK_COUNT_ALLOCATIONS
+namespace {
+  thread_local network::allocation::Counters counters_ { };
+
+  void* allocate(std::size_t t_size)
+  {
+    ++counters_.allocations;
+    counters_.bytes += t_size;
+    return std::malloc(t_size ? t_size : 1);
+  }
+
+  void* allocate(std::size_t t_size, std::align_val_t t_align)
+  {
+    ++counters_.allocations;
+    counters_.bytes += t_size;
+
+    const auto align_ = static_cast<std::size_t>(t_align);
+    return std::aligned_alloc(align_, (t_size + align_ - 1) / align_ * align_);
+  }
+
+  void deallocate(void* t_pointer) noexcept
+  {
+    if(t_pointer) {
+      ++counters_.deallocations;
+      std::free(t_pointer);
+    }
+  }
+} // namespace
+
+void* operator new(std::size_t t_size)
+{
+  if(void* pointer_ = allocate(t_size)) return pointer_;
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t t_size)
+{
+  if(void* pointer_ = allocate(t_size)) return pointer_;
+  throw std::bad_alloc();
+}
+
+void* operator new(std::size_t t_size, const std::nothrow_t&) noexcept   { return allocate(t_size); }
+void* operator new[](std::size_t t_size, const std::nothrow_t&) noexcept { return allocate(t_size); }
+
+void* operator new(std::size_t t_size, std::align_val_t t_align)
+{
+  if(void* pointer_ = allocate(t_size, t_align)) return pointer_;
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t t_size, std::align_val_t t_align)
+{
+  if(void* pointer_ = allocate(t_size, t_align)) return pointer_;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* t_pointer) noexcept                                     { deallocate(t_pointer); }
+void operator delete[](void* t_pointer) noexcept                                   { deallocate(t_pointer); }
+void operator delete(void* t_pointer, std::size_t) noexcept                        { deallocate(t_pointer); }
+void operator delete[](void* t_pointer, std::size_t) noexcept                      { deallocate(t_pointer); }
+void operator delete(void* t_pointer, const std::nothrow_t&) noexcept              { deallocate(t_pointer); }
+void operator delete[](void* t_pointer, const std::nothrow_t&) noexcept            { deallocate(t_pointer); }
+void operator delete(void* t_pointer, std::align_val_t) noexcept                   { deallocate(t_pointer); }
+void operator delete[](void* t_pointer, std::align_val_t) noexcept                 { deallocate(t_pointer); }
+void operator delete(void* t_pointer, std::size_t, std::align_val_t) noexcept      { deallocate(t_pointer); }
+void operator delete[](void* t_pointer, std::size_t, std::align_val_t) noexcept    { deallocate(t_pointer); }
+#endif
+
+namespace network {
+  namespace allocation {
+    bool enabled() noexcept
+    {
+#ifdef NETWORK_COUNT_ALLOCATIONS
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    Counters counters() noexcept
+    {
+#ifdef NETWORK_COUNT_ALLOCATIONS
+      return counters_;
+#else
+      return Counters();
+#endif
+    }
+  } // namespace allocation
+} // namespace network
@@ -0,0 +1,143 @@
+#include "network_core/Augmentation.hpp"
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+namespace network {
+  namespace {
+    inline std::uint64_t mix(std::uint64_t t_value) noexcept
+    {
+      t_value += 0x9e3779b97f4a7c15ULL;
+      t_value = (t_value ^ (t_value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      t_value = (t_value ^ (t_value >> 27)) * 0x94d049bb133111ebULL;
+      return t_value ^ (t_value >> 31);
+    }
+
+    /**
+     * @brief Parameters of a sample drawn from its own stream
+     */
+    class Draw {
+      public:
+        explicit Draw(std::uint64_t t_state) noexcept : m_state(t_state) { }
+
+        inline std::uint64_t next() noexcept { return mix(m_state++); }
+
+        // In [0, 1).
+        inline double uniform() noexcept { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+        // In [-1, 1).
+        inline double symmetric() noexcept { return 2.0 * uniform() - 1.0; }
+
+      private:
+        std::uint64_t m_state { 0 };
+    };
+  } // namespace
+
+  void augment(const Augmentation& t_augmentation, std::uint64_t t_key, const unsigned char* t_pixels, std::size_t t_rows,
+               std::size_t t_cols, std::size_t t_stride, double* t_values) noexcept
+  {
+    constexpr double PI { 3.14159265358979323846 };
+
+    // Every parameter is drawn even if it is disabled, enabling one doesn't change the others.
+    // Values are divided as Network::fill() divides them, an image that isn't moved gives the same values.
+    Draw draw_(mix(t_augmentation.seed) ^ t_key);
+    const bool flip_         = draw_.uniform() < t_augmentation.flip;
+    const double shift_      = static_cast<double>(t_augmentation.shift);
+    const auto dx_           = static_cast<std::ptrdiff_t>(std::floor(draw_.uniform() * (2.0 * shift_ + 1.0) - shift_));
+    const auto dy_           = static_cast<std::ptrdiff_t>(std::floor(draw_.uniform() * (2.0 * shift_ + 1.0) - shift_));
+    const double angle_      = draw_.symmetric() * t_augmentation.rotation * PI / 180.0;
+    const double offset_     = draw_.symmetric() * t_augmentation.brightness;
+    const double gain_       = 1.0 + draw_.symmetric() * t_augmentation.contrast;
+    const std::uint64_t noise_seed_ = draw_.next();
+
+    const auto rows_ = static_cast<std::ptrdiff_t>(t_rows);
+    const auto cols_ = static_cast<std::ptrdiff_t>(t_cols);
+
+    if(angle_ == 0.0) {
+      // Shifts and flips copy a contiguous run of every source row, the loops have no branches.
+      for(std::ptrdiff_t y = 0; y < rows_; ++y) {
+        double* out_ = t_values + y * cols_;
+        const std::ptrdiff_t sy_ = y - dy_;
+        if(sy_ < 0 || sy_ >= rows_) {
+          std::fill(out_, out_ + cols_, 0.0);
+          continue;
+        }
+
+        const unsigned char* row_ = t_pixels + static_cast<std::size_t>(sy_) * t_stride;
+        const std::ptrdiff_t begin_ = std::clamp<std::ptrdiff_t>(dx_, 0, cols_);
+        const std::ptrdiff_t end_   = std::clamp<std::ptrdiff_t>(cols_ + dx_, 0, cols_);
+        std::fill(out_, out_ + begin_, 0.0);
+        if(flip_) {
+          for(std::ptrdiff_t x = begin_; x < end_; ++x) out_[x] = row_[cols_ - 1 - (x - dx_)] / 255.0;
+        } else {
+          for(std::ptrdiff_t x = begin_; x < end_; ++x) out_[x] = row_[x - dx_] / 255.0;
+        }
+        std::fill(out_ + end_, out_ + cols_, 0.0);
+      }
+    } else {
+      // Nearest source pixel of the inverse map: shift, rotation around the centre, flip.
+      const double cos_ = std::cos(angle_);
+      const double sin_ = std::sin(angle_);
+      const double cx_  = 0.5 * static_cast<double>(t_cols - 1);
+      const double cy_  = 0.5 * static_cast<double>(t_rows - 1);
+
+      // Coordinates are rounded by truncation of a positive number, which compiles to one conversion instead of a call.
+      constexpr double ORIGIN { 1 << 20 };
+      const auto origin_ = static_cast<std::int64_t>(ORIGIN);
+
+      for(std::ptrdiff_t y = 0; y < rows_; ++y) {
+        double* out_ = t_values + y * cols_;
+        const double v_ = static_cast<double>(y - dy_) - cy_;
+        for(std::ptrdiff_t x = 0; x < cols_; ++x) {
+          const double u_ = static_cast<double>(x - dx_) - cx_;
+          std::int64_t sx_ = static_cast<std::int64_t>(cos_ * u_ + sin_ * v_ + cx_ + ORIGIN + 0.5) - origin_;
+          const std::int64_t sy_ = static_cast<std::int64_t>(-sin_ * u_ + cos_ * v_ + cy_ + ORIGIN + 0.5) - origin_;
+          sx_ = flip_ ? cols_ - 1 - sx_ : sx_;
+
+          const bool inside_ = sx_ >= 0 && sy_ >= 0 && sx_ < cols_ && sy_ < rows_;
+          out_[x] = inside_ ? t_pixels[static_cast<std::size_t>(sy_) * t_stride + static_cast<std::size_t>(sx_)] / 255.0 : 0.0;
+        }
+      }
+    }
+
+    const std::size_t size_ = t_rows * t_cols;
+
+    // Brightness and contrast in one pass, the clamp is a min and a max the compiler vectorizes.
+    if(gain_ != 1.0 || offset_ != 0.0) {
+      const double bias_ = 0.5 - 0.5 * gain_ + offset_;
+      for(std::size_t i = 0; i < size_; ++i) {
+        t_values[i] = std::min(std::max(t_values[i] * gain_ + bias_, 0.0), 1.0);
+      }
+    }
+
+    // Noise comes from independent xorshift generators, one per lane: shifts and xors of 32-bit words are vector
+    // instructions and no value waits for the one before it. Four 16-bit uniforms summed are close to a normal distribution.
+    if(t_augmentation.noise > 0.0) {
+      constexpr std::size_t LANES { 16 };
+      std::uint32_t states_[LANES];
+      std::int32_t  sums_[LANES];
+      for(std::size_t l = 0; l < LANES; ++l) {
+        states_[l] = static_cast<std::uint32_t>(mix(noise_seed_ + l)) | 1u;
+      }
+
+      const double scale_ = t_augmentation.noise * std::sqrt(3.0) / 65535.0;
+      for(std::size_t i = 0; i < size_; i += LANES) {
+        for(std::size_t l = 0; l < LANES; ++l) {
+          std::uint32_t first_ = states_[l];
+          first_ ^= first_ << 13; first_ ^= first_ >> 17; first_ ^= first_ << 5;
+          std::uint32_t second_ = first_;
+          second_ ^= second_ << 13; second_ ^= second_ >> 17; second_ ^= second_ << 5;
+          states_[l] = second_;
+
+          sums_[l] = static_cast<std::int32_t>((first_ & 0xffff) + (first_ >> 16) + (second_ & 0xffff) + (second_ >> 16)) - 2 * 65535;
+        }
+
+        const std::size_t count_ = std::min(LANES, size_ - i);
+        for(std::size_t l = 0; l < count_; ++l) {
+          t_values[i + l] = std::min(std::max(t_values[i + l] + static_cast<double>(sums_[l]) * scale_, 0.0), 1.0);
+        }
+      }
+    }
+  }
+} // namespace network
@@ -0,0 +1,96 @@
+#include "network_core/utility/BufferPool.hpp"
+
+// STL
+#include <new>
+#include <utility>
+
+namespace network {
+namespace utility {
+  BufferPool::Buffer::Buffer(Buffer&& t_buffer) noexcept
+    : m_pool(std::exchange(t_buffer.m_pool, nullptr))
+    , m_data(std::exchange(t_buffer.m_data, nullptr))
+  {
+  }
+
+  BufferPool::Buffer& BufferPool::Buffer::operator=(Buffer&& t_buffer) noexcept
+  {
+    if(this != &t_buffer) {
+      if(m_data) {
+        m_pool->release(m_data);
+      }
+      m_pool = std::exchange(t_buffer.m_pool, nullptr);
+      m_data = std::exchange(t_buffer.m_data, nullptr);
+    }
+    return *this;
+  }
+
+  BufferPool::Buffer::~Buffer()
+  {
+    if(m_data) {
+      m_pool->release(m_data);
+    }
+  }
+
+  BufferPool::BufferPool(std::size_t t_bytes, std::size_t t_alignment)
+    : m_bytes(t_bytes)
+    , m_alignment(t_alignment)
+  {
+  }
+
+  BufferPool::~BufferPool()
+  {
+    for(auto* block : m_all) {
+      ::operator delete(block, std::align_val_t(m_alignment));
+    }
+  }
+
+  BufferPool::Buffer BufferPool::acquire()
+  {
+    auto& own_ = shard();
+    for(std::size_t s = 0; s < SHARDS; ++s) {
+      auto& shard_ = s == 0 ? own_ : m_shards[(static_cast<std::size_t>(&own_ - m_shards.data()) + s) % SHARDS];
+
+      std::lock_guard<std::mutex> lock_(shard_.mutex);
+      if(!shard_.free.empty()) {
+        auto* block_ = shard_.free.back();
+        shard_.free.pop_back();
+        return Buffer(this, block_);
+      }
+    }
+
+    auto* block_ = static_cast<unsigned char*>(::operator new(m_bytes, std::align_val_t(m_alignment)));
+
+    // Every list can hold all blocks, so release() never grows a list.
+    std::lock_guard<std::mutex> lock_(m_mutex);
+    try {
+      m_all.push_back(block_);
+      for(auto& shard_ : m_shards) {
+        std::lock_guard<std::mutex> shard_lock_(shard_.mutex);
+        shard_.free.reserve(m_all.size());
+      }
+    } catch(...) {
+      if(m_all.empty() || m_all.back() != block_) {
+        ::operator delete(block_, std::align_val_t(m_alignment));
+      }
+      throw;
+    }
+
+    m_blocks.fetch_add(1, std::memory_order_relaxed);
+    return Buffer(this, block_);
+  }
+
+  void BufferPool::release(unsigned char* t_data) noexcept
+  {
+    auto& shard_ = shard();
+    std::lock_guard<std::mutex> lock_(shard_.mutex);
+    shard_.free.push_back(t_data);
+  }
+
+  BufferPool::Shard& BufferPool::shard() noexcept
+  {
+    static std::atomic<std::size_t> threads_ { 0 };
+    thread_local const std::size_t index_ = threads_.fetch_add(1, std::memory_order_relaxed);
+    return m_shards[index_ % SHARDS];
+  }
+} // namespace utility
+} // namespace network
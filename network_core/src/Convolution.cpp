@@ -0,0 +1,137 @@
+#include "network_core/primitives/Convolution.hpp"
+#include "network_core/utility/Kernels.hpp"
+#include "network_core/Constants.hpp"
+
+// STL
+#include <cstdlib>
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+
+namespace network {
+  namespace primitives {
+    Convolution::Convolution(const Shape& t_input, std::size_t t_filters, std::size_t t_kernel, std::size_t t_stride,
+                             std::function<double(double)> t_func)
+    : m_input(t_input), m_kernel(t_kernel), m_stride(t_stride), m_active_func(t_func)
+    {
+      if(t_filters == 0 || t_kernel == 0 || t_stride == 0) {
+        throw std::out_of_range("filters, kernel and stride must be > 0");
+      }
+
+      if(t_kernel > m_input.height || t_kernel > m_input.width) {
+        throw std::out_of_range("kernel > input size");
+      }
+
+      m_output.channels = t_filters;
+      m_output.height   = (m_input.height - m_kernel) / m_stride + 1;
+      m_output.width    = (m_input.width  - m_kernel) / m_stride + 1;
+
+      const std::size_t patch_ = m_input.channels * m_kernel * m_kernel;
+      const std::size_t area_  = m_output.height * m_output.width;
+
+      auto random = [](double min, double max) {
+        return (double)(rand())/RAND_MAX*(max - min) + min;
+      };
+
+      m_weights.resize(t_filters * patch_);
+      std::generate(m_weights.begin(), m_weights.end(), [&]() { return random(-0.5, 0.5); });
+
+      m_bias.assign(t_filters, 0.0);
+      m_gradient.assign(m_weights.size(), 0.0);
+      m_gradient_bias.assign(t_filters, 0.0);
+      m_columns.assign(patch_ * area_, 0.0);
+      m_delta.assign(m_output.size(), 0.0);
+      m_error_columns.assign(patch_ * area_, 0.0);
+    }
+
+    Shape Convolution::input() const noexcept
+    {
+      return m_input;
+    }
+
+    Shape Convolution::output() const noexcept
+    {
+      return m_output;
+    }
+
+    void Convolution::calculate(const TypeValues& t_input, TypeValues& t_output) noexcept
+    {
+      const std::size_t patch_ = m_input.channels * m_kernel * m_kernel;
+      const std::size_t area_  = m_output.height * m_output.width;
+
+      t_output.resize(m_output.size());
+
+      computation::im2col(t_input.data(), m_input.channels, m_input.height, m_input.width, m_kernel, m_stride, m_columns.data());
+      computation::gemm(false, false, m_output.channels, area_, patch_, 1.0, m_weights.data(), m_columns.data(), 0.0, t_output.data());
+
+      for(std::size_t f = 0; f < m_output.channels; ++f) {
+        double* row_ = t_output.data() + f * area_;
+        for(std::size_t i = 0; i < area_; ++i) {
+          row_[i] = m_active_func ? m_active_func(row_[i] + m_bias[f]) : row_[i] + m_bias[f];
+        }
+      }
+    }
+
+    void Convolution::update(const TypeValues& /*t_input*/, const TypeValues& t_output,
+                             const TypeValues& t_error, TypeValues& t_error_input) noexcept
+    {
+      const std::size_t patch_ = m_input.channels * m_kernel * m_kernel;
+      const std::size_t area_  = m_output.height * m_output.width;
+
+      for(std::size_t i = 0; i < m_delta.size(); ++i) {
+        m_delta[i] = m_active_func ? t_error[i] * computation::differential(m_active_func, t_output[i]) : t_error[i];
+      }
+
+      // Gradient of the weights: delta (filters x area) * columns^T (area x patch).
+      computation::gemm(false, true, m_output.channels, patch_, area_, 1.0, m_delta.data(), m_columns.data(), 0.0, m_gradient.data());
+
+      for(std::size_t f = 0; f < m_output.channels; ++f) {
+        const double* row_ = m_delta.data() + f * area_;
+        m_gradient_bias[f] = std::accumulate(row_, row_ + area_, 0.0);
+      }
+
+      // Error of the input: weights^T (patch x filters) * delta (filters x area), folded back by col2im.
+      computation::gemm(true, false, patch_, area_, m_output.channels, 1.0, m_weights.data(), m_delta.data(), 0.0, m_error_columns.data());
+
+      t_error_input.assign(m_input.size(), 0.0);
+      computation::col2im(m_error_columns.data(), m_input.channels, m_input.height, m_input.width, m_kernel, m_stride, t_error_input.data());
+    }
+
+    void Convolution::updateWeight(const double& t_rate) noexcept
+    {
+      for(std::size_t i = 0; i < m_weights.size(); ++i) {
+        m_weights[i] += t_rate * m_gradient[i];
+      }
+
+      for(std::size_t f = 0; f < m_bias.size(); ++f) {
+        m_bias[f] += t_rate * m_gradient_bias[f];
+      }
+    }
+
+    std::size_t Convolution::size() const noexcept
+    {
+      return m_weights.size() + m_bias.size();
+    }
+
+    void Convolution::parameters(TypeValueFeature* t_parameters) const noexcept
+    {
+      std::copy(m_bias.begin(), m_bias.end(), std::copy(m_weights.begin(), m_weights.end(), t_parameters));
+    }
+
+    void Convolution::setParameters(const TypeValueFeature* t_parameters) noexcept
+    {
+      std::copy(t_parameters, t_parameters + m_weights.size(), m_weights.begin());
+      std::copy(t_parameters + m_weights.size(), t_parameters + m_weights.size() + m_bias.size(), m_bias.begin());
+    }
+
+    MemoryUsage Convolution::memory() const noexcept
+    {
+      MemoryUsage usage_ { };
+      usage_.weights     = (m_weights.capacity() + m_bias.capacity()) * sizeof(TypeValueFeature);
+      usage_.gradients   = (m_gradient.capacity() + m_gradient_bias.capacity() + m_delta.capacity() + m_error_columns.capacity()) * sizeof(TypeValueFeature);
+      usage_.activations = m_columns.capacity() * sizeof(TypeValueFeature);
+      usage_.overhead    = sizeof(Convolution);
+      return usage_;
+    }
+  } // namespace primitives
+} // namespace network
@@ -0,0 +1,87 @@
+#include "network_core/Dataset.hpp"
+#include "network_core/Network.hpp"
+#include "network_core/Exeption.hpp"
+#include "network_core/utility/ThreadPool.hpp"
+
+// STL
+#include <algorithm>
+#include <map>
+
+// Boost
+#include <boost/filesystem.hpp>
+
+namespace network {
+  Dataset::Listing Dataset::list(const std::string& t_path, const std::vector<std::string>& t_categorys)
+  {
+    if(t_path.empty() || !fs::exists(fs::path(t_path))) {
+      throw FolderNotFoundError("Could not find dataset folder " + t_path);
+    }
+
+    const auto& formats_ = Network::formats();
+    std::map<std::string, std::vector<std::string>> files_ { };
+
+    for(fs::recursive_directory_iterator it(t_path), end; it != end; ++it) {
+      const std::string folder_ = (fs::is_regular_file(it->path()) ? it->path().parent_path() : it->path()).filename().string();
+      if(std::find(t_categorys.begin(), t_categorys.end(), folder_) == t_categorys.end()) {
+        continue;
+      }
+
+      // Folder is a category, a file of it is kept if it has one of the formats being processed.
+      auto& collage_ = files_[folder_];
+      if(fs::is_regular_file(it->path()) && std::find(formats_.begin(), formats_.end(), it->path().extension().string()) != formats_.end()) {
+        collage_.push_back(it->path().string());
+      }
+    }
+
+    Listing listing_ { };
+    for(const auto& category : t_categorys) {
+      auto collage_ = files_.find(category);
+      if(collage_ == files_.end()) {
+        continue;
+      }
+
+      std::sort(collage_->second.begin(), collage_->second.end());
+      for(const auto& image : collage_->second) {
+        listing_.paths.push_back(image);
+        listing_.labels.push_back(listing_.categorys.size());
+      }
+      listing_.categorys.push_back(category);
+    }
+
+    return listing_;
+  }
+
+  Dataset::Dataset(const std::string& t_path, const std::vector<std::string>& t_categorys, const utility::ThreadPoolPtr& t_pool)
+  : m_path(t_path)
+  {
+    auto listing_ = list(t_path, t_categorys);
+    m_categorys = std::move(listing_.categorys);
+    const auto& paths_  = listing_.paths;
+    const auto& labels_ = listing_.labels;
+
+    std::vector<cv::Mat> images_(paths_.size());
+    const auto decode_ = [&](std::size_t t_index) { images_[t_index] = cv::imread(paths_[t_index]); };
+    if(t_pool) {
+      t_pool->run(paths_.size(), decode_);
+    } else {
+      for(std::size_t i = 0; i < paths_.size(); ++i) decode_(i);
+    }
+
+    // Files that aren't images are skipped as education() skips them.
+    m_samples.reserve(images_.size());
+    for(std::size_t i = 0; i < images_.size(); ++i) {
+      if(!images_[i].empty()) {
+        m_samples.emplace_back(std::move(images_[i]), labels_[i]);
+      }
+    }
+  }
+
+  std::size_t Dataset::bytes() const noexcept
+  {
+    std::size_t bytes_ { 0 };
+    for(const auto& [image, label] : m_samples) {
+      bytes_ += image.total() * image.elemSize();
+    }
+    return bytes_;
+  }
+} // namespace network
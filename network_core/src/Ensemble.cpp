@@ -0,0 +1,158 @@
+#include "network_core/Ensemble.hpp"
+#include "network_core/utility/Kernels.hpp"
+#include "network_core/utility/ThreadPool.hpp"
+#include "network_core/Exeption.hpp"
+
+// STL
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <variant>
+
+// Boost
+#include <boost/filesystem.hpp>
+
+namespace network {
+  Ensemble::Ensemble(std::vector<InferenceModelPtr> t_members, Combination t_combination, std::vector<double> t_weights, utility::ThreadPoolPtr t_pool)
+  : m_members(std::move(t_members)), m_combination(t_combination), m_weights(std::move(t_weights)), m_pool(std::move(t_pool))
+  {
+    if(m_members.empty() || std::find(m_members.begin(), m_members.end(), nullptr) != m_members.end()) {
+      throw std::out_of_range("ensemble has no members");
+    }
+
+    const std::size_t inputs_ = m_members.front()->inputs();
+    for(const auto& member : m_members) {
+      if(member->inputs() != inputs_) {
+        throw std::out_of_range("member inputs != inputs of the first member");
+      }
+    }
+
+    if(m_weights.empty()) {
+      m_weights.assign(m_members.size(), 1.0);
+    }
+    if(m_weights.size() != m_members.size()) {
+      throw std::out_of_range("weights.size() != members.size()");
+    }
+
+    const double total_ = std::accumulate(m_weights.begin(), m_weights.end(), 0.0);
+    if(std::any_of(m_weights.begin(), m_weights.end(), [](double t_weight) { return !(t_weight >= 0.0); }) || !(total_ > 0.0)) {
+      throw NetworkError("ensemble weights must not be negative and must not all be zero");
+    }
+    for(auto& weight : m_weights) {
+      weight /= total_;
+    }
+
+    // Categories are matched by name, members may order their outputs differently. Outputs of a member
+    // with the same name (e.g. not yet labeled) take the columns of that name one after another.
+    m_offsets.push_back(0);
+    for(const auto& member : m_members) {
+      auto& columns_ = m_columns.emplace_back();
+      std::vector<bool> taken_(m_labels.size(), false);
+
+      for(const auto& label : member->labels()) {
+        std::size_t column_ { 0 };
+        while(column_ < m_labels.size() && (taken_[column_] || m_labels[column_] != label)) {
+          ++column_;
+        }
+        if(column_ == m_labels.size()) {
+          m_labels.push_back(label);
+          taken_.push_back(false);
+        }
+
+        taken_[column_] = true;
+        columns_.push_back(column_);
+      }
+      m_offsets.push_back(m_offsets.back() + member->outputs());
+    }
+
+    // First layers of the same input are rows of one matrix, one pass over the input calculates all of them.
+    const bool dense_ = m_members.size() > 1 && std::all_of(m_members.begin(), m_members.end(), [](const auto& t_member) {
+      return std::holds_alternative<InferenceModel::Dense>(t_member->stages().front());
+    });
+
+    if(dense_) {
+      m_rows.push_back(0);
+      for(const auto& member : m_members) {
+        const auto& first_ = std::get<InferenceModel::Dense>(member->stages().front());
+        m_stacked.insert(m_stacked.end(), first_.weights.begin(), first_.weights.end());
+        m_rows.push_back(m_rows.back() + first_.outputs);
+      }
+    }
+  }
+
+  void Ensemble::forward(const double* t_input, double* t_output) const
+  {
+    // Scratch buffers of the calling thread, the tasks on the pool reach them through the pointers.
+    thread_local std::vector<double> sums_;
+    thread_local std::vector<double> scores_;
+
+    scores_.resize(m_offsets.back());
+    double* scores = scores_.data();
+    double* sums   = nullptr;
+
+    if(stacked()) {
+      sums_.resize(m_rows.back());
+      sums = sums_.data();
+      computation::gemv(m_rows.back(), inputs(), m_stacked.data(), t_input, sums);
+    }
+
+    const auto task_ = [this, t_input, scores, sums](std::size_t t_member) {
+      const auto& member_ = *m_members[t_member];
+      if(sums) {
+        const auto& first_ = std::get<InferenceModel::Dense>(member_.stages().front());
+        member_.activate(first_.activation, sums + m_rows[t_member], first_.outputs);
+        member_.forward(1, sums + m_rows[t_member], scores + m_offsets[t_member]);
+      } else {
+        member_.forward(t_input, scores + m_offsets[t_member]);
+      }
+    };
+
+    if(m_pool && m_members.size() > 1) {
+      m_pool->run(m_members.size(), task_);
+    } else {
+      for(std::size_t m = 0; m < m_members.size(); ++m) task_(m);
+    }
+
+    std::fill(t_output, t_output + m_labels.size(), 0.0);
+    for(std::size_t m = 0; m < m_members.size(); ++m) {
+      const double* member_scores_ = scores + m_offsets[m];
+      const auto& columns_ = m_columns[m];
+
+      if(m_combination == Combination::Vote) {
+        const auto best_ = std::max_element(member_scores_, member_scores_ + columns_.size()) - member_scores_;
+        t_output[columns_[static_cast<std::size_t>(best_)]] += m_weights[m];
+      } else {
+        for(std::size_t o = 0; o < columns_.size(); ++o) {
+          t_output[columns_[o]] += m_weights[m] * member_scores_[o];
+        }
+      }
+    }
+  }
+
+  std::vector<Prediction> Ensemble::perception(const cv::Mat& t_image, std::size_t t_top) const
+  {
+    thread_local std::vector<double> input_;
+    thread_local std::vector<double> output_;
+
+    // Every member reads the same input values, the image is converted once.
+    m_members.front()->fill(t_image, input_);
+    output_.resize(m_labels.size());
+    forward(input_.data(), output_.data());
+
+    return rank(m_labels, output_.data(), t_top);
+  }
+
+  std::vector<Prediction> Ensemble::perception(const std::string& t_data, std::size_t t_top) const
+  {
+    if(!boost::filesystem::exists(t_data)) {
+      return { };
+    }
+
+    const cv::Mat data_input_ = cv::imread(t_data);
+    if(data_input_.empty()) {
+      return { };
+    }
+
+    return perception(data_input_, t_top);
+  }
+} // namespace network
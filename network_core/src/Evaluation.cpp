@@ -0,0 +1,252 @@
+#include "network_core/Evaluation.hpp"
+#include "network_core/Dataset.hpp"
+#include "network_core/InferenceModel.hpp"
+#include "network_core/utility/Json.hpp"
+#include "network_core/utility/ThreadPool.hpp"
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <limits>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+namespace network {
+  namespace {
+    constexpr std::size_t SKIPPED { std::numeric_limits<std::size_t>::max() };
+
+    double ratio(std::size_t t_part, std::size_t t_whole) noexcept
+    {
+      return t_whole ? static_cast<double>(t_part) / static_cast<double>(t_whole) : 0.0;
+    }
+
+    /**
+     * @brief Scores t_count images, t_image(i) decodes image i, t_labels[i] is its category
+     */
+    template<typename Decode>
+    Evaluation score(const InferenceModel& t_model, std::vector<std::string> t_categorys, const std::vector<std::size_t>& t_labels,
+                     const Decode& t_image, const utility::ThreadPoolPtr& t_pool, std::size_t t_batch)
+    {
+      const auto start_ = std::chrono::steady_clock::now();
+
+      // Column of the confusion matrix of every output, outputs of other categories share the last column.
+      const auto& labels_ = t_model.labels();
+      std::vector<std::size_t> columns_(labels_.size(), t_categorys.size());
+      for(std::size_t o = 0; o < labels_.size(); ++o) {
+        const auto found_ = std::find(t_categorys.begin(), t_categorys.end(), labels_[o]);
+        if(found_ != t_categorys.end()) {
+          columns_[o] = static_cast<std::size_t>(found_ - t_categorys.begin());
+        }
+      }
+
+      // Every image has its own slot, the tally below sees the predictions in the order of the dataset.
+      const std::size_t count_ = t_labels.size();
+      const std::size_t batch_ = std::max<std::size_t>(1, t_batch);
+      const std::size_t batches_ = (count_ + batch_ - 1) / batch_;
+      std::vector<std::size_t> predicted_(count_, SKIPPED);
+
+      // A batch decodes its images into the rows of one matrix and scores them with one pass of the model.
+      const auto task_ = [&](std::size_t t_index) {
+        thread_local std::vector<double> input_;
+        thread_local std::vector<double> inputs_;
+        thread_local std::vector<double> outputs_;
+        thread_local std::vector<std::size_t> images_;
+
+        const std::size_t width_ = t_model.inputs();
+        images_.clear();
+        inputs_.resize(batch_ * width_);
+        for(std::size_t i = t_index * batch_; i < std::min(count_, (t_index + 1) * batch_); ++i) {
+          const cv::Mat image_ = t_image(i);
+          if(image_.empty()) {
+            continue;
+          }
+
+          t_model.fill(image_, input_);
+          std::copy(input_.begin(), input_.end(), inputs_.begin() + static_cast<std::ptrdiff_t>(images_.size() * width_));
+          images_.push_back(i);
+        }
+
+        if(images_.empty()) {
+          return;
+        }
+
+        const std::size_t scores_ = t_model.outputs();
+        outputs_.resize(images_.size() * scores_);
+        t_model.forwardBatch(images_.size(), inputs_.data(), outputs_.data());
+
+        for(std::size_t b = 0; b < images_.size(); ++b) {
+          const auto row_ = outputs_.begin() + static_cast<std::ptrdiff_t>(b * scores_);
+          predicted_[images_[b]] = scores_ == 0 ? t_categorys.size()
+            : columns_[static_cast<std::size_t>(std::max_element(row_, row_ + static_cast<std::ptrdiff_t>(scores_)) - row_)];
+        }
+      };
+
+      if(t_pool && batches_ > 1) {
+        t_pool->run(batches_, task_);
+      } else {
+        for(std::size_t b = 0; b < batches_; ++b) task_(b);
+      }
+
+      Evaluation evaluation_ { };
+      evaluation_.confusion.assign(t_categorys.size(), std::vector<std::size_t>(t_categorys.size() + 1, 0));
+      for(std::size_t i = 0; i < count_; ++i) {
+        if(predicted_[i] == SKIPPED) {
+          ++evaluation_.skipped;
+          continue;
+        }
+
+        ++evaluation_.confusion[t_labels[i]][predicted_[i]];
+        ++evaluation_.samples;
+        evaluation_.correct += predicted_[i] == t_labels[i] ? 1 : 0;
+      }
+
+      evaluation_.categorys = std::move(t_categorys);
+      evaluation_.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+      return evaluation_;
+    }
+  } // namespace
+
+  double Evaluation::accuracy() const noexcept
+  {
+    return ratio(correct, samples);
+  }
+
+  double Evaluation::samplesPerSecond() const noexcept
+  {
+    return seconds > 0.0 ? static_cast<double>(samples) / seconds : 0.0;
+  }
+
+  std::size_t Evaluation::support(std::size_t t_category) const noexcept
+  {
+    std::size_t support_ { 0 };
+    for(const auto& count : confusion[t_category]) {
+      support_ += count;
+    }
+    return support_;
+  }
+
+  double Evaluation::precision(std::size_t t_category) const noexcept
+  {
+    std::size_t predicted_ { 0 };
+    for(const auto& row : confusion) {
+      predicted_ += row[t_category];
+    }
+    return ratio(confusion[t_category][t_category], predicted_);
+  }
+
+  double Evaluation::recall(std::size_t t_category) const noexcept
+  {
+    return ratio(confusion[t_category][t_category], support(t_category));
+  }
+
+  double Evaluation::f1(std::size_t t_category) const noexcept
+  {
+    const double precision_ = precision(t_category);
+    const double recall_    = recall(t_category);
+    return (precision_ + recall_) > 0.0 ? 2.0 * precision_ * recall_ / (precision_ + recall_) : 0.0;
+  }
+
+  double Evaluation::macroF1() const noexcept
+  {
+    double sum_ { 0.0 };
+    std::size_t categorys_ { 0 };
+    for(std::size_t c = 0; c < categorys.size(); ++c) {
+      if(support(c)) {
+        sum_ += f1(c);
+        ++categorys_;
+      }
+    }
+    return categorys_ ? sum_ / static_cast<double>(categorys_) : 0.0;
+  }
+
+  std::ostream& operator<<(std::ostream& t_stream, const Evaluation& t_evaluation)
+  {
+    const auto flags_ = t_stream.flags();
+    const auto precision_ = t_stream.precision();
+
+    std::size_t width_ { 10 };
+    for(const auto& category : t_evaluation.categorys) {
+      width_ = std::max(width_, category.size() + 2);
+    }
+
+    t_stream << std::left << std::setw(static_cast<int>(width_)) << "category" << std::setw(11) << "precision"
+             << std::setw(10) << "recall" << std::setw(10) << "f1" << "support" << "\n";
+    for(std::size_t c = 0; c < t_evaluation.categorys.size(); ++c) {
+      t_stream << std::setw(static_cast<int>(width_)) << t_evaluation.categorys[c] << std::fixed << std::setprecision(4)
+               << std::setw(11) << t_evaluation.precision(c) << std::setw(10) << t_evaluation.recall(c)
+               << std::setw(10) << t_evaluation.f1(c) << t_evaluation.support(c) << "\n";
+    }
+
+    // Confusion matrix, a row per true category, a column per prediction.
+    t_stream << "\n" << std::setw(static_cast<int>(width_)) << "true\\pred";
+    for(std::size_t c = 0; c <= t_evaluation.categorys.size(); ++c) {
+      t_stream << std::setw(static_cast<int>(width_)) << (c < t_evaluation.categorys.size() ? t_evaluation.categorys[c] : "other");
+    }
+    t_stream << "\n";
+    for(std::size_t r = 0; r < t_evaluation.categorys.size(); ++r) {
+      t_stream << std::setw(static_cast<int>(width_)) << t_evaluation.categorys[r];
+      for(const auto& count : t_evaluation.confusion[r]) {
+        t_stream << std::setw(static_cast<int>(width_)) << count;
+      }
+      t_stream << "\n";
+    }
+
+    t_stream << "\naccuracy " << std::setprecision(4) << t_evaluation.accuracy() << ", macro f1 " << t_evaluation.macroF1()
+             << ", " << t_evaluation.samples << " samples";
+    if(t_evaluation.skipped) {
+      t_stream << " (" << t_evaluation.skipped << " skipped)";
+    }
+    t_stream << " in " << std::setprecision(2) << t_evaluation.seconds << " s, "
+             << std::setprecision(1) << t_evaluation.samplesPerSecond() << " samples/s";
+
+    t_stream.flags(flags_);
+    t_stream.precision(precision_);
+    return t_stream;
+  }
+
+  void write(std::ostream& t_stream, const Evaluation& t_evaluation)
+  {
+    t_stream << "{\n  \"accuracy\": " << t_evaluation.accuracy() << ",\n  \"macro_f1\": " << t_evaluation.macroF1()
+             << ",\n  \"samples\": " << t_evaluation.samples << ",\n  \"skipped\": " << t_evaluation.skipped
+             << ",\n  \"seconds\": " << t_evaluation.seconds << ",\n  \"samples_per_second\": " << t_evaluation.samplesPerSecond()
+             << ",\n  \"categorys\": [";
+    for(std::size_t c = 0; c < t_evaluation.categorys.size(); ++c) {
+      t_stream << (c ? "," : "") << "\n    {\"category\": " << utility::quote(t_evaluation.categorys[c])
+               << ", \"precision\": " << t_evaluation.precision(c) << ", \"recall\": " << t_evaluation.recall(c)
+               << ", \"f1\": " << t_evaluation.f1(c) << ", \"support\": " << t_evaluation.support(c) << "}";
+    }
+
+    t_stream << "\n  ],\n  \"confusion\": [";
+    for(std::size_t r = 0; r < t_evaluation.confusion.size(); ++r) {
+      t_stream << (r ? "," : "") << "\n    [";
+      for(std::size_t c = 0; c < t_evaluation.confusion[r].size(); ++c) {
+        t_stream << (c ? ", " : "") << t_evaluation.confusion[r][c];
+      }
+      t_stream << "]";
+    }
+    t_stream << "\n  ]\n}\n";
+  }
+
+  Evaluation evaluate(const InferenceModel& t_model, const Dataset& t_dataset, const utility::ThreadPoolPtr& t_pool, std::size_t t_batch)
+  {
+    const auto& samples_ = t_dataset.samples();
+
+    std::vector<std::size_t> labels_(samples_.size());
+    std::transform(samples_.begin(), samples_.end(), labels_.begin(), [](const auto& t_sample) { return t_sample.second; });
+
+    return score(t_model, t_dataset.categorys(), labels_, [&samples_](std::size_t t_index) { return samples_[t_index].first; },
+                 t_pool, t_batch);
+  }
+
+  Evaluation evaluate(const InferenceModel& t_model, const std::string& t_path, const std::vector<std::string>& t_categorys,
+                      const utility::ThreadPoolPtr& t_pool, std::size_t t_batch)
+  {
+    auto listing_ = Dataset::list(t_path, t_categorys);
+    const auto& paths_ = listing_.paths;
+
+    return score(t_model, std::move(listing_.categorys), listing_.labels, [&paths_](std::size_t t_index) { return cv::imread(paths_[t_index]); },
+                 t_pool, t_batch);
+  }
+} // namespace network
@@ -0,0 +1,73 @@
+#include "network_core/ImagePool.hpp"
+
+// STL
+#include <cerrno>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace network {
+  ImagePool::ImagePool(std::size_t t_width, std::size_t t_height)
+    : m_width(t_width)
+    , m_height(t_height)
+    , m_pixels(t_width * t_height * 3)
+  {
+  }
+
+  ImagePool::Image ImagePool::read(const std::string& t_path)
+  {
+    // Encoded files of one dataset have similar sizes, the buffer stops growing after a few of them.
+    thread_local std::vector<unsigned char> bytes_ { };
+
+    if(!load(t_path, bytes_)) {
+      return Image { };
+    }
+    return decode(bytes_);
+  }
+
+  ImagePool::Image ImagePool::decode(const std::vector<unsigned char>& t_bytes)
+  {
+    Image image_ { m_pixels.acquire(), { } };
+    image_.mat = cv::Mat(static_cast<int>(m_height), static_cast<int>(m_width), CV_8UC3, image_.buffer.data());
+
+    // The destination is reused when the decoded image has its size and type, a failure returns an empty image.
+    image_.mat = cv::imdecode(t_bytes, cv::IMREAD_COLOR, &image_.mat);
+    return image_;
+  }
+
+  bool ImagePool::load(const std::string& t_path, std::vector<unsigned char>& t_bytes)
+  {
+    t_bytes.clear();
+
+    const int file_ = ::open(t_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(file_ < 0) {
+      return false;
+    }
+
+    struct stat stat_ { };
+    bool status_ = ::fstat(file_, &stat_) == 0 && S_ISREG(stat_.st_mode);
+
+    if(status_) {
+      t_bytes.resize(static_cast<std::size_t>(stat_.st_size));
+
+      std::size_t done_ { 0 };
+      while(done_ < t_bytes.size()) {
+        const ssize_t count_ = ::read(file_, t_bytes.data() + done_, t_bytes.size() - done_);
+        if(count_ < 0 && errno == EINTR) {
+          continue;
+        }
+        if(count_ <= 0) {
+          status_ = count_ == 0 && done_ > 0;
+          break;
+        }
+        done_ += static_cast<std::size_t>(count_);
+      }
+      t_bytes.resize(done_);
+    }
+
+    ::close(file_);
+    return status_ && !t_bytes.empty();
+  }
+} // namespace network
@@ -0,0 +1,82 @@
+#include "network_core/IncrementalSession.hpp"
+#include "network_core/utility/Kernels.hpp"
+
+namespace network {
+  IncrementalSession::IncrementalSession(const InferenceModelPtr& t_model, double t_threshold, std::size_t t_refresh)
+  : m_model(t_model), m_threshold(t_threshold), m_refresh(t_refresh)
+  {
+    // Columns are contiguous, a changed input touches one row of the copy instead of every row of the weights.
+    if(const auto dense_ = std::get_if<InferenceModel::Dense>(&m_model->stages().front())) {
+      m_outputs = dense_->outputs;
+      m_columns.resize(dense_->inputs * dense_->outputs);
+      for(std::size_t o = 0; o < dense_->outputs; ++o) {
+        for(std::size_t i = 0; i < dense_->inputs; ++i) {
+          m_columns[i * m_outputs + o] = dense_->weights[o * dense_->inputs + i];
+        }
+      }
+    }
+  }
+
+  void IncrementalSession::forward(const double* t_input, double* t_output)
+  {
+    const std::size_t inputs_ = m_model->inputs();
+    if(m_outputs == 0) {
+      m_model->forward(t_input, t_output);
+      m_changed = inputs_;
+      return;
+    }
+
+    // Pixels are exact multiples of 1/255, an unchanged input compares equal.
+    const std::size_t limit_ = static_cast<std::size_t>(m_threshold * static_cast<double>(inputs_));
+    m_changes.clear();
+    m_changed = inputs_;
+    if(m_valid) {
+      m_changed = 0;
+      // Past the threshold the rest of the comparison is of no use.
+      for(std::size_t i = 0; i < inputs_ && m_changed <= limit_; ++i) {
+        if(t_input[i] != m_input[i]) {
+          ++m_changed;
+          m_changes.push_back(i);
+        }
+      }
+    }
+
+    m_incremental = m_valid && m_changed <= limit_ && m_calls < m_refresh;
+    if(m_incremental) {
+      for(const auto i : m_changes) {
+        const double delta_ = t_input[i] - m_input[i];
+        const double* column_ = m_columns.data() + i * m_outputs;
+        for(std::size_t o = 0; o < m_outputs; ++o) {
+          m_sums[o] += delta_ * column_[o];
+        }
+        m_input[i] = t_input[i];
+      }
+      ++m_calls;
+    } else {
+      const auto& dense_ = std::get<InferenceModel::Dense>(m_model->stages().front());
+      m_input.assign(t_input, t_input + inputs_);
+      m_sums.resize(m_outputs);
+      computation::gemv(m_outputs, inputs_, dense_.weights.data(), m_input.data(), m_sums.data());
+      m_calls = 0;
+      m_valid = true;
+    }
+
+    m_values.assign(m_sums.begin(), m_sums.end());
+    m_model->activate(std::get<InferenceModel::Dense>(m_model->stages().front()).activation, m_values.data(), m_outputs);
+    m_model->forward(1, m_values.data(), t_output);
+  }
+
+  std::vector<Prediction> IncrementalSession::perception(const cv::Mat& t_image, std::size_t t_top)
+  {
+    m_model->fill(t_image, m_frame);
+    m_output.resize(m_model->outputs());
+    forward(m_frame.data(), m_output.data());
+    return m_model->rank(m_output.data(), t_top);
+  }
+
+  void IncrementalSession::reset() noexcept
+  {
+    m_valid = false;
+    m_incremental = false;
+  }
+} // namespace network
@@ -0,0 +1,297 @@
+#include "network_core/InferenceModel.hpp"
+#include "network_core/utility/ActivationFunctions.hpp"
+#include "network_core/utility/Kernels.hpp"
+#include "network_core/Exeption.hpp"
+
+// STL
+#include <algorithm>
+#include <type_traits>
+
+// Boost
+#include <boost/filesystem.hpp>
+
+namespace network {
+  namespace {
+    using Function = std::remove_reference_t<decltype(computation::sigmoid)>*;
+
+    void apply(InferenceModel::Activation t_activation, double* t_values, std::size_t t_size, computation::Approximation t_approximation) noexcept
+    {
+      switch(t_activation) {
+        case InferenceModel::Activation::Identity:
+          break;
+        case InferenceModel::Activation::Sigmoid:
+          computation::vsigmoid(t_values, t_values, t_size, t_approximation);
+          break;
+        case InferenceModel::Activation::SingleJump:
+          for(std::size_t i = 0; i < t_size; ++i) t_values[i] = computation::single_jump(t_values[i]);
+          break;
+      }
+    }
+
+    std::size_t size(const InferenceModel::Stage& t_stage, bool t_output) noexcept
+    {
+      return std::visit([t_output](const auto& stage) -> std::size_t {
+        using T = std::decay_t<decltype(stage)>;
+        if constexpr (std::is_same_v<T, InferenceModel::Dense>) {
+          return t_output ? stage.outputs : stage.inputs;
+        } else {
+          return t_output ? stage.output.size() : stage.input.size();
+        }
+      }, t_stage);
+    }
+
+    /**
+     * @brief Outputs of one stage for one sample
+     * @param t_columns Scratch buffer of the convolutions.
+     */
+    void calculate(const InferenceModel::Stage& t_stage, const double* t_values, double* t_result, std::vector<double>& t_columns,
+                   computation::Approximation t_approximation)
+    {
+      if(const auto dense_ = std::get_if<InferenceModel::Dense>(&t_stage)) {
+        computation::gemv(dense_->outputs, dense_->inputs, dense_->weights.data(), t_values, t_result);
+        apply(dense_->activation, t_result, dense_->outputs, t_approximation);
+      } else if(const auto convolution_ = std::get_if<InferenceModel::Convolution>(&t_stage)) {
+        const std::size_t patch_ = convolution_->input.channels * convolution_->kernel * convolution_->kernel;
+        const std::size_t area_  = convolution_->output.height * convolution_->output.width;
+
+        t_columns.resize(patch_ * area_);
+        computation::im2col(t_values, convolution_->input.channels, convolution_->input.height, convolution_->input.width,
+                            convolution_->kernel, convolution_->stride, t_columns.data());
+        computation::gemm(false, false, convolution_->output.channels, area_, patch_, 1.0,
+                          convolution_->weights.data(), t_columns.data(), 0.0, t_result);
+
+        for(std::size_t f = 0; f < convolution_->output.channels; ++f) {
+          double* row_ = t_result + f * area_;
+          for(std::size_t i = 0; i < area_; ++i) {
+            row_[i] += convolution_->bias[f];
+          }
+          apply(convolution_->activation, row_, area_, t_approximation);
+        }
+      } else if(const auto pooling_ = std::get_if<InferenceModel::Pooling>(&t_stage)) {
+        const auto& in_  = pooling_->input;
+        const auto& out_ = pooling_->output;
+        const std::size_t window_ = pooling_->window;
+        const double scale_ = 1.0 / static_cast<double>(window_ * window_);
+
+        for(std::size_t c = 0; c < out_.channels; ++c) {
+          for(std::size_t y = 0; y < out_.height; ++y) {
+            for(std::size_t x = 0; x < out_.width; ++x) {
+              const std::size_t origin_ = (c * in_.height + y * window_) * in_.width + x * window_;
+
+              double best_ = t_values[origin_];
+              double acc_ { 0.0 };
+              for(std::size_t ky = 0; ky < window_; ++ky) {
+                const double* row_ = t_values + origin_ + ky * in_.width;
+                for(std::size_t kx = 0; kx < window_; ++kx) {
+                  acc_ += row_[kx];
+                  best_ = std::max(best_, row_[kx]);
+                }
+              }
+
+              t_result[(c * out_.height + y) * out_.width + x] = (pooling_->mode == primitives::Pooling::Mode::Max) ? best_ : acc_ * scale_;
+            }
+          }
+        }
+      }
+    }
+  } // namespace
+
+  InferenceModel::InferenceModel(std::size_t t_inputs, std::vector<Stage> t_stages, OutputFunction t_function, std::vector<std::string> t_labels,
+                                 computation::Approximation t_approximation)
+  : m_inputs(t_inputs), m_stages(std::move(t_stages)), m_function(t_function), m_labels(std::move(t_labels)), m_width(t_inputs),
+    m_approximation(t_approximation)
+  {
+    std::size_t width_ = m_inputs;
+    for(const auto& stage : m_stages) {
+      if(size(stage, false) != width_) {
+        throw std::out_of_range("stage input != previous stage output");
+      }
+      width_ = size(stage, true);
+      m_width = std::max(m_width, width_);
+    }
+
+    if(m_stages.empty() || width_ != m_labels.size()) {
+      throw std::out_of_range("labels.size() != output size");
+    }
+  }
+
+  InferenceModel::Activation InferenceModel::activation(const std::function<double(double)>& t_function)
+  {
+    if(!t_function) {
+      return Activation::Identity;
+    }
+
+    if(computation::approximation_of(t_function)) {
+      return Activation::Sigmoid;
+    }
+
+    if(const auto function_ = t_function.target<Function>()) {
+      if(*function_ == &computation::identity)    return Activation::Identity;
+      if(*function_ == &computation::sigmoid)     return Activation::Sigmoid;
+      if(*function_ == &computation::single_jump) return Activation::SingleJump;
+    }
+
+    throw NetworkError("activation function can't be frozen");
+  }
+
+  void InferenceModel::activate(Activation t_activation, double* t_values, std::size_t t_size) const noexcept
+  {
+    apply(t_activation, t_values, t_size, m_approximation);
+  }
+
+  void InferenceModel::forward(const double* t_input, double* t_output) const
+  {
+    forward(0, t_input, t_output);
+  }
+
+  void InferenceModel::forward(std::size_t t_stage, const double* t_values, double* t_output) const
+  {
+    // Scratch buffers of the calling thread, they only grow.
+    thread_local std::vector<double> values_;
+    thread_local std::vector<double> result_;
+    thread_local std::vector<double> columns_;
+
+    values_.resize(m_width);
+    result_.resize(m_width);
+    const std::size_t width_ = (t_stage == 0) ? m_inputs : size(m_stages[t_stage - 1], true);
+    std::copy(t_values, t_values + width_, values_.begin());
+
+    for(auto it = m_stages.begin() + static_cast<std::ptrdiff_t>(t_stage); it != m_stages.end(); ++it) {
+      calculate(*it, values_.data(), result_.data(), columns_, m_approximation);
+      values_.swap(result_);
+    }
+
+    if(m_function == OutputFunction::Softmax) {
+      computation::softmax(values_.data(), m_labels.size(), m_approximation);
+    }
+
+    std::copy(values_.begin(), values_.begin() + static_cast<std::ptrdiff_t>(m_labels.size()), t_output);
+  }
+
+  void InferenceModel::forwardBatch(std::size_t t_batch, const double* t_inputs, double* t_outputs) const
+  {
+    // Scratch buffers of the calling thread, they only grow.
+    thread_local std::vector<double> values_;
+    thread_local std::vector<double> result_;
+    thread_local std::vector<double> columns_;
+
+    values_.resize(t_batch * m_width);
+    result_.resize(t_batch * m_width);
+    std::copy(t_inputs, t_inputs + t_batch * m_inputs, values_.begin());
+
+    // Rows of a stage lie one after another with the width of the stage, a fully connected stage is one product for the batch.
+    std::size_t width_ = m_inputs;
+    for(const auto& stage : m_stages) {
+      const std::size_t outputs_ = size(stage, true);
+      if(const auto dense_ = std::get_if<Dense>(&stage)) {
+        computation::gemm(false, true, t_batch, dense_->outputs, dense_->inputs, 1.0, values_.data(), dense_->weights.data(),
+                          0.0, result_.data());
+        apply(dense_->activation, result_.data(), t_batch * dense_->outputs, m_approximation);
+      } else {
+        for(std::size_t b = 0; b < t_batch; ++b) {
+          calculate(stage, values_.data() + b * width_, result_.data() + b * outputs_, columns_, m_approximation);
+        }
+      }
+
+      values_.swap(result_);
+      width_ = outputs_;
+    }
+
+    for(std::size_t b = 0; b < t_batch; ++b) {
+      double* row_ = values_.data() + b * width_;
+      if(m_function == OutputFunction::Softmax) {
+        computation::softmax(row_, width_, m_approximation);
+      }
+      std::copy(row_, row_ + width_, t_outputs + b * width_);
+    }
+  }
+
+  void InferenceModel::fill(const cv::Mat& t_image, std::vector<double>& t_input) const
+  {
+    if(static_cast<std::size_t>(t_image.rows) * static_cast<std::size_t>(t_image.cols) > m_inputs) {
+      throw std::out_of_range("image is larger than the input layer");
+    }
+
+    // Same values as Network::fill().
+    t_input.assign(m_inputs, 0.0);
+    for(int r = 0; r < t_image.rows; ++r) {
+      for(int c = 0; c < t_image.cols; ++c) {
+        t_input[static_cast<std::size_t>(c + r * t_image.cols)] = static_cast<double>(t_image.at<unsigned char>(r, c)) / 255;
+      }
+    }
+  }
+
+  std::vector<Prediction> InferenceModel::perception(const cv::Mat& t_image, std::size_t t_top) const
+  {
+    thread_local std::vector<double> input_;
+    thread_local std::vector<double> output_;
+
+    fill(t_image, input_);
+    output_.resize(m_labels.size());
+    forward(input_.data(), output_.data());
+
+    return rank(output_.data(), t_top);
+  }
+
+  std::vector<Prediction> InferenceModel::rank(const double* t_output, std::size_t t_top) const
+  {
+    return network::rank(m_labels, t_output, t_top);
+  }
+
+  std::vector<Prediction> InferenceModel::perception(const std::string& t_data, std::size_t t_top) const
+  {
+    if(!boost::filesystem::exists(t_data)) {
+      return { };
+    }
+
+    const cv::Mat data_input_ = cv::imread(t_data);
+    if(data_input_.empty()) {
+      return { };
+    }
+
+    return perception(data_input_, t_top);
+  }
+
+  std::vector<LayerMemory> InferenceModel::memory() const
+  {
+    std::vector<LayerMemory> layers_ { };
+
+    MemoryUsage input_ { };
+    input_.overhead = sizeof(InferenceModel);
+    layers_.push_back({ "input", m_inputs, input_ });
+
+    std::size_t features_ { 0 }, hidden_ { 0 };
+    const std::size_t dense_ = static_cast<std::size_t>(std::count_if(m_stages.begin(), m_stages.end(), [](const auto& stage) {
+      return std::holds_alternative<Dense>(stage);
+    }));
+
+    for(const auto& stage : m_stages) {
+      LayerMemory layer_ { };
+      layer_.neurons = size(stage, true);
+      layer_.usage.overhead = sizeof(Stage);
+
+      if(const auto dense = std::get_if<Dense>(&stage)) {
+        layer_.layer = (hidden_ + 1 == dense_) ? std::string("output") : "hidden " + std::to_string(hidden_);
+        layer_.usage.weights = dense->weights.capacity() * sizeof(double);
+        ++hidden_;
+      } else {
+        layer_.layer = "feature " + std::to_string(features_++);
+        if(const auto convolution = std::get_if<Convolution>(&stage)) {
+          layer_.usage.weights = (convolution->weights.capacity() + convolution->bias.capacity()) * sizeof(double);
+        }
+      }
+
+      layers_.push_back(std::move(layer_));
+    }
+
+    auto& output_ = layers_.back().usage;
+    output_.overhead += m_labels.capacity() * sizeof(std::string);
+    for(const auto& label : m_labels) {
+      output_.overhead += label.capacity() > 15 ? label.capacity() + 1 : 0;
+    }
+
+    // Scratch buffers are per thread and not owned by the model, they hold two rows of values.
+    layers_.front().usage.activations = 2 * m_width * sizeof(double);
+    return layers_;
+  }
+} // namespace network
@@ -0,0 +1,29 @@
+#include "network_core/utility/Json.hpp"
+
+// STL
+#include <cstdio>
+
+namespace network {
+namespace utility {
+  std::string quote(const std::string& t_value)
+  {
+    std::string text_ { "\"" };
+    text_.reserve(t_value.size() + 2);
+
+    for(const char c : t_value) {
+      if(c == '"' || c == '\\') {
+        text_ += '\\';
+        text_ += c;
+      } else if(static_cast<unsigned char>(c) < 0x20) {
+        char escaped_[7] { };
+        std::snprintf(escaped_, sizeof(escaped_), "\\u%04x", static_cast<unsigned>(c));
+        text_ += escaped_;
+      } else {
+        text_ += c;
+      }
+    }
+
+    return text_ + "\"";
+  }
+} // namespace utility
+} // namespace network
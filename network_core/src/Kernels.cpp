@@ -0,0 +1,374 @@
+#include "network_core/utility/Kernels.hpp"
+
+// STL
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <random>
+
+// POSIX
+#include <unistd.h>
+
+namespace network {
+namespace computation {
+  namespace {
+    std::atomic<std::size_t> tile_gemv_ { 0 };
+    std::atomic<std::size_t> tile_m_    { 0 };
+    std::atomic<std::size_t> tile_n_    { 0 };
+    std::atomic<std::size_t> tile_k_    { 0 };
+    std::once_flag           derived_   { };
+
+    std::size_t cache(int t_name, std::size_t t_default) noexcept
+    {
+      const long size_ = sysconf(t_name);
+      return size_ > 0 ? static_cast<std::size_t>(size_) : t_default;
+    }
+
+    std::size_t floor2(std::size_t t_value) noexcept
+    {
+      std::size_t power_ { 1 };
+      while(power_ * 2 <= t_value) power_ *= 2;
+      return power_;
+    }
+
+    /**
+     * @brief Half of L1 holds the tile of x, the packed panel of op(B) fills half of L2 and op(A) a quarter of it.
+     */
+    Tiles derive() noexcept
+    {
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+      const std::size_t l1_ = cache(_SC_LEVEL1_DCACHE_SIZE, 32 * 1024);
+      const std::size_t l2_ = cache(_SC_LEVEL2_CACHE_SIZE, 256 * 1024);
+#else
+      const std::size_t l1_ = 32 * 1024;
+      const std::size_t l2_ = 256 * 1024;
+#endif
+
+      Tiles tiles_ { };
+      tiles_.gemv = std::max<std::size_t>(256, l1_ / 2 / sizeof(double) / 64 * 64);
+      tiles_.n    = 256;
+      tiles_.k    = std::clamp<std::size_t>(floor2(l2_ / 2 / sizeof(double) / tiles_.n), 32, 512);
+      tiles_.m    = std::clamp<std::size_t>(floor2(l2_ / 4 / sizeof(double) / tiles_.k), 16, 256);
+      return tiles_;
+    }
+
+    /**
+     * @brief Shortest of a few runs, in nanoseconds.
+     */
+    template<typename _Fn>
+      double measure(_Fn&& t_operation)
+      {
+        double best_ = std::numeric_limits<double>::max();
+        for(int r = 0; r < 3; ++r) {
+          const auto start_ = std::chrono::steady_clock::now();
+          t_operation();
+          best_ = std::min(best_, std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start_).count());
+        }
+        return best_;
+      }
+
+    /**
+     * @brief Rows of A against the columns [t_begin, t_begin + t_size) of x, added to y unless t_assign.
+     */
+    void gemvTile(std::size_t t_m, std::size_t t_n, const double* t_a, const double* t_x, double* t_y,
+                  std::size_t t_begin, std::size_t t_size, bool t_assign) noexcept
+    {
+      const double* x_ = t_x + t_begin;
+
+      // Four rows share every load of x, each row keeps its own chain of additions.
+      const std::size_t rows_ = t_m - t_m % 4;
+      for(std::size_t i = 0; i < rows_; i += 4) {
+        const double* a0_ = t_a + (i + 0) * t_n + t_begin;
+        const double* a1_ = t_a + (i + 1) * t_n + t_begin;
+        const double* a2_ = t_a + (i + 2) * t_n + t_begin;
+        const double* a3_ = t_a + (i + 3) * t_n + t_begin;
+
+        double s0_ { 0.0 }, s1_ { 0.0 }, s2_ { 0.0 }, s3_ { 0.0 };
+        for(std::size_t j = 0; j < t_size; ++j) {
+          const double xj_ = x_[j];
+          s0_ += a0_[j] * xj_;
+          s1_ += a1_[j] * xj_;
+          s2_ += a2_[j] * xj_;
+          s3_ += a3_[j] * xj_;
+        }
+
+        t_y[i + 0] = t_assign ? s0_ : t_y[i + 0] + s0_;
+        t_y[i + 1] = t_assign ? s1_ : t_y[i + 1] + s1_;
+        t_y[i + 2] = t_assign ? s2_ : t_y[i + 2] + s2_;
+        t_y[i + 3] = t_assign ? s3_ : t_y[i + 3] + s3_;
+      }
+
+      for(std::size_t i = rows_; i < t_m; ++i) {
+        const double* a_ = t_a + i * t_n + t_begin;
+        double s_ = t_assign ? 0.0 : t_y[i];
+        for(std::size_t j = 0; j < t_size; ++j) {
+          s_ += a_[j] * x_[j];
+        }
+        t_y[i] = s_;
+      }
+    }
+  } // namespace
+
+  Tiles tiles() noexcept
+  {
+    std::call_once(derived_, [] {
+      const Tiles tiles_ = derive();
+      tile_gemv_.store(tiles_.gemv, std::memory_order_relaxed);
+      tile_m_.store(tiles_.m, std::memory_order_relaxed);
+      tile_n_.store(tiles_.n, std::memory_order_relaxed);
+      tile_k_.store(tiles_.k, std::memory_order_relaxed);
+    });
+
+    return { tile_gemv_.load(std::memory_order_relaxed), tile_m_.load(std::memory_order_relaxed),
+             tile_n_.load(std::memory_order_relaxed), tile_k_.load(std::memory_order_relaxed) };
+  }
+
+  void setTiles(const Tiles& t_tiles) noexcept
+  {
+    tiles();
+    if(t_tiles.gemv) tile_gemv_.store(t_tiles.gemv, std::memory_order_relaxed);
+    if(t_tiles.m)    tile_m_.store(t_tiles.m, std::memory_order_relaxed);
+    if(t_tiles.n)    tile_n_.store(t_tiles.n, std::memory_order_relaxed);
+    if(t_tiles.k)    tile_k_.store(t_tiles.k, std::memory_order_relaxed);
+  }
+
+  Tiles tune()
+  {
+    const Tiles derived_tiles_ = derive();
+    Tiles best_ = derived_tiles_;
+
+    std::mt19937_64 random_ { 42 };
+    std::uniform_real_distribution<double> values_ { -1.0, 1.0 };
+    auto fill = [&](std::vector<double>& t_values) {
+      for(auto& value : t_values) value = values_(random_);
+    };
+
+    // A wide input layer with a few dozen neurons.
+    {
+      constexpr std::size_t m_ { 32 }, n_ { 16384 };
+      std::vector<double> a_(m_ * n_), x_(n_), y_(m_);
+      fill(a_);
+      fill(x_);
+
+      double fastest_ = std::numeric_limits<double>::max();
+      for(const std::size_t gemv : { derived_tiles_.gemv / 4, derived_tiles_.gemv / 2, derived_tiles_.gemv, derived_tiles_.gemv * 2, n_ }) {
+        setTiles({ gemv, 0, 0, 0 });
+        const double time_ = measure([&] { computation::gemv(m_, n_, a_.data(), x_.data(), y_.data()); });
+        if(time_ < fastest_) {
+          fastest_ = time_;
+          best_.gemv = gemv;
+        }
+      }
+    }
+
+    // A batch of the batched perception through a hidden layer.
+    {
+      constexpr std::size_t m_ { 32 }, n_ { 128 }, k_ { 1024 };
+      std::vector<double> a_(m_ * k_), b_(n_ * k_), c_(m_ * n_);
+      fill(a_);
+      fill(b_);
+
+      double fastest_ = std::numeric_limits<double>::max();
+      for(const std::size_t k : { 64, 128, 256, 512 }) {
+        for(const std::size_t n : { 128, 256, 512 }) {
+          setTiles({ 0, derived_tiles_.m, n, k });
+          const double time_ = measure([&] { computation::gemm(false, true, m_, n_, k_, 1.0, a_.data(), b_.data(), 0.0, c_.data()); });
+          if(time_ < fastest_) {
+            fastest_ = time_;
+            best_.n = n;
+            best_.k = k;
+          }
+        }
+      }
+    }
+
+    setTiles(best_);
+    return best_;
+  }
+
+  void gemm(bool t_trans_a, bool t_trans_b, std::size_t t_m, std::size_t t_n, std::size_t t_k,
+            double t_alpha, const double* t_a, const double* t_b, double t_beta, double* t_c) noexcept
+  {
+    if(t_beta != 1.0) {
+      for(std::size_t i = 0; i < t_m * t_n; ++i) {
+        t_c[i] = (t_beta == 0.0) ? 0.0 : t_c[i] * t_beta;
+      }
+    }
+
+    if(t_alpha == 0.0 || t_k == 0) {
+      return;
+    }
+
+    // Block sizes keep a packed panel of A and B inside L1/L2 while C rows are streamed.
+    const Tiles tiles_ = tiles();
+    const std::size_t block_m_ = tiles_.m;
+    const std::size_t block_n_ = tiles_.n;
+    const std::size_t block_k_ = tiles_.k;
+
+    thread_local std::vector<double> a_pack_;
+    thread_local std::vector<double> b_pack_;
+    a_pack_.resize(block_m_ * block_k_);
+    b_pack_.resize(block_k_ * block_n_);
+
+    for(std::size_t kk = 0; kk < t_k; kk += block_k_) {
+      const std::size_t kb = std::min(block_k_, t_k - kk);
+
+      for(std::size_t jj = 0; jj < t_n; jj += block_n_) {
+        const std::size_t nb = std::min(block_n_, t_n - jj);
+
+        // Pack op(B) panel (kb x nb) row-major.
+        for(std::size_t p = 0; p < kb; ++p) {
+          for(std::size_t j = 0; j < nb; ++j) {
+            b_pack_[p * nb + j] = t_trans_b ? t_b[(jj + j) * t_k + (kk + p)] : t_b[(kk + p) * t_n + (jj + j)];
+          }
+        }
+
+        for(std::size_t ii = 0; ii < t_m; ii += block_m_) {
+          const std::size_t mb = std::min(block_m_, t_m - ii);
+
+          // Pack op(A) panel (mb x kb) row-major and fold alpha into it.
+          for(std::size_t i = 0; i < mb; ++i) {
+            for(std::size_t p = 0; p < kb; ++p) {
+              a_pack_[i * kb + p] = t_alpha * (t_trans_a ? t_a[(kk + p) * t_m + (ii + i)] : t_a[(ii + i) * t_k + (kk + p)]);
+            }
+          }
+
+          for(std::size_t i = 0; i < mb; ++i) {
+            double* c_row_ = t_c + (ii + i) * t_n + jj;
+            for(std::size_t p = 0; p < kb; ++p) {
+              const double a_ip_ = a_pack_[i * kb + p];
+              const double* b_row_ = b_pack_.data() + p * nb;
+              for(std::size_t j = 0; j < nb; ++j) {
+                c_row_[j] += a_ip_ * b_row_[j];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void gemv(std::size_t t_m, std::size_t t_n, const double* t_a, const double* t_x, double* t_y) noexcept
+  {
+    // A wide x doesn't fit into L1, every tile of it passes all rows before the next one is loaded.
+    const std::size_t tile_ = std::max<std::size_t>(tiles().gemv, 1);
+    gemvTile(t_m, t_n, t_a, t_x, t_y, 0, std::min(tile_, t_n), true);
+    for(std::size_t jj = tile_; jj < t_n; jj += tile_) {
+      gemvTile(t_m, t_n, t_a, t_x, t_y, jj, std::min(tile_, t_n - jj), false);
+    }
+  }
+
+  void gemvt(std::size_t t_m, std::size_t t_n, std::size_t t_lda, const double* t_a, const double* t_x, double* t_y) noexcept
+  {
+    // Every row adds a multiple of itself to y, a wide y is updated one tile at a time.
+    const std::size_t tile_ = std::max<std::size_t>(tiles().gemv, 1);
+    for(std::size_t jj = 0; jj < t_n; jj += tile_) {
+      const std::size_t size_ = std::min(tile_, t_n - jj);
+      double* y_ = t_y + jj;
+
+      for(std::size_t i = 0; i < t_m; ++i) {
+        const double xi_ = t_x[i];
+        if(xi_ == 0.0) {
+          continue;
+        }
+
+        const double* a_ = t_a + i * t_lda + jj;
+        for(std::size_t j = 0; j < size_; ++j) {
+          y_[j] += a_[j] * xi_;
+        }
+      }
+    }
+  }
+
+  void ger(std::size_t t_m, std::size_t t_n, const double* t_x, const double* t_y, double* t_a) noexcept
+  {
+    // The rows read and write every weight once, the tile of y they share is loaded once for all of them.
+    const std::size_t tile_ = std::max<std::size_t>(tiles().gemv, 1);
+    for(std::size_t jj = 0; jj < t_n; jj += tile_) {
+      const std::size_t size_ = std::min(tile_, t_n - jj);
+      const double* y_ = t_y + jj;
+
+      for(std::size_t i = 0; i < t_m; ++i) {
+        const double xi_ = t_x[i];
+        if(xi_ == 0.0) {
+          continue;
+        }
+
+        double* a_ = t_a + i * t_n + jj;
+        for(std::size_t j = 0; j < size_; ++j) {
+          a_[j] += xi_ * y_[j];
+        }
+      }
+    }
+  }
+
+  void spmv(std::size_t t_m, const std::size_t* t_offsets, const std::uint32_t* t_columns, const double* t_values,
+            const double* t_x, double* t_y) noexcept
+  {
+    // Four independent sums hide the latency of the gathered loads of x.
+    for(std::size_t i = 0; i < t_m; ++i) {
+      const std::size_t end_ = t_offsets[i + 1];
+      std::size_t k = t_offsets[i];
+
+      double s0_ { 0.0 }, s1_ { 0.0 }, s2_ { 0.0 }, s3_ { 0.0 };
+      for(; k + 4 <= end_; k += 4) {
+        s0_ += t_values[k + 0] * t_x[t_columns[k + 0]];
+        s1_ += t_values[k + 1] * t_x[t_columns[k + 1]];
+        s2_ += t_values[k + 2] * t_x[t_columns[k + 2]];
+        s3_ += t_values[k + 3] * t_x[t_columns[k + 3]];
+      }
+
+      for(; k < end_; ++k) {
+        s0_ += t_values[k] * t_x[t_columns[k]];
+      }
+
+      t_y[i] = (s0_ + s1_) + (s2_ + s3_);
+    }
+  }
+
+  void im2col(const double* t_image, std::size_t t_channels, std::size_t t_height, std::size_t t_width,
+              std::size_t t_kernel, std::size_t t_stride, double* t_columns) noexcept
+  {
+    const std::size_t out_height_ = (t_height - t_kernel) / t_stride + 1;
+    const std::size_t out_width_  = (t_width  - t_kernel) / t_stride + 1;
+
+    for(std::size_t c = 0; c < t_channels; ++c) {
+      for(std::size_t ky = 0; ky < t_kernel; ++ky) {
+        for(std::size_t kx = 0; kx < t_kernel; ++kx) {
+          double* row_ = t_columns + ((c * t_kernel + ky) * t_kernel + kx) * out_height_ * out_width_;
+          for(std::size_t y = 0; y < out_height_; ++y) {
+            const double* src_ = t_image + (c * t_height + y * t_stride + ky) * t_width + kx;
+            for(std::size_t x = 0; x < out_width_; ++x) {
+              row_[y * out_width_ + x] = src_[x * t_stride];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void col2im(const double* t_columns, std::size_t t_channels, std::size_t t_height, std::size_t t_width,
+              std::size_t t_kernel, std::size_t t_stride, double* t_image) noexcept
+  {
+    const std::size_t out_height_ = (t_height - t_kernel) / t_stride + 1;
+    const std::size_t out_width_  = (t_width  - t_kernel) / t_stride + 1;
+
+    for(std::size_t c = 0; c < t_channels; ++c) {
+      for(std::size_t ky = 0; ky < t_kernel; ++ky) {
+        for(std::size_t kx = 0; kx < t_kernel; ++kx) {
+          const double* row_ = t_columns + ((c * t_kernel + ky) * t_kernel + kx) * out_height_ * out_width_;
+          for(std::size_t y = 0; y < out_height_; ++y) {
+            double* dst_ = t_image + (c * t_height + y * t_stride + ky) * t_width + kx;
+            for(std::size_t x = 0; x < out_width_; ++x) {
+              dst_[x * t_stride] += row_[y * out_width_ + x];
+            }
+          }
+        }
+      }
+    }
+  }
+} // namespace computation
+} // namespace network
@@ -0,0 +1,43 @@
+#include "network_core/ModelReplicas.hpp"
+#include "network_core/InferenceModel.hpp"
+#include "network_core/utility/Numa.hpp"
+
+// STL
+#include <new>
+#include <thread>
+
+namespace network {
+  ModelReplicas::ModelReplicas(const InferenceModelPtr& t_model)
+  : m_replicas(utility::numaNodes().size(), t_model)
+  {
+    if(m_replicas.size() < 2) {
+      return;
+    }
+
+    std::vector<std::thread> threads_ { };
+    for(std::size_t n = 0; n < m_replicas.size(); ++n) {
+      threads_.emplace_back([this, &t_model, n] {
+        // Without the binding the pages would come from wherever the thread happens to run.
+        if(!utility::pin(utility::numaNodes()[n].cpus.front())) {
+          return;
+        }
+
+        try {
+          m_replicas[n] = std::make_shared<const InferenceModel>(t_model->inputs(), t_model->stages(), t_model->function(),
+                                                                 t_model->labels(), t_model->approximation());
+        } catch(const std::bad_alloc&) {
+          // The node keeps the shared model.
+        }
+      });
+    }
+
+    for(auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  const InferenceModel& ModelReplicas::local() const noexcept
+  {
+    return *m_replicas[utility::numaNode()];
+  }
+} // namespace network
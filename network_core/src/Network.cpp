@@ -1,8 +1,52 @@
 #include "network_core/Network.hpp"
+#include "network_core/utility/Kernels.hpp"
+#include "network_core/InferenceModel.hpp"
+#include "network_core/ResultCache.hpp"
+#include "network_core/Dataset.hpp"
+
+// STL
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <cmath>
 
 namespace network {
-  Network::Network(const InputLayer& t_input, const HiddenLayer& t_hidden, const OutputLayer& t_output) 
-  : m_input_layer_(t_input), m_hidden_layer_(t_hidden), m_output_layer_(t_output)
+  namespace {
+    // Augmentation keys of learn() are apart from the keys of the epochs of education().
+    constexpr std::uint64_t ONLINE { std::uint64_t { 1 } << 63 };
+  } // namespace
+
+  std::vector<Prediction> rank(const std::vector<std::string>& t_labels, const double* t_scores, std::size_t t_top)
+  {
+    std::vector<Prediction> predictions { };
+    predictions.reserve(t_labels.size());
+    for(std::size_t i = 0; i < t_labels.size(); ++i) {
+      predictions.push_back({ t_labels[i], t_scores[i] });
+    }
+
+    const std::size_t top_ = (t_top == 0) ? predictions.size() : std::min(t_top, predictions.size());
+    std::partial_sort(predictions.begin(), predictions.begin() + static_cast<std::ptrdiff_t>(top_), predictions.end(), [](const auto& e, const auto& o) {
+      return e.probability > o.probability;
+    });
+    predictions.resize(top_);
+
+    return predictions;
+  }
+
+  Network::Network(const InputLayer& t_input, const HiddenLayer& t_hidden, const OutputLayer& t_output)
+  : Network(t_input, FeatureLayer(), t_hidden, t_output)
+  {
+  }
+
+  Network::Network(const InputLayer& t_input, const FeatureLayer& t_feature, const HiddenLayer& t_hidden, const OutputLayer& t_output)
+  : Network(t_input, t_feature, t_hidden, t_output, Graph())
+  {
+  }
+
+  Network::Network(const InputLayer& t_input, const FeatureLayer& t_feature, const HiddenLayer& t_hidden, const OutputLayer& t_output, const Graph& t_graph)
+  : m_input_layer_(t_input), m_feature_layer_(t_feature), m_hidden_layer_(t_hidden), m_output_layer_(t_output), m_graph(t_graph.inputs)
   {
     // Check for a specific combination Network. If not satisfied, the network will not work correctly.
     assert( is_single_layer<decltype(m_input_layer_)>::value);
@@ -14,39 +58,80 @@ namespace network {
       throw NotInitializeError("Not initialize layers in Network.");
     }
 
-    // Create link between back hidden layer and output layer.
-    if(auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers))) {
-      if(auto layers_hidden_ptr_ = std::get_if<HiddenLayer::LayerImpl>(&(*m_hidden_layer_.m_layers))) {
-        if(!layer_output_ptr_->get() || layers_hidden_ptr_->empty()) {
-          throw NotInitializeError("Not initialize output or hidden layer.");
-        }
+    auto layer_input_ptr_   = std::get_if<InputLayer::PrimitiveTPtr>(&(*m_input_layer_.m_layers));
+    auto layers_hidden_ptr_ = std::get_if<HiddenLayer::LayerImpl>(&(*m_hidden_layer_.m_layers));
+    auto layer_output_ptr_  = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+
+    if(!layer_input_ptr_ || !layer_input_ptr_->get() || !layer_output_ptr_ || !layer_output_ptr_->get()) {
+      throw NotInitializeError("Not initialize input or output layer.");
+    }
+
+    if(!layers_hidden_ptr_ || layers_hidden_ptr_->empty()) {
+      throw NotInitializeError("Not initialize hidden layer.");
+    }
+
+    const std::size_t size_hidden_layers_ = layers_hidden_ptr_->size();
 
-        (*layer_output_ptr_)->connect(layers_hidden_ptr_->back());
+    // Without a graph the layers form a chain: source -> hidden layers -> output layer.
+    if(m_graph.empty()) {
+      m_graph.push_back({ Graph::SOURCE });
+      for(std::size_t i = 1; i <= size_hidden_layers_; ++i) {
+        m_graph.push_back({ i - 1 });
       }
     }
 
-    // Create links between hidden layers.
-    if(auto layers_hidden_ptr_ = std::get_if<HiddenLayer::LayerImpl>(&(*m_hidden_layer_.m_layers))) {
-      if(layers_hidden_ptr_->empty() ) {
-        throw NotInitializeError("Not initialize hidden layer.");
+    if(m_graph.size() != size_hidden_layers_ + 1) {
+      throw NotInitializeError("Graph doesn't list the inputs of every hidden layer and the output layer.");
+    }
+
+    for(std::size_t l = 0; l < m_graph.size(); ++l) {
+      auto inputs_ = m_graph[l];
+      std::sort(inputs_.begin(), inputs_.end());
+
+      if(inputs_.empty() || std::adjacent_find(inputs_.begin(), inputs_.end()) != inputs_.end()) {
+        throw NotInitializeError("Layer of the graph has no inputs or the same input twice.");
       }
 
-      const std::size_t size_hidden_layers_ = layers_hidden_ptr_->size() - 1;
-      for(std::size_t i = 0; i < size_hidden_layers_; ++i) {
-        layers_hidden_ptr_->at(i+1)->connect(layers_hidden_ptr_->at(i));
+      if(std::any_of(inputs_.begin(), inputs_.end(), [l](const auto& e) { return e != Graph::SOURCE && e >= l; })) {
+        throw NotInitializeError("Graph isn't in topological order.");
       }
     }
 
-    // Create link between input layer and front hidden layer.
-    if(auto layer_input_ptr_ = std::get_if<InputLayer::PrimitiveTPtr>(&(*m_input_layer_.m_layers))) {
-      if(auto layers_hidden_ptr_ = std::get_if<HiddenLayer::LayerImpl>(&(*m_hidden_layer_.m_layers))) {
-        if(!layer_input_ptr_->get() || layers_hidden_ptr_->empty()) {
-          throw NotInitializeError("Not initialize input or hidden layer.");
-        }
+    // Create links through the feature layers: input -> convolution/pooling -> source of the graph.
+    if(!m_feature_layer_.empty()) {
+      if(m_feature_layer_.m_layers.front()->input().size() != (*layer_input_ptr_)->size()) {
+        throw NotInitializeError("Feature layer input doesn't match the input layer size.");
+      }
+
+      m_feature_values_.resize(m_feature_layer_.m_layers.size() + 1);
+      m_feature_errors_.resize(m_feature_layer_.m_layers.size() + 1);
 
-        layers_hidden_ptr_->front()->connect(*layer_input_ptr_);
+      m_feature_output_ = std::make_shared<primitives::Layer<primitives::Neuron>>(m_feature_layer_.m_layers.back()->output().size());
+    }
+
+    // Create links of the hidden and output layers, a layer becomes ready one level after its last input.
+    std::vector<std::size_t> levels_(size_hidden_layers_, 0);
+    m_consumers.assign(size_hidden_layers_ + 1, { });
+
+    for(std::size_t l = 0; l < m_graph.size(); ++l) {
+      std::size_t level_ { 0 };
+      for(const auto& input : m_graph[l]) {
+        node(l)->connect(*node(input));
+        m_consumers[input == Graph::SOURCE ? size_hidden_layers_ : input].push_back(node(l));
+        level_ = std::max(level_, input == Graph::SOURCE ? 0 : levels_[input] + 1);
+      }
+
+      if(l < size_hidden_layers_) {
+        levels_[l] = level_;
+        if(m_levels.size() <= level_) {
+          m_levels.resize(level_ + 1);
+        }
+        m_levels[level_].push_back(l);
       }
     }
+
+    m_nodes.resize(m_graph.size());
+    std::iota(m_nodes.begin(), m_nodes.end(), 0);
   }
 
   void Network::setDataset(const std::string& t_dataset) noexcept
@@ -54,6 +139,11 @@ namespace network {
     m_dataset = t_dataset;
   }
 
+  void Network::setDataset(const DatasetPtr& t_dataset) noexcept
+  {
+    m_decoded = t_dataset;
+  }
+
   void Network::setCategorys(const std::vector<std::string>& t_categorys) noexcept
   {
     m_categorys.clear();
@@ -66,34 +156,203 @@ namespace network {
     return m_categorys;
   }
 
+  void Network::setLabels(const std::vector<std::string>& t_labels)
+  {
+    auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+
+    if(t_labels.size() != (*layer_output_ptr_)->size()) {
+      throw std::out_of_range("labels.size() != output layer size");
+    }
+
+    m_labels = t_labels;
+
+    // Predictions cached under the old labels carry the old categories.
+    ++m_revision;
+
+    // perception() without top reads the category of the neurons.
+    std::size_t index_ { 0 };
+    for(auto it = (*layer_output_ptr_)->begin(); it != (*layer_output_ptr_)->end(); ++it, ++index_) {
+      if((*it)->getCategory().empty()) {
+        (*it)->setCategory(m_labels[index_]);
+      }
+    }
+  }
+
+  const std::vector<std::string>& Network::getLabels() const noexcept
+  {
+    return m_labels;
+  }
+
+  void Network::setOutputFunction(const OutputFunction& t_function) noexcept
+  {
+    m_output_function = t_function;
+
+    // Softmax normalizes the weighted sums of the whole layer, the neurons only pass them through.
+    if(auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers))) {
+      (*layer_output_ptr_)->setActivationFunction(m_output_function == OutputFunction::Softmax ? computation::identity : computation::sigmoid_of(m_approximation));
+    }
+
+    ++m_revision;
+  }
+
+  OutputFunction Network::getOutputFunction() const noexcept
+  {
+    return m_output_function;
+  }
+
+  void Network::setApproximation(const computation::Approximation& t_approximation) noexcept
+  {
+    m_approximation = t_approximation;
+
+    // Only layers of sigmoids change, the output layer of a softmax passes the sums through.
+    for(std::size_t l = 0; l < m_graph.size(); ++l) {
+      auto* layer_ = node(l);
+      if(layer_->size() && computation::approximation_of((*layer_->begin())->getActivationFunction())) {
+        layer_->setActivationFunction(computation::sigmoid_of(m_approximation));
+      }
+    }
+
+    ++m_revision;
+  }
+
+  computation::Approximation Network::getApproximation() const noexcept
+  {
+    return m_approximation;
+  }
+
+  void Network::setLogSink(const LogSinkPtr& t_sink) noexcept
+  {
+    m_log_sink = t_sink;
+  }
+
+  void Network::setEducationControl(const EducationControlPtr& t_control) noexcept
+  {
+    m_control = t_control;
+  }
+
+  void Network::setCache(const ResultCachePtr& t_cache) noexcept
+  {
+    m_cache = t_cache;
+  }
+
+  const ResultCachePtr& Network::getCache() const noexcept
+  {
+    return m_cache;
+  }
+
+  void Network::setImagePool(const ImagePoolPtr& t_images) noexcept
+  {
+    m_images = t_images;
+  }
+
+  const ImagePoolPtr& Network::getImagePool() const noexcept
+  {
+    return m_images;
+  }
+
+  void Network::setThreadPool(const utility::ThreadPoolPtr& t_pool) noexcept
+  {
+    m_thread_pool = t_pool;
+  }
+
+  const utility::ThreadPoolPtr& Network::getThreadPool() const noexcept
+  {
+    return m_thread_pool;
+  }
+
+  void Network::setPruning(const Pruning& t_pruning) noexcept
+  {
+    m_pruning = t_pruning;
+  }
+
+  const Pruning& Network::getPruning() const noexcept
+  {
+    return m_pruning;
+  }
+
+  std::size_t Network::prune(const double& t_sparsity, bool t_global)
+  {
+    std::vector<primitives::Layer<primitives::Neuron>*> layers_ { };
+    for(std::size_t l = 0; l < m_graph.size(); ++l) {
+      layers_.push_back(node(l));
+    }
+
+    const double sparsity_ = std::clamp(t_sparsity, 0.0, 1.0);
+
+    // Threshold that removes the missing share of the weights of the given layers.
+    auto threshold = [sparsity_](const auto& t_layers) {
+      std::vector<double> magnitudes_ { };
+      std::size_t possible_ { 0 };
+      for(const auto& layer : t_layers) {
+        layer->magnitudes(magnitudes_);
+        possible_ += layer->size() * layer->inputs();
+      }
+
+      const auto keep_ = static_cast<std::size_t>(std::llround((1.0 - sparsity_) * static_cast<double>(possible_)));
+      if(magnitudes_.size() <= keep_) {
+        return 0.0;
+      }
+
+      const std::size_t remove_ = magnitudes_.size() - keep_;
+      std::nth_element(magnitudes_.begin(), magnitudes_.begin() + static_cast<std::ptrdiff_t>(remove_), magnitudes_.end());
+      return remove_ < magnitudes_.size() ? magnitudes_[remove_] : std::numeric_limits<double>::infinity();
+    };
+
+    std::size_t removed_ { 0 };
+    if(t_global) {
+      const double threshold_ = threshold(layers_);
+      for(const auto& layer : layers_) {
+        removed_ += layer->prune(threshold_);
+      }
+    } else {
+      for(const auto& layer : layers_) {
+        const decltype(layers_) layer_ { layer };
+        removed_ += layer->prune(threshold(layer_));
+      }
+    }
+
+    ++m_revision;
+    return removed_;
+  }
+
   void Network::setEpoch(const std::size_t& t_epoch) noexcept
   {
     m_epoch.emplace(t_epoch);
   }
 
+  void Network::setLearningRate(const double& t_rate) noexcept
+  {
+    m_learning_rate = t_rate;
+  }
+
+  double Network::getLearningRate() const noexcept
+  {
+    return m_learning_rate;
+  }
+
   bool Network::education()
   {
     bool status { true };
 
-    if(m_dataset.empty()) {
+    if(!m_decoded && m_dataset.empty()) {
       throw FolderNotFoundError("Could not find dataset folder " + m_dataset);
       return (status = false);
     }
 
-    if(!fs::exists(fs::path(m_dataset))) {
+    if(!m_decoded && !fs::exists(fs::path(m_dataset))) {
       throw FolderNotFoundError("Could not find dataset folder " + m_dataset);
       return (status = false);
     }
 
-    if(!m_epoch || m_categorys.empty()) {
+    if(!m_epoch || (!m_decoded && m_categorys.empty())) {
       throw NotInitializeError("Network isn't initialize.");
       return (status = false);
     }
 
     auto buffer = std::make_unique<std::unordered_map<std::string, std::vector<std::string>>>();
 
-    // Save image paths to buffer.
-    for (fs::recursive_directory_iterator it(m_dataset), end; it != end; ++it) {
+    // Save image paths to buffer, decoded images don't need it.
+    for (auto it = m_decoded ? fs::recursive_directory_iterator() : fs::recursive_directory_iterator(m_dataset), end = fs::recursive_directory_iterator(); it != end; ++it) {
       // Folder is a category.
       if(!boost::filesystem::is_regular_file(it->path())) {
         // Check that it is among our filters.
@@ -126,78 +385,228 @@ namespace network {
     }
 
     // Get pointers on layers
-    auto layer_input_ptr_   = std::get_if<InputLayer::PrimitiveTPtr>(&(*m_input_layer_.m_layers));
-    auto layers_hidden_ptr_ = std::get_if<HiddenLayer::LayerImpl>(&(*m_hidden_layer_.m_layers));
     auto layer_output_ptr_  = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
 
-    if(buffer->size() != (*layer_output_ptr_)->size()) {
+    if((m_decoded ? m_decoded->categorys().size() : buffer->size()) != (*layer_output_ptr_)->size()) {
       throw std::out_of_range("");
       return (status = false);
     }
 
     // Set category for output layer
-    for(auto&& row : *buffer | boost::adaptors::indexed(0)) {
-      auto&& [category, collage] = row.value();
-      (*layer_output_ptr_)->setCategory(static_cast<std::size_t>(row.index()), category);
+    m_labels.clear();
+    if(m_decoded) {
+      m_labels = m_decoded->categorys();
+    } else {
+      for(auto&& row : *buffer | boost::adaptors::indexed(0)) {
+        m_labels.push_back(row.value().first);
+      }
+    }
+
+    for(std::size_t l = 0; l < m_labels.size(); ++l) {
+      (*layer_output_ptr_)->setCategory(l, m_labels[l]);
     }
 
     // Education
     for(std::size_t i = 0 ; i < (*m_epoch); ++i) {
-      for(auto&& [category, collage] : *buffer) {
-        for(auto& image : collage) {
-          // Get image.
-          cv::Mat data_input_ = cv::imread(m_dataset + '/' + category + '/' + image);
-
-          // Check valid image.
-          if(data_input_.empty()) { continue; }
-          if(data_input_.type() != CV_8UC3) { /* TODO: convert */ }
-
-          // Supply values to the input layer
-          for(int r = 0; r < data_input_.rows; ++r) {
-            for(int c = 0; c < data_input_.cols; ++c) {
-              (*layer_input_ptr_)->set(static_cast<std::size_t>(c+(r*data_input_.cols)),
-              static_cast<double>(data_input_.at<unsigned char>(r,c))/255);
-            }
-          }
+      const auto epoch_start_ = std::chrono::steady_clock::now();
+      EpochRecord record_ { };
+      profiling::Profiler* const profiler_ = m_profiler.get();
 
-          // Direct distribution Network
-          {
-            for(const auto& layer : *layers_hidden_ptr_) {
-              layer.get()->calculate();
-            }
+      const auto proceed = [&](bool t_end) {
+        if(!m_control) {
+          return true;
+        }
 
-            (*layer_output_ptr_)->calculate();
-          }
+        const double seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch_start_).count();
+        const double samples_ = static_cast<double>(record_.samples);
+        return m_control->proceed(EducationProgress { i, *m_epoch, record_.samples, record_.samples ? record_.loss / samples_ : 0.0,
+                                                      seconds_ > 0.0 ? samples_ / seconds_ : 0.0, t_end });
+      };
 
-          // Back distribution Network
-          {
-            // For output layer
-            (*layer_output_ptr_)->update(category);
+      // Samples of an epoch are keyed by the epoch and their position.
+      std::uint64_t key_ = static_cast<std::uint64_t>(i) << 32;
 
-            // For hidden layer
-            layers_hidden_ptr_->back()->update(*(*layer_output_ptr_));
+      if(m_decoded) {
+        for(const auto& [image, label] : m_decoded->samples()) {
+          {
+            NETWORK_STATISTICS_SCOPE(collector(), Mode::Education);
+            educate(image, label, key_++, i == 0, record_, profiler_);
+          }
 
-            const std::size_t size_hidden_layers_ = layers_hidden_ptr_->size() - 1;
-            for(std::size_t j = size_hidden_layers_; j != 0; --j) {
-              layers_hidden_ptr_->at(j-1)->update(*layers_hidden_ptr_->at(j));
-            }
+          report();
+          if(!proceed(false)) {
+            return (status = false);
           }
+        }
+      }
 
-          // Update weight
+      for(auto&& row : *buffer | boost::adaptors::indexed(0)) {
+        auto&& [category, collage] = row.value();
+        const auto label_ = static_cast<std::size_t>(row.index());
+
+        for(auto& image : collage) {
           {
-            for(const auto& layer : *layers_hidden_ptr_) {
-              layer.get()->updateWeight();
+            NETWORK_STATISTICS_SCOPE(collector(), Mode::Education);
+
+            // Get image.
+            ImagePool::Image decoded_ { };
+            {
+              NETWORK_STATISTICS_SCOPE(collector(), Mode::Education, Phase::Decode);
+              profiling::Scope scope_(profiler_, region(Phase::Decode));
+              m_path.assign(m_dataset).append(1, '/').append(category).append(1, '/').append(image);
+              decoded_ = read(m_path);
             }
+            const cv::Mat& data_input_ = decoded_.mat;
+
+            // Check valid image.
+            if(data_input_.empty()) { continue; }
+            if(data_input_.type() != CV_8UC3) { /* TODO: convert */ }
 
-            (*layer_output_ptr_)->updateWeight();
+            educate(data_input_, label_, key_++, i == 0, record_, profiler_);
+          }
+
+          report();
+          if(!proceed(false)) {
+            return (status = false);
           }
         }
       }
+
+      // Every pruning step is followed by the remaining epochs, which fine-tune the weights that are kept.
+      if(m_pruning.sparsity > 0.0 && i < m_pruning.steps) {
+        const std::size_t steps_ = std::min(m_pruning.steps, *m_epoch);
+        prune(m_pruning.sparsity * static_cast<double>(i + 1) / static_cast<double>(steps_), m_pruning.global);
+      }
+
+      // Asked before the record is averaged, the epoch is logged even if the education stops after it.
+      const bool proceed_ = proceed(true);
+
+      if(m_log_sink) {
+        record_.epoch         = i;
+        record_.loss          = record_.samples ? record_.loss / static_cast<double>(record_.samples) : 0.0;
+        record_.accuracy      = record_.samples ? record_.accuracy / static_cast<double>(record_.samples) : 0.0;
+        record_.seconds       = std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch_start_).count();
+        record_.learning_rate = m_learning_rate;
+        record_.timestamp     = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count();
+        m_log_sink->push(record_);
+      }
+
+      if(!proceed_) {
+        return (status = false);
+      }
     }
 
     return status;
   }
 
+  void Network::educate(const cv::Mat& t_image, const std::size_t& t_label, std::uint64_t t_key, bool t_first, EpochRecord& t_record,
+                        profiling::Profiler* t_profiler)
+  {
+    const double loss_ = step(t_image, t_label, t_key, t_profiler);
+
+    if(m_log_sink || m_control) {
+      t_record.loss     += loss_;
+      t_record.accuracy += (predict() == t_label) ? 1.0 : 0.0;
+      ++t_record.samples;
+    }
+
+    // The first epoch sees every sample once, later learn() calls rehearse them.
+    if(t_first) {
+      remember(t_image, t_label);
+    }
+  }
+
+  void Network::setReplay(const Replay& t_replay)
+  {
+    m_replay = t_replay;
+    if(m_replay_buffer.size() > m_replay.capacity) {
+      m_replay_buffer.resize(m_replay.capacity);
+    }
+  }
+
+  const Replay& Network::getReplay() const noexcept
+  {
+    return m_replay;
+  }
+
+  void Network::setOutputSampling(const OutputSampling& t_sampling) noexcept
+  {
+    m_output_sampling = t_sampling;
+  }
+
+  const OutputSampling& Network::getOutputSampling() const noexcept
+  {
+    return m_output_sampling;
+  }
+
+  void Network::setAugmentation(const Augmentation& t_augmentation) noexcept
+  {
+    m_augmentation = t_augmentation;
+  }
+
+  const Augmentation& Network::getAugmentation() const noexcept
+  {
+    return m_augmentation;
+  }
+
+  double Network::learn(const cv::Mat& t_image, const std::string& t_category)
+  {
+    return learn(t_image, label(t_category));
+  }
+
+  double Network::learn(const cv::Mat& t_image, std::size_t t_label)
+  {
+    auto layer_input_ptr_  = std::get_if<InputLayer::PrimitiveTPtr>(&(*m_input_layer_.m_layers));
+    auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+    if(static_cast<std::size_t>(t_image.rows) * static_cast<std::size_t>(t_image.cols) > (*layer_input_ptr_)->size()) {
+      throw std::out_of_range("image is larger than the input layer");
+    }
+    if(t_label >= (*layer_output_ptr_)->size()) {
+      throw std::out_of_range("label " + std::to_string(t_label) + " isn't an output neuron");
+    }
+
+    NETWORK_STATISTICS_SCOPE(collector(), Mode::Education);
+
+    const double loss_ = step(t_image, t_label, ONLINE | m_learned++);
+
+    if(!m_replay_buffer.empty()) {
+      std::uniform_int_distribution<std::size_t> index_(0, m_replay_buffer.size() - 1);
+      for(std::size_t r = 0; r < m_replay.replayed; ++r) {
+        const auto& [image, index] = m_replay_buffer[index_(m_random)];
+        step(image, index, ONLINE | m_learned++);
+      }
+    }
+
+    remember(t_image, t_label);
+    return loss_;
+  }
+
+  double Network::learn(const std::string& t_data, const std::string& t_category)
+  {
+    ImagePool::Image decoded_ { };
+    {
+      NETWORK_STATISTICS_SCOPE(collector(), Mode::Education, Phase::Decode);
+      decoded_ = read(t_data);
+    }
+
+    if(decoded_.mat.empty()) {
+      throw FileNotFoundError("Could not read image " + t_data);
+    }
+
+    return learn(decoded_.mat, t_category);
+  }
+
+  double Network::learn(const std::vector<Sample>& t_samples)
+  {
+    double loss_ { 0.0 };
+    for(const auto& sample : t_samples) {
+      loss_ += sample.image.empty() ? learn(sample.path, sample.category) : learn(sample.image, sample.category);
+    }
+
+    return t_samples.empty() ? 0.0 : loss_ / static_cast<double>(t_samples.size());
+  }
+
   std::vector<std::string> Network::perception(const std::string& t_data)
   {
     std::vector<std::string> category {};
@@ -206,33 +615,29 @@ namespace network {
       return category;
     }
 
+    NETWORK_STATISTICS_SCOPE(collector(), Mode::Perception);
+
     // TODO: Check on correct image.
-    cv::Mat data_input_ = cv::imread(t_data);
+    ImagePool::Image decoded_ { };
+    {
+      NETWORK_STATISTICS_SCOPE(collector(), Mode::Perception, Phase::Decode);
+      decoded_ = read(t_data);
+    }
+    const cv::Mat& data_input_ = decoded_.mat;
 
     // Check valid image.
     if(!data_input_.empty()) {
       if(data_input_.type() != CV_8UC3) { /* TODO: convert */ }
 
-      // Get pointers on layers
-      auto layer_input_ptr_   = std::get_if<InputLayer::PrimitiveTPtr>(&(*m_input_layer_.m_layers));
-      auto layers_hidden_ptr_ = std::get_if<HiddenLayer::LayerImpl>(&(*m_hidden_layer_.m_layers));
-      auto layer_output_ptr_  = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+      auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
 
-      // Supply values to the input layer
-      for(int r = 0; r < data_input_.rows; ++r) {
-        for(int c = 0; c < data_input_.cols; ++c) {
-          (*layer_input_ptr_)->set(static_cast<std::size_t>(c+(r*data_input_.cols)),
-          static_cast<double>(data_input_.at<unsigned char>(r,c))/255);
-        }
+      {
+        NETWORK_STATISTICS_SCOPE(collector(), Mode::Perception, Phase::Fill);
+        fill(data_input_);
       }
-
-      // Direct distribution Network
       {
-        for(const auto& layer : *layers_hidden_ptr_) {
-          layer.get()->calculate();
-        }
-
-        (*layer_output_ptr_)->calculate();
+        NETWORK_STATISTICS_SCOPE(collector(), Mode::Perception, Phase::Forward);
+        forward();
       }
 
       auto max_output_it = std::max_element((*layer_output_ptr_)->begin(), (*layer_output_ptr_)->end(), [](auto&e, auto& o) {
@@ -251,4 +656,777 @@ namespace network {
 
     return category;
   }
-} // namespace network
\ No newline at end of file
+
+  std::vector<Prediction> Network::perception(const std::string& t_data, const std::size_t& t_top)
+  {
+    std::vector<Prediction> predictions {};
+
+    if(!boost::filesystem::exists(t_data)) {
+      return predictions;
+    }
+
+    NETWORK_STATISTICS_SCOPE(collector(), Mode::Perception);
+
+    std::optional<ResultCache::Key> key_ { };
+    ImagePool::Image decoded_ { };
+    {
+      NETWORK_STATISTICS_SCOPE(collector(), Mode::Perception, Phase::Decode);
+      if(m_cache) {
+        // Identical files are recognized by their bytes, a hit skips decoding as well.
+        thread_local std::vector<unsigned char> bytes_ { };
+        ImagePool::load(t_data, bytes_);
+
+        key_ = ResultCache::hash(bytes_.data(), bytes_.size());
+        if(auto cached_ = m_cache->find(*key_, t_top, m_revision)) {
+          return std::move(*cached_);
+        }
+        decoded_ = m_images ? m_images->decode(bytes_) : ImagePool::Image { { }, cv::imdecode(bytes_, cv::IMREAD_COLOR) };
+      } else {
+        decoded_ = read(t_data);
+      }
+    }
+    const cv::Mat& data_input_ = decoded_.mat;
+
+    if(data_input_.empty()) {
+      return predictions;
+    }
+
+    auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+
+    {
+      NETWORK_STATISTICS_SCOPE(collector(), Mode::Perception, Phase::Fill);
+      fill(data_input_);
+    }
+    {
+      NETWORK_STATISTICS_SCOPE(collector(), Mode::Perception, Phase::Forward);
+      forward();
+    }
+
+    std::vector<double> scores_ { };
+    scores_.reserve((*layer_output_ptr_)->size());
+    for(auto it = (*layer_output_ptr_)->begin(); it != (*layer_output_ptr_)->end(); ++it) {
+      scores_.push_back((*it)->getOutputValue());
+    }
+
+    predictions = rank(outputLabels(), scores_.data(), t_top);
+
+    if(key_) {
+      m_cache->insert(*key_, t_top, m_revision, predictions);
+    }
+
+    return predictions;
+  }
+
+  std::vector<std::vector<Prediction>> Network::perception(const std::vector<cv::Mat>& t_batch, const std::size_t& t_top)
+  {
+    if(!m_cache) {
+      return compute(t_batch, t_top);
+    }
+
+    std::vector<std::vector<Prediction>> predictions(t_batch.size());
+    std::vector<ResultCache::Key> keys_(t_batch.size());
+    std::vector<std::size_t> missed_ { };
+    std::vector<cv::Mat> images_ { };
+
+    for(std::size_t b = 0; b < t_batch.size(); ++b) {
+      keys_[b] = ResultCache::hash(t_batch[b]);
+      if(auto cached_ = m_cache->find(keys_[b], t_top, m_revision)) {
+        predictions[b] = std::move(*cached_);
+      } else {
+        missed_.push_back(b);
+        images_.push_back(t_batch[b]);
+      }
+    }
+
+    if(!images_.empty()) {
+      auto computed_ = compute(images_, t_top);
+      for(std::size_t i = 0; i < missed_.size(); ++i) {
+        m_cache->insert(keys_[missed_[i]], t_top, m_revision, computed_[i]);
+        predictions[missed_[i]] = std::move(computed_[i]);
+      }
+    }
+
+    return predictions;
+  }
+
+  std::vector<std::string> Network::outputLabels() const
+  {
+    auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+    if(m_labels.size() == (*layer_output_ptr_)->size()) {
+      return m_labels;
+    }
+
+    std::vector<std::string> labels_((*layer_output_ptr_)->size());
+    std::size_t index_ { 0 };
+    for(auto it = (*layer_output_ptr_)->begin(); it != (*layer_output_ptr_)->end(); ++it, ++index_) {
+      if(!(*it)->getCategory().empty()) {
+        labels_[index_] = (*it)->getCategory().front();
+      }
+    }
+    return labels_;
+  }
+
+  std::vector<std::vector<Prediction>> Network::compute(const std::vector<cv::Mat>& t_batch, const std::size_t& t_top)
+  {
+    std::vector<std::vector<Prediction>> predictions { };
+
+    if(t_batch.empty()) {
+      return predictions;
+    }
+
+    auto layer_input_ptr_  = std::get_if<InputLayer::PrimitiveTPtr>(&(*m_input_layer_.m_layers));
+    auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+
+    pack();
+
+    const std::size_t batch_  = t_batch.size();
+    const std::size_t inputs_ = (*layer_input_ptr_)->size();
+
+    {
+      NETWORK_STATISTICS_SCOPE(collector(), Mode::Perception, Phase::Fill);
+
+      // Same values as fill(), one row per image.
+      m_batch_values.assign(batch_ * inputs_, 0.0);
+      for(std::size_t b = 0; b < batch_; ++b) {
+        const auto& image_ = t_batch[b];
+        if(static_cast<std::size_t>(image_.rows) * static_cast<std::size_t>(image_.cols) > inputs_) {
+          throw std::out_of_range("image is larger than the input layer");
+        }
+
+        double* row_ = m_batch_values.data() + b * inputs_;
+        for(int r = 0; r < image_.rows; ++r) {
+          for(int c = 0; c < image_.cols; ++c) {
+            row_[c + r * image_.cols] = static_cast<double>(image_.at<unsigned char>(r, c)) / 255;
+          }
+        }
+      }
+    }
+
+    {
+      NETWORK_STATISTICS_SCOPE(collector(), Mode::Perception, Phase::Forward);
+
+      // Spatial layers keep their buffers per sample, only the fully connected layers are batched.
+      std::size_t width_ = inputs_;
+      if(!m_feature_layer_.empty()) {
+        const std::size_t features_ = m_feature_layer_.m_layers.back()->output().size();
+        m_batch_outputs.resize(batch_ * features_);
+
+        for(std::size_t b = 0; b < batch_; ++b) {
+          m_feature_values_.front().assign(m_batch_values.begin() + b * inputs_, m_batch_values.begin() + (b + 1) * inputs_);
+          for(std::size_t i = 0; i < m_feature_layer_.m_layers.size(); ++i) {
+            m_feature_layer_.m_layers[i]->calculate(m_feature_values_[i], m_feature_values_[i+1]);
+          }
+          std::copy(m_feature_values_.back().begin(), m_feature_values_.back().end(), m_batch_outputs.begin() + b * features_);
+        }
+
+        m_batch_values.swap(m_batch_outputs);
+        width_ = features_;
+      }
+
+      // A layer connected to several layers sums one product per connection.
+      m_batch_layers.resize(m_graph.size());
+      auto calculate = [this, batch_](std::size_t t_layer) {
+        auto& outputs_ = m_batch_layers[t_layer];
+        const std::size_t size_ = node(t_layer)->size();
+        outputs_.resize(batch_ * size_);
+
+        for(std::size_t i = 0; i < m_graph[t_layer].size(); ++i) {
+          const std::size_t input_ = m_graph[t_layer][i];
+          const std::size_t connection_ = m_packed.offsets[t_layer] + i;
+          const double* values_ = (input_ == Graph::SOURCE) ? m_batch_values.data() : m_batch_layers[input_].data();
+
+          computation::gemm(false, true, batch_, size_, m_packed.inputs[connection_], 1.0, values_, m_packed.weights[connection_].data(),
+                            i == 0 ? 0.0 : 1.0, outputs_.data());
+        }
+
+        if(const auto approximation_ = computation::approximation_of(m_packed.activations[t_layer])) {
+          computation::vsigmoid(outputs_.data(), outputs_.data(), outputs_.size(), *approximation_);
+        } else if(const auto& function_ = m_packed.activations[t_layer]) {
+          for(auto& value : outputs_) {
+            value = function_(value);
+          }
+        }
+      };
+
+      for(const auto& level : m_levels) {
+        schedule(level, calculate);
+      }
+      calculate(m_graph.size() - 1);
+
+      width_ = node(m_graph.size() - 1)->size();
+      if(m_output_function == OutputFunction::Softmax) {
+        for(std::size_t b = 0; b < batch_; ++b) {
+          computation::softmax(m_batch_layers.back().data() + b * width_, width_, m_approximation);
+        }
+      }
+    }
+
+    const std::size_t outputs_ = (*layer_output_ptr_)->size();
+
+    const std::vector<std::string> labels_ = outputLabels();
+
+    predictions.reserve(batch_);
+    for(std::size_t b = 0; b < batch_; ++b) {
+      predictions.push_back(rank(labels_, m_batch_layers.back().data() + b * outputs_, t_top));
+    }
+
+    return predictions;
+  }
+
+  std::vector<double> Network::parameters()
+  {
+    std::vector<double> parameters_ { };
+
+    for(const auto& feature : m_feature_layer_.m_layers) {
+      const std::size_t offset_ = parameters_.size();
+      parameters_.resize(offset_ + feature->size());
+      feature->parameters(parameters_.data() + offset_);
+    }
+
+    for(const auto& [layer, inputs] : connections()) {
+      const std::size_t offset_ = parameters_.size();
+      parameters_.resize(offset_ + layer->size() * inputs->size());
+      layer->weights(*inputs, parameters_.data() + offset_);
+    }
+
+    return parameters_;
+  }
+
+  void Network::setParameters(const std::vector<double>& t_parameters)
+  {
+    const auto connections_ = connections();
+
+    std::size_t size_ { 0 };
+    for(const auto& feature : m_feature_layer_.m_layers) {
+      size_ += feature->size();
+    }
+    for(const auto& [layer, inputs] : connections_) {
+      size_ += layer->size() * inputs->size();
+    }
+
+    if(t_parameters.size() != size_) {
+      throw std::out_of_range("parameters.size() != " + std::to_string(size_));
+    }
+
+    const double* data_ = t_parameters.data();
+    for(const auto& feature : m_feature_layer_.m_layers) {
+      feature->setParameters(data_);
+      data_ += feature->size();
+    }
+
+    for(const auto& [layer, inputs] : connections_) {
+      layer->setWeights(*inputs, data_);
+      data_ += layer->size() * inputs->size();
+    }
+
+    ++m_revision;
+  }
+
+  InferenceModelPtr Network::freeze()
+  {
+    auto layer_input_ptr_ = std::get_if<InputLayer::PrimitiveTPtr>(&(*m_input_layer_.m_layers));
+
+    // The stages of the model follow each other, branches would need the outputs of earlier stages.
+    for(std::size_t l = 0; l < m_graph.size(); ++l) {
+      if(m_graph[l] != std::vector<std::size_t>{ l == 0 ? Graph::SOURCE : l - 1 }) {
+        throw NetworkError("graph topologies can't be frozen");
+      }
+    }
+
+    std::vector<InferenceModel::Stage> stages_ { };
+
+    for(const auto& feature : m_feature_layer_.m_layers) {
+      if(const auto convolution_ = dynamic_cast<const primitives::Convolution*>(feature.get())) {
+        std::vector<double> parameters_(convolution_->size());
+        convolution_->parameters(parameters_.data());
+
+        // Parameters keep the filters first and one bias per filter after them.
+        const std::size_t filters_ = convolution_->output().channels;
+        InferenceModel::Convolution stage_ { };
+        stage_.input      = convolution_->input();
+        stage_.output     = convolution_->output();
+        stage_.kernel     = convolution_->kernel();
+        stage_.stride     = convolution_->stride();
+        stage_.weights.assign(parameters_.begin(), parameters_.end() - static_cast<std::ptrdiff_t>(filters_));
+        stage_.bias.assign(parameters_.end() - static_cast<std::ptrdiff_t>(filters_), parameters_.end());
+        stage_.activation = InferenceModel::activation(convolution_->activation());
+        stages_.emplace_back(std::move(stage_));
+      } else if(const auto pooling_ = dynamic_cast<const primitives::Pooling*>(feature.get())) {
+        stages_.emplace_back(InferenceModel::Pooling { pooling_->input(), pooling_->output(), pooling_->window(), pooling_->mode() });
+      } else {
+        throw NetworkError("feature layer can't be frozen");
+      }
+    }
+
+    for(const auto& [layer, inputs] : connections()) {
+      InferenceModel::Dense stage_ { };
+      stage_.inputs  = inputs->size();
+      stage_.outputs = layer->size();
+      stage_.weights.resize(stage_.outputs * stage_.inputs);
+      layer->weights(*inputs, stage_.weights.data());
+
+      // All neurons of a layer share the activation function.
+      stage_.activation = layer->size() ? InferenceModel::activation((*layer->begin())->getActivationFunction()) : InferenceModel::Activation::Identity;
+      stages_.emplace_back(std::move(stage_));
+    }
+
+    std::vector<std::string> labels_ = outputLabels();
+
+    return std::make_shared<const InferenceModel>((*layer_input_ptr_)->size(), std::move(stages_), m_output_function, std::move(labels_), m_approximation);
+  }
+
+  std::vector<LayerMemory> Network::memory() const
+  {
+    std::vector<LayerMemory> layers_ { };
+
+    if(!m_input_layer_.m_layers || !m_hidden_layer_.m_layers || !m_output_layer_.m_layers) {
+      return layers_;
+    }
+
+    if(auto layer_input_ptr_ = std::get_if<InputLayer::PrimitiveTPtr>(&(*m_input_layer_.m_layers))) {
+      layers_.push_back({ "input", (*layer_input_ptr_)->size(), (*layer_input_ptr_)->memory() });
+    }
+
+    for(std::size_t i = 0; i < m_feature_layer_.m_layers.size(); ++i) {
+      const auto& feature_ = m_feature_layer_.m_layers[i];
+
+      LayerMemory layer_ { "feature " + std::to_string(i), feature_->output().size(), feature_->memory() };
+      layer_.usage.activations += m_feature_values_[i+1].capacity() * sizeof(primitives::Feature::TypeValueFeature);
+      layer_.usage.gradients   += m_feature_errors_[i].capacity() * sizeof(primitives::Feature::TypeValueFeature);
+      layers_.push_back(std::move(layer_));
+    }
+
+    if(m_feature_output_) {
+      layers_.push_back({ "feature output", m_feature_output_->size(), m_feature_output_->memory() });
+    }
+
+    if(auto layers_hidden_ptr_ = std::get_if<HiddenLayer::LayerImpl>(&(*m_hidden_layer_.m_layers))) {
+      for(std::size_t i = 0; i < layers_hidden_ptr_->size(); ++i) {
+        layers_.push_back({ "hidden " + std::to_string(i), layers_hidden_ptr_->at(i)->size(), layers_hidden_ptr_->at(i)->memory() });
+      }
+    }
+
+    if(auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers))) {
+      layers_.push_back({ "output", (*layer_output_ptr_)->size(), (*layer_output_ptr_)->memory() });
+    }
+
+    return layers_;
+  }
+
+  Statistics Network::statistics() const
+  {
+    return m_statistics ? m_statistics->snapshot() : Statistics();
+  }
+
+  void Network::resetStatistics() noexcept
+  {
+    m_statistics_samples = 0;
+    if(m_statistics) {
+      m_statistics->reset();
+    }
+  }
+
+  void Network::setStatisticsInterval(const std::size_t& t_samples) noexcept
+  {
+    m_statistics_interval = t_samples;
+  }
+
+  void Network::setProfiler(const profiling::ProfilerPtr& t_profiler)
+  {
+    static const std::array<const char*, Statistics::PHASES> phases_ { { "decode", "fill", "forward", "backward", "update" } };
+
+    m_profiler = t_profiler;
+    if(!m_profiler) {
+      return;
+    }
+
+    std::vector<std::string> layers_ { };
+    for(std::size_t i = 0; i < m_feature_layer_.m_layers.size(); ++i) {
+      layers_.push_back("feature " + std::to_string(i));
+    }
+    if(auto layers_hidden_ptr_ = std::get_if<HiddenLayer::LayerImpl>(&(*m_hidden_layer_.m_layers))) {
+      for(std::size_t i = 0; i < layers_hidden_ptr_->size(); ++i) {
+        layers_.push_back("hidden " + std::to_string(i));
+      }
+    }
+    layers_.push_back("output");
+
+    for(std::size_t p = 0; p < Statistics::PHASES; ++p) {
+      m_profile_phases[p] = m_profiler->region(std::string("education/") + phases_[p]);
+    }
+
+    // Layers take part only in the phases that compute on them.
+    for(const auto phase : { Phase::Forward, Phase::Backward, Phase::Update }) {
+      auto& regions_ = m_profile_layers[static_cast<std::size_t>(phase)];
+      regions_.clear();
+      for(const auto& layer : layers_) {
+        regions_.push_back(m_profiler->region(std::string(phases_[static_cast<std::size_t>(phase)]) + "/" + layer));
+      }
+    }
+  }
+
+  std::size_t Network::region(Phase t_phase, std::size_t t_layer) const noexcept
+  {
+    const auto phase_ = static_cast<std::size_t>(t_phase);
+    if(t_layer == std::numeric_limits<std::size_t>::max()) {
+      return m_profile_phases[phase_];
+    }
+
+    const auto& regions_ = m_profile_layers[phase_];
+    return t_layer < regions_.size() ? regions_[t_layer] : 0;
+  }
+
+  statistics::Collector* Network::collector()
+  {
+#ifdef NETWORK_STATISTICS
+    if(!m_statistics) {
+      m_statistics = std::make_shared<statistics::Collector>();
+    }
+#endif
+    return m_statistics.get();
+  }
+
+  void Network::report()
+  {
+#ifdef NETWORK_STATISTICS
+    if(m_statistics_interval != 0 && ++m_statistics_samples % m_statistics_interval == 0) {
+      std::cout << "\x1b[32m[INFO] " << statistics() << "\x1b[0m" << std::endl;
+    }
+#endif
+  }
+
+  double Network::loss(const std::size_t& t_label)
+  {
+    auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+
+    double loss_ { 0.0 };
+    std::size_t index_ { 0 };
+    for(auto it = (*layer_output_ptr_)->begin(); it != (*layer_output_ptr_)->end(); ++it, ++index_) {
+      const double output_ = (*it)->getOutputValue();
+
+      if(m_output_function == OutputFunction::Softmax) {
+        // Cross-entropy, only the expected category contributes.
+        if(index_ == t_label) {
+          loss_ = -std::log(std::max(output_, 1e-12));
+        }
+      } else {
+        const double error_ = ((index_ == t_label) ? 1.0 : 0.0) - output_;
+        loss_ += 0.5 * error_ * error_;
+      }
+    }
+
+    return loss_;
+  }
+
+  double Network::step(const cv::Mat& t_image, const std::size_t& t_label, std::uint64_t t_key, profiling::Profiler* t_profiler)
+  {
+    {
+      NETWORK_STATISTICS_SCOPE(collector(), Mode::Education, Phase::Fill);
+      profiling::Scope scope_(t_profiler, region(Phase::Fill));
+      if(m_augmentation.enabled()) {
+        augment(t_image, t_key);
+      } else {
+        fill(t_image);
+      }
+    }
+    {
+      NETWORK_STATISTICS_SCOPE(collector(), Mode::Education, Phase::Forward);
+      profiling::Scope scope_(t_profiler, region(Phase::Forward));
+      forward(t_profiler);
+    }
+
+    const double loss_ = loss(t_label);
+
+    {
+      NETWORK_STATISTICS_SCOPE(collector(), Mode::Education, Phase::Backward);
+      profiling::Scope scope_(t_profiler, region(Phase::Backward));
+      backward(t_label, t_profiler);
+    }
+    {
+      NETWORK_STATISTICS_SCOPE(collector(), Mode::Education, Phase::Update);
+      profiling::Scope scope_(t_profiler, region(Phase::Update));
+      updateWeight(t_profiler);
+    }
+
+    return loss_;
+  }
+
+  std::size_t Network::label(const std::string& t_category)
+  {
+    if(const auto it_ = std::find(m_labels.begin(), m_labels.end(), t_category); it_ != m_labels.end()) {
+      return static_cast<std::size_t>(std::distance(m_labels.begin(), it_));
+    }
+
+    auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+
+    std::size_t index_ { 0 };
+    for(auto it = (*layer_output_ptr_)->begin(); it != (*layer_output_ptr_)->end(); ++it, ++index_) {
+      const auto& categorys_ = (*it)->getCategory();
+      if(std::find(categorys_.begin(), categorys_.end(), t_category) != categorys_.end()) {
+        return index_;
+      }
+    }
+
+    throw std::out_of_range("unknown category " + t_category);
+  }
+
+  void Network::sample(std::size_t t_label)
+  {
+    auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+
+    // The gaps between the kept small outputs are geometric, a draw is made per kept output only.
+    const double rate_ = m_output_sampling.rate;
+    std::size_t skip_ = rate_ > 0.0 ? std::geometric_distribution<std::size_t>(rate_)(m_random) : std::numeric_limits<std::size_t>::max();
+
+    std::size_t index_ { 0 };
+    for(auto it = (*layer_output_ptr_)->begin(); it != (*layer_output_ptr_)->end(); ++it, ++index_) {
+      const double error_ = (*it)->getError();
+      if(index_ == t_label || std::abs(error_) >= m_output_sampling.threshold) {
+        continue;
+      }
+
+      if(skip_ == 0) {
+        (*it)->computeError(error_ / rate_);
+        skip_ = std::geometric_distribution<std::size_t>(rate_)(m_random);
+      } else {
+        (*it)->computeError(0.0);
+        --skip_;
+      }
+    }
+  }
+
+  void Network::remember(const cv::Mat& t_image, const std::size_t& t_label)
+  {
+    if(m_replay.capacity == 0) {
+      return;
+    }
+
+    // Reservoir sampling keeps a uniform random subset of all samples seen so far.
+    ++m_replay_seen;
+    if(m_replay_buffer.size() < m_replay.capacity) {
+      m_replay_buffer.emplace_back(t_image.clone(), t_label);
+    } else if(const auto index_ = std::uniform_int_distribution<std::size_t>(0, m_replay_seen - 1)(m_random); index_ < m_replay.capacity) {
+      m_replay_buffer[index_] = { t_image.clone(), t_label };
+    }
+  }
+
+  std::size_t Network::predict()
+  {
+    auto layer_output_ptr_ = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+
+    auto max_output_it = std::max_element((*layer_output_ptr_)->begin(), (*layer_output_ptr_)->end(), [](auto& e, auto& o) {
+      return e->getOutputValue() < o->getOutputValue();
+    });
+
+    return static_cast<std::size_t>(std::distance((*layer_output_ptr_)->begin(), max_output_it));
+  }
+
+  ImagePool::Image Network::read(const std::string& t_path)
+  {
+    return m_images ? m_images->read(t_path) : ImagePool::Image { { }, cv::imread(t_path) };
+  }
+
+  void Network::fill(const cv::Mat& t_image)
+  {
+    auto layer_input_ptr_ = std::get_if<InputLayer::PrimitiveTPtr>(&(*m_input_layer_.m_layers));
+
+    // Supply values to the input layer
+    for(int r = 0; r < t_image.rows; ++r) {
+      for(int c = 0; c < t_image.cols; ++c) {
+        (*layer_input_ptr_)->set(static_cast<std::size_t>(c+(r*t_image.cols)),
+        static_cast<double>(t_image.at<unsigned char>(r,c))/255);
+      }
+    }
+  }
+
+  void Network::augment(const cv::Mat& t_image, std::uint64_t t_key)
+  {
+    auto layer_input_ptr_ = std::get_if<InputLayer::PrimitiveTPtr>(&(*m_input_layer_.m_layers));
+
+    const auto rows_ = static_cast<std::size_t>(t_image.rows);
+    const auto cols_ = static_cast<std::size_t>(t_image.cols);
+    m_augmented.resize(rows_ * cols_);
+    network::augment(m_augmentation, t_key, t_image.data, rows_, cols_, t_image.step, m_augmented.data());
+
+    for(std::size_t i = 0; i < m_augmented.size(); ++i) {
+      (*layer_input_ptr_)->set(i, m_augmented[i]);
+    }
+  }
+
+  std::vector<std::pair<primitives::Layer<primitives::Neuron>*, primitives::Layer<primitives::Neuron>*>> Network::connections()
+  {
+    std::vector<std::pair<primitives::Layer<primitives::Neuron>*, primitives::Layer<primitives::Neuron>*>> connections_ { };
+
+    for(std::size_t l = 0; l < m_graph.size(); ++l) {
+      for(const auto& input : m_graph[l]) {
+        connections_.emplace_back(node(l), node(input));
+      }
+    }
+
+    return connections_;
+  }
+
+  primitives::Layer<primitives::Neuron>* Network::node(std::size_t t_index)
+  {
+    if(t_index == Graph::SOURCE) {
+      if(m_feature_output_) {
+        return m_feature_output_.get();
+      }
+      return std::get_if<InputLayer::PrimitiveTPtr>(&(*m_input_layer_.m_layers))->get();
+    }
+
+    auto layers_hidden_ptr_ = std::get_if<HiddenLayer::LayerImpl>(&(*m_hidden_layer_.m_layers));
+    if(t_index < layers_hidden_ptr_->size()) {
+      return layers_hidden_ptr_->at(t_index).get();
+    }
+
+    return std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers))->get();
+  }
+
+  void Network::dispatch(const std::vector<std::size_t>& t_layers, const std::function<void(std::size_t)>& t_task)
+  {
+    if(m_thread_pool && t_layers.size() > 1) {
+      m_thread_pool->run(t_layers.size(), [&t_layers, &t_task](std::size_t i) { t_task(t_layers[i]); });
+      return;
+    }
+
+    for(const auto& layer : t_layers) {
+      t_task(layer);
+    }
+  }
+
+  void Network::pack()
+  {
+    if(m_packed.revision == m_revision) {
+      return;
+    }
+
+    m_packed.weights.clear();
+    m_packed.inputs.clear();
+    m_packed.offsets.clear();
+    m_packed.activations.clear();
+
+    for(std::size_t l = 0; l < m_graph.size(); ++l) {
+      auto* layer_ = node(l);
+      m_packed.offsets.push_back(m_packed.weights.size());
+
+      for(const auto& input : m_graph[l]) {
+        auto* inputs_ = node(input);
+        m_packed.weights.emplace_back(layer_->size() * inputs_->size());
+        m_packed.inputs.push_back(inputs_->size());
+        layer_->weights(*inputs_, m_packed.weights.back().data());
+      }
+
+      // All neurons of a layer share the activation function.
+      m_packed.activations.push_back(layer_->size() ? (*layer_->begin())->getActivationFunction() : std::function<double(double)>());
+    }
+
+    m_packed.revision = m_revision;
+  }
+
+  void Network::forward(profiling::Profiler* t_profiler)
+  {
+    auto layers_hidden_ptr_ = std::get_if<HiddenLayer::LayerImpl>(&(*m_hidden_layer_.m_layers));
+    auto layer_output_ptr_  = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+
+    // Spatial layers work on whole feature maps, their result is handed over to the neurons of the bridge layer.
+    if(!m_feature_layer_.empty()) {
+      auto layer_input_ptr_ = std::get_if<InputLayer::PrimitiveTPtr>(&(*m_input_layer_.m_layers));
+
+      auto& values_ = m_feature_values_.front();
+      values_.resize((*layer_input_ptr_)->size());
+      std::transform((*layer_input_ptr_)->begin(), (*layer_input_ptr_)->end(), values_.begin(), [](const auto& neuron) {
+        return neuron->getOutputValue();
+      });
+
+      for(std::size_t i = 0; i < m_feature_layer_.m_layers.size(); ++i) {
+        profiling::Scope scope_(t_profiler, region(Phase::Forward, i));
+        m_feature_layer_.m_layers[i]->calculate(m_feature_values_[i], m_feature_values_[i+1]);
+      }
+
+      const auto& result_ = m_feature_values_.back();
+      for(std::size_t i = 0; i < result_.size(); ++i) {
+        m_feature_output_->set(i, result_[i]);
+      }
+    }
+
+    // Counters of the profiler belong to the calling thread, layers of a shared level aren't attributed.
+    const std::size_t features_ = m_feature_layer_.m_layers.size();
+    for(const auto& level : m_levels) {
+      auto* profiler_ = (m_thread_pool && level.size() > 1) ? nullptr : t_profiler;
+      schedule(level, [&](std::size_t t_layer) {
+        profiling::Scope scope_(profiler_, region(Phase::Forward, features_ + t_layer));
+        layers_hidden_ptr_->at(t_layer)->calculate();
+      });
+    }
+
+    {
+      profiling::Scope scope_(t_profiler, region(Phase::Forward, features_ + layers_hidden_ptr_->size()));
+      (*layer_output_ptr_)->calculate();
+
+      if(m_output_function == OutputFunction::Softmax) {
+        (*layer_output_ptr_)->softmax(m_approximation);
+      }
+    }
+  }
+
+  void Network::backward(const std::size_t& t_label, profiling::Profiler* t_profiler)
+  {
+    auto layers_hidden_ptr_ = std::get_if<HiddenLayer::LayerImpl>(&(*m_hidden_layer_.m_layers));
+    auto layer_output_ptr_  = std::get_if<OutputLayer::PrimitiveTPtr>(&(*m_output_layer_.m_layers));
+    const std::size_t features_ = m_feature_layer_.m_layers.size();
+
+    // For output layer
+    {
+      profiling::Scope scope_(t_profiler, region(Phase::Backward, features_ + layers_hidden_ptr_->size()));
+      (*layer_output_ptr_)->update(t_label);
+      if(m_output_sampling.enabled()) {
+        sample(t_label);
+      }
+    }
+
+    // For hidden layers, every layer of a level is connected only to later levels and the output layer.
+    for(auto level = m_levels.rbegin(); level != m_levels.rend(); ++level) {
+      auto* profiler_ = (m_thread_pool && level->size() > 1) ? nullptr : t_profiler;
+      schedule(*level, [&](std::size_t t_layer) {
+        profiling::Scope scope_(profiler_, region(Phase::Backward, features_ + t_layer));
+        layers_hidden_ptr_->at(t_layer)->update(m_consumers[t_layer]);
+      });
+    }
+
+    // For feature layers
+    if(!m_feature_layer_.empty()) {
+      m_feature_output_->update(m_consumers.back());
+
+      auto& errors_ = m_feature_errors_.back();
+      errors_.resize(m_feature_output_->size());
+      std::transform(m_feature_output_->begin(), m_feature_output_->end(), errors_.begin(), [](const auto& neuron) {
+        return neuron->getError();
+      });
+
+      for(std::size_t i = m_feature_layer_.m_layers.size(); i != 0; --i) {
+        profiling::Scope scope_(t_profiler, region(Phase::Backward, i - 1));
+        m_feature_layer_.m_layers[i-1]->update(m_feature_values_[i-1], m_feature_values_[i], m_feature_errors_[i], m_feature_errors_[i-1]);
+      }
+    }
+  }
+
+  void Network::updateWeight(profiling::Profiler* t_profiler)
+  {
+    ++m_revision;
+
+    const std::size_t features_ = m_feature_layer_.m_layers.size();
+
+    for(std::size_t i = 0; i < features_; ++i) {
+      profiling::Scope scope_(t_profiler, region(Phase::Update, i));
+      m_feature_layer_.m_layers[i]->updateWeight(m_learning_rate);
+    }
+
+    // Weights of a layer depend only on its own errors and its inputs, all layers update together.
+    auto* profiler_ = m_thread_pool ? nullptr : t_profiler;
+    schedule(m_nodes, [&](std::size_t t_layer) {
+      profiling::Scope scope_(profiler_, region(Phase::Update, features_ + t_layer));
+      node(t_layer)->updateWeight(m_learning_rate);
+    });
+  }
+} // namespace network
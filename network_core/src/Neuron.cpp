@@ -14,6 +14,36 @@ namespace network {
       return m_synapses.size();
     }
 
+    MemoryUsage Neuron::memory() const noexcept
+    {
+      MemoryUsage usage_ = estimate(m_synapses.size());
+
+      usage_.overhead += m_category.capacity() * sizeof(TypeValueCategory::value_type);
+      for(const auto& category : m_category) {
+        // Short categories are stored inside the string object itself.
+        const auto object_ = reinterpret_cast<const char*>(&category);
+        if(category.data() < object_ || category.data() >= object_ + sizeof(category)) {
+          usage_.overhead += category.capacity() + 1;
+        }
+      }
+
+      return usage_;
+    }
+
+    MemoryUsage Neuron::estimate(const std::size_t& t_synapses) noexcept
+    {
+      // A node of the red-black tree keeps a color and three links besides the value.
+      constexpr std::size_t node_ = sizeof(TypeSynapses::value_type) + 4 * sizeof(void*);
+      // std::make_shared places the neuron next to a control block with two counters and a vtable.
+      constexpr std::size_t control_block_ = 2 * sizeof(long) + sizeof(void*);
+
+      MemoryUsage usage_ { };
+      usage_.weights     = t_synapses * sizeof(TypeValueNeuron);
+      usage_.activations = 2 * sizeof(TypeValueNeuron);
+      usage_.overhead    = sizeof(Neuron) - usage_.activations + control_block_ + t_synapses * (node_ - sizeof(TypeValueNeuron));
+      return usage_;
+    }
+
     Neuron::TypeValueNeuron Neuron::getError() const noexcept
     {
       return m_error;
@@ -48,18 +78,33 @@ namespace network {
       }
     }
 
-    void Neuron::computeWeights() noexcept
+    void Neuron::computeWeights(const TypeValueNeuron& t_rate) noexcept
     {
+      // Without an error the step is zero, outputs left out by the sampling of large label sets end here.
+      if(!m_active_func || m_error == 0.0) {
+        return;
+      }
+
+      const TypeValueNeuron gradient_ = computeGradient(t_rate);
       for(auto&& synapse : m_synapses) {
         auto&& [neuron, weight] = synapse;
 
-        if(neuron && m_active_func) {
-          weight = weight + (Constants::LEARNING_RATE_DEFAULT * m_error * neuron->getOutputValue()
-                * computation::differential(std::bind(m_active_func, std::placeholders::_1), m_output));
+        if(neuron) {
+          weight = weight + gradient_ * neuron->getOutputValue();
         }
       }
     }
 
+    Neuron::TypeValueNeuron Neuron::computeGradient(const TypeValueNeuron& t_rate) const noexcept
+    {
+      if(!m_active_func || m_error == 0.0) {
+        return 0.0;
+      }
+
+      // The derivative depends only on the output of the neuron, it is the same for every synapse
+      return t_rate * m_error * computation::differential(m_active_func, m_output);
+    }
+
     std::optional<Neuron::TypeValueNeuron> Neuron::getWeight(const NeuronPtr& t_neuron) noexcept
     {
       std::optional<Neuron::TypeValueNeuron> result;
@@ -68,9 +113,7 @@ namespace network {
         return result;
       }
 
-      auto it = std::find_if(m_synapses.begin(), m_synapses.end(), [&](auto& e) {
-        return t_neuron == e.first;
-      });
+      auto it = m_synapses.find(t_neuron);
 
       if(it != m_synapses.end()) {
         result = it->second;
@@ -79,11 +122,44 @@ namespace network {
       return result;
     }
 
+    bool Neuron::setWeight(const NeuronPtr& t_neuron, const Neuron::TypeValueNeuron& t_weight) noexcept
+    {
+      auto it = m_synapses.find(t_neuron);
+
+      if(it == m_synapses.end()) {
+        return false;
+      }
+
+      it->second = t_weight;
+      return true;
+    }
+
+    std::size_t Neuron::prune(const Neuron::TypeValueNeuron& t_threshold) noexcept
+    {
+      const std::size_t size_ = m_synapses.size();
+
+      for(auto it = m_synapses.begin(); it != m_synapses.end();) {
+        it = (std::abs(it->second) < t_threshold) ? m_synapses.erase(it) : std::next(it);
+      }
+
+      return size_ - m_synapses.size();
+    }
+
+    const Neuron::TypeSynapses& Neuron::getSynapses() const noexcept
+    {
+      return m_synapses;
+    }
+
     void Neuron::setActivationFunction(std::function<double(double)> t_func) noexcept
     {
       m_active_func = t_func;
     }
 
+    const std::function<double(double)>& Neuron::getActivationFunction() const noexcept
+    {
+      return m_active_func;
+    }
+
     bool Neuron::operator ==(const Neuron& t_neuron) noexcept
     {
       return (this == &t_neuron);
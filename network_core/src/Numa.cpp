@@ -0,0 +1,150 @@
+#include "network_core/utility/Numa.hpp"
+
+// STL
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Boost
+#include <boost/filesystem.hpp>
+
+// POSIX
+#include <pthread.h>
+#include <sched.h>
+
+namespace network {
+namespace utility {
+  namespace {
+    namespace fs = boost::filesystem;
+
+    /**
+     * @brief CPUs of a sysfs list such as "0-3,8-11"
+     */
+    std::vector<std::size_t> parseCpus(const std::string& t_list)
+    {
+      std::vector<std::size_t> cpus_ { };
+      std::stringstream stream_(t_list);
+      std::string range_ { };
+
+      while(std::getline(stream_, range_, ',')) {
+        if(range_.find_first_of("0123456789") == std::string::npos) {
+          continue;
+        }
+
+        const auto dash_ = range_.find('-');
+        const std::size_t first_ = std::stoul(range_.substr(0, dash_));
+        const std::size_t last_  = dash_ == std::string::npos ? first_ : std::stoul(range_.substr(dash_ + 1));
+        for(std::size_t cpu = first_; cpu <= last_; ++cpu) {
+          cpus_.push_back(cpu);
+        }
+      }
+
+      return cpus_;
+    }
+
+    std::vector<std::size_t> allowedCpus()
+    {
+      std::vector<std::size_t> cpus_ { };
+
+      cpu_set_t set_;
+      CPU_ZERO(&set_);
+      if(sched_getaffinity(0, sizeof(set_), &set_) == 0) {
+        for(std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+          if(CPU_ISSET(cpu, &set_)) cpus_.push_back(cpu);
+        }
+      }
+
+      if(cpus_.empty()) {
+        for(std::size_t cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu) cpus_.push_back(cpu);
+      }
+
+      return cpus_;
+    }
+
+    std::vector<NumaNode> readNodes()
+    {
+      const auto allowed_ = allowedCpus();
+      std::vector<NumaNode> nodes_ { };
+
+      const fs::path root_ { "/sys/devices/system/node" };
+      boost::system::error_code error_;
+      if(fs::is_directory(root_, error_)) {
+        for(fs::directory_iterator it(root_, error_), end; !error_ && it != end; it.increment(error_)) {
+          const std::string name_ = it->path().filename().string();
+          if(name_.compare(0, 4, "node") != 0 || name_.size() == 4 || !std::all_of(name_.begin() + 4, name_.end(), ::isdigit)) {
+            continue;
+          }
+
+          std::ifstream list_((it->path() / "cpulist").string());
+          std::string line_ { };
+          std::getline(list_, line_);
+
+          NumaNode node_ { std::stoul(name_.substr(4)), { } };
+          for(const auto cpu : parseCpus(line_)) {
+            if(std::binary_search(allowed_.begin(), allowed_.end(), cpu)) node_.cpus.push_back(cpu);
+          }
+
+          if(!node_.cpus.empty()) {
+            nodes_.push_back(std::move(node_));
+          }
+        }
+      }
+
+      if(nodes_.empty()) {
+        nodes_.push_back(NumaNode { 0, allowed_ });
+      }
+
+      std::sort(nodes_.begin(), nodes_.end(), [](const auto& t_a, const auto& t_b) { return t_a.id < t_b.id; });
+      return nodes_;
+    }
+  } // namespace
+
+  const std::vector<NumaNode>& numaNodes()
+  {
+    static const std::vector<NumaNode> nodes_ = readNodes();
+    return nodes_;
+  }
+
+  std::vector<std::size_t> placement(std::size_t t_workers)
+  {
+    const auto& nodes_ = numaNodes();
+    std::vector<std::size_t> cpus_(t_workers);
+    for(std::size_t w = 0; w < t_workers; ++w) {
+      const auto& node_ = nodes_[w % nodes_.size()];
+      cpus_[w] = node_.cpus[(w / nodes_.size()) % node_.cpus.size()];
+    }
+    return cpus_;
+  }
+
+  bool pin(std::size_t t_cpu) noexcept
+  {
+    if(t_cpu >= CPU_SETSIZE) {
+      return false;
+    }
+
+    cpu_set_t set_;
+    CPU_ZERO(&set_);
+    CPU_SET(t_cpu, &set_);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set_), &set_) == 0;
+  }
+
+  std::size_t numaNodeOf(std::size_t t_cpu) noexcept
+  {
+    const auto& nodes_ = numaNodes();
+    for(std::size_t n = 0; n < nodes_.size(); ++n) {
+      if(std::binary_search(nodes_[n].cpus.begin(), nodes_[n].cpus.end(), t_cpu)) {
+        return n;
+      }
+    }
+    return 0;
+  }
+
+  std::size_t numaNode() noexcept
+  {
+    const int cpu_ = sched_getcpu();
+    return cpu_ < 0 ? 0 : numaNodeOf(static_cast<std::size_t>(cpu_));
+  }
+} // namespace utility
+} // namespace network
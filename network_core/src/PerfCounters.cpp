@@ -0,0 +1,230 @@
+#include "network_core/utility/PerfCounters.hpp"
+
+// STL
+#include <iomanip>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace network {
+namespace profiling {
+  namespace {
+    double ratio(std::uint64_t t_numerator, std::uint64_t t_denominator) noexcept
+    {
+      return t_denominator ? static_cast<double>(t_numerator) / static_cast<double>(t_denominator) : 0.0;
+    }
+  } // namespace
+
+  double Counters::ipc() const noexcept
+  {
+    return ratio((*this)[Event::Instructions], (*this)[Event::Cycles]);
+  }
+
+  double Counters::cacheMissRate() const noexcept
+  {
+    return ratio((*this)[Event::CacheMisses], (*this)[Event::CacheReferences]);
+  }
+
+  double Counters::branchMissRate() const noexcept
+  {
+    return ratio((*this)[Event::BranchMisses], (*this)[Event::Branches]);
+  }
+
+  Counters& Counters::operator+=(const Counters& t_counters) noexcept
+  {
+    for(std::size_t i = 0; i < EVENTS; ++i) {
+      values[i]    += t_counters.values[i];
+      available[i]  = available[i] || t_counters.available[i];
+    }
+    calls += t_counters.calls;
+    return *this;
+  }
+
+  Counters operator-(const Counters& t_end, const Counters& t_begin) noexcept
+  {
+    Counters delta_ { };
+    for(std::size_t i = 0; i < Counters::EVENTS; ++i) {
+      delta_.available[i] = t_end.available[i];
+      delta_.values[i]    = t_end.values[i] >= t_begin.values[i] ? t_end.values[i] - t_begin.values[i] : 0;
+    }
+    delta_.calls = 1;
+    return delta_;
+  }
+
+  std::ostream& operator<<(std::ostream& t_stream, const Counters& t_counters)
+  {
+    static const std::array<const char*, Counters::EVENTS> names_ {
+      { "cycles", "instructions", "cache-references", "cache-misses", "branches", "branch-misses" }
+    };
+
+    const auto flags_ = t_stream.flags();
+    t_stream << std::fixed << std::setprecision(3) << "calls " << t_counters.calls;
+
+    for(std::size_t i = 0; i < Counters::EVENTS; ++i) {
+      if(t_counters.available[i]) {
+        t_stream << ", " << names_[i] << " " << t_counters.values[i];
+      }
+    }
+
+    if(t_counters.has(Event::Cycles) && t_counters.has(Event::Instructions)) {
+      t_stream << ", ipc " << t_counters.ipc();
+    }
+    if(t_counters.has(Event::CacheMisses) && t_counters.has(Event::CacheReferences)) {
+      t_stream << ", cache-miss-rate " << t_counters.cacheMissRate();
+    }
+    if(t_counters.has(Event::BranchMisses) && t_counters.has(Event::Branches)) {
+      t_stream << ", branch-miss-rate " << t_counters.branchMissRate();
+    }
+
+    t_stream.flags(flags_);
+    return t_stream;
+  }
+
+  PerfCounters::PerfCounters()
+  {
+    m_descriptors.fill(-1);
+
+#ifdef __linux__
+    static const std::array<std::uint64_t, Counters::EVENTS> configs_ {
+      {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_REFERENCES,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_MISSES
+      }
+    };
+
+    for(std::size_t i = 0; i < Counters::EVENTS; ++i) {
+      perf_event_attr attr_ { };
+      attr_.size           = sizeof(attr_);
+      attr_.type           = PERF_TYPE_HARDWARE;
+      attr_.config         = configs_[i];
+      attr_.exclude_kernel = 1;
+      attr_.exclude_hv     = 1;
+      attr_.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      // Count the calling thread on any CPU.
+      m_descriptors[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr_, 0, -1, -1, 0));
+    }
+#endif
+  }
+
+  PerfCounters::~PerfCounters()
+  {
+#ifdef __linux__
+    for(const int descriptor : m_descriptors) {
+      if(descriptor >= 0) {
+        close(descriptor);
+      }
+    }
+#endif
+  }
+
+  bool PerfCounters::available() const noexcept
+  {
+    for(const int descriptor : m_descriptors) {
+      if(descriptor >= 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  Counters PerfCounters::read() const noexcept
+  {
+    Counters counters_ { };
+
+#ifdef __linux__
+    for(std::size_t i = 0; i < Counters::EVENTS; ++i) {
+      if(m_descriptors[i] < 0) {
+        continue;
+      }
+
+      // value, time enabled, time running
+      std::array<std::uint64_t, 3> data_ { };
+      if(::read(m_descriptors[i], data_.data(), sizeof(data_)) != static_cast<ssize_t>(sizeof(data_))) {
+        continue;
+      }
+
+      counters_.available[i] = true;
+      counters_.values[i] = (data_[2] != 0 && data_[2] < data_[1])
+        ? static_cast<std::uint64_t>(static_cast<double>(data_[0]) * static_cast<double>(data_[1]) / static_cast<double>(data_[2]))
+        : data_[0];
+    }
+#endif
+
+    return counters_;
+  }
+
+  Profiler::Profiler() = default;
+
+  bool Profiler::available() const noexcept
+  {
+    return m_counters.available();
+  }
+
+  std::size_t Profiler::region(const std::string& t_name)
+  {
+    for(std::size_t i = 0; i < m_regions.size(); ++i) {
+      if(m_regions[i].first == t_name) {
+        return i;
+      }
+    }
+
+    m_regions.emplace_back(t_name, Counters());
+    return m_regions.size() - 1;
+  }
+
+  void Profiler::add(std::size_t t_region, const Counters& t_counters) noexcept
+  {
+    if(t_region < m_regions.size()) {
+      m_regions[t_region].second += t_counters;
+    }
+  }
+
+  std::vector<std::pair<std::string, Counters>> Profiler::regions() const
+  {
+    return m_regions;
+  }
+
+  void Profiler::reset() noexcept
+  {
+    for(auto& [name, counters] : m_regions) {
+      counters = Counters();
+    }
+  }
+
+  std::ostream& operator<<(std::ostream& t_stream, const Profiler& t_profiler)
+  {
+    if(!t_profiler.available()) {
+      return t_stream << "hardware counters are unavailable";
+    }
+
+    const auto regions_ = t_profiler.regions();
+    for(std::size_t i = 0; i < regions_.size(); ++i) {
+      t_stream << (i ? "\n" : "") << regions_[i].first << ": " << regions_[i].second;
+    }
+    return t_stream;
+  }
+
+  Scope::Scope(Profiler* t_profiler, std::size_t t_region) noexcept
+  : m_profiler(t_profiler), m_region(t_region)
+  {
+    if(m_profiler) {
+      m_begin = m_profiler->read();
+    }
+  }
+
+  Scope::~Scope()
+  {
+    if(m_profiler) {
+      m_profiler->add(m_region, m_profiler->read() - m_begin);
+    }
+  }
+} // namespace profiling
+} // namespace network
@@ -0,0 +1,126 @@
+#include "network_core/primitives/Pooling.hpp"
+
+// STL
+#include <stdexcept>
+
+namespace network {
+  namespace primitives {
+    Pooling::Pooling(const Shape& t_input, std::size_t t_size, Mode t_mode)
+    : m_input(t_input), m_size(t_size), m_mode(t_mode)
+    {
+      if(t_size == 0 || t_size > m_input.height || t_size > m_input.width) {
+        throw std::out_of_range("pooling size is 0 or > input size");
+      }
+
+      m_output.channels = m_input.channels;
+      m_output.height   = m_input.height / m_size;
+      m_output.width    = m_input.width  / m_size;
+
+      m_argmax.assign(m_output.size(), 0);
+    }
+
+    Shape Pooling::input() const noexcept
+    {
+      return m_input;
+    }
+
+    Shape Pooling::output() const noexcept
+    {
+      return m_output;
+    }
+
+    void Pooling::calculate(const TypeValues& t_input, TypeValues& t_output) noexcept
+    {
+      t_output.resize(m_output.size());
+
+      const double scale_ = 1.0 / static_cast<double>(m_size * m_size);
+
+      for(std::size_t c = 0; c < m_output.channels; ++c) {
+        for(std::size_t y = 0; y < m_output.height; ++y) {
+          for(std::size_t x = 0; x < m_output.width; ++x) {
+            const std::size_t out_ = (c * m_output.height + y) * m_output.width + x;
+            const std::size_t origin_ = (c * m_input.height + y * m_size) * m_input.width + x * m_size;
+
+            std::size_t best_ = origin_;
+            double acc_ = 0.0;
+
+            for(std::size_t ky = 0; ky < m_size; ++ky) {
+              const std::size_t row_ = origin_ + ky * m_input.width;
+              for(std::size_t kx = 0; kx < m_size; ++kx) {
+                acc_ += t_input[row_ + kx];
+                if(t_input[row_ + kx] > t_input[best_]) {
+                  best_ = row_ + kx;
+                }
+              }
+            }
+
+            if(m_mode == Mode::Max) {
+              m_argmax[out_] = best_;
+              t_output[out_] = t_input[best_];
+            } else {
+              t_output[out_] = acc_ * scale_;
+            }
+          }
+        }
+      }
+    }
+
+    void Pooling::update(const TypeValues& /*t_input*/, const TypeValues& /*t_output*/,
+                         const TypeValues& t_error, TypeValues& t_error_input) noexcept
+    {
+      t_error_input.assign(m_input.size(), 0.0);
+
+      if(m_mode == Mode::Max) {
+        for(std::size_t i = 0; i < m_argmax.size(); ++i) {
+          t_error_input[m_argmax[i]] += t_error[i];
+        }
+        return;
+      }
+
+      const double scale_ = 1.0 / static_cast<double>(m_size * m_size);
+
+      for(std::size_t c = 0; c < m_output.channels; ++c) {
+        for(std::size_t y = 0; y < m_output.height; ++y) {
+          for(std::size_t x = 0; x < m_output.width; ++x) {
+            const double error_ = t_error[(c * m_output.height + y) * m_output.width + x] * scale_;
+            const std::size_t origin_ = (c * m_input.height + y * m_size) * m_input.width + x * m_size;
+
+            for(std::size_t ky = 0; ky < m_size; ++ky) {
+              for(std::size_t kx = 0; kx < m_size; ++kx) {
+                t_error_input[origin_ + ky * m_input.width + kx] += error_;
+              }
+            }
+          }
+        }
+      }
+    }
+
+    void Pooling::updateWeight(const double&) noexcept
+    {
+      // Pooling has no trainable parameters.
+    }
+
+    std::size_t Pooling::size() const noexcept
+    {
+      return 0;
+    }
+
+    void Pooling::parameters(TypeValueFeature*) const noexcept
+    {
+      // Pooling has no trainable parameters.
+    }
+
+    void Pooling::setParameters(const TypeValueFeature*) noexcept
+    {
+      // Pooling has no trainable parameters.
+    }
+
+    MemoryUsage Pooling::memory() const noexcept
+    {
+      MemoryUsage usage_ { };
+      usage_.activations = m_argmax.capacity() * sizeof(std::size_t);
+      usage_.overhead    = sizeof(Pooling);
+      return usage_;
+    }
+  } // namespace primitives
+} // namespace network
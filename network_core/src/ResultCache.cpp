@@ -0,0 +1,195 @@
+#include "network_core/ResultCache.hpp"
+
+// STL
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <stdexcept>
+
+namespace network {
+  namespace {
+    constexpr std::uint64_t MULTIPLIER { 0x9E3779B97F4A7C15ull };
+
+    inline std::uint64_t mix(std::uint64_t t_value) noexcept
+    {
+      t_value ^= t_value >> 33;
+      t_value *= 0xFF51AFD7ED558CCDull;
+      t_value ^= t_value >> 33;
+      t_value *= 0xC4CEB9FE1A85EC53ull;
+      t_value ^= t_value >> 33;
+      return t_value;
+    }
+  } // namespace
+
+  double CacheStatistics::hitRate() const noexcept
+  {
+    const auto lookups_ = hits + misses;
+    return lookups_ ? static_cast<double>(hits) / static_cast<double>(lookups_) : 0.0;
+  }
+
+  CacheStatistics& CacheStatistics::operator+=(const CacheStatistics& t_statistics) noexcept
+  {
+    hits          += t_statistics.hits;
+    misses        += t_statistics.misses;
+    invalidations += t_statistics.invalidations;
+    evictions     += t_statistics.evictions;
+    size          += t_statistics.size;
+    capacity      += t_statistics.capacity;
+    return *this;
+  }
+
+  std::ostream& operator<<(std::ostream& t_stream, const CacheStatistics& t_statistics)
+  {
+    const auto flags_ = t_stream.flags();
+    t_stream << std::fixed << std::setprecision(1)
+             << "cache: " << t_statistics.hits << " hits, " << t_statistics.misses << " misses, "
+             << t_statistics.hitRate() * 100.0 << "% hit rate, " << t_statistics.size << "/" << t_statistics.capacity
+             << " entries, " << t_statistics.evictions << " evictions, " << t_statistics.invalidations << " invalidations";
+    t_stream.flags(flags_);
+    return t_stream;
+  }
+
+  ResultCache::ResultCache(std::size_t t_capacity, std::size_t t_shards)
+  {
+    if(t_capacity == 0) {
+      throw std::out_of_range("cache capacity must be positive");
+    }
+
+    const std::size_t shards_ = std::max<std::size_t>(1, std::min(t_shards, t_capacity));
+    m_capacity = (t_capacity + shards_ - 1) / shards_;
+
+    m_shards.reserve(shards_);
+    for(std::size_t i = 0; i < shards_; ++i) {
+      m_shards.push_back(std::make_unique<Shard>());
+      m_shards.back()->counters.capacity = m_capacity;
+    }
+  }
+
+  ResultCache::Key ResultCache::hash(const void* t_data, std::size_t t_size, Key t_seed) noexcept
+  {
+    const auto* bytes_ = static_cast<const unsigned char*>(t_data);
+    std::uint64_t hash_ = mix(t_seed ^ (t_size * MULTIPLIER));
+
+    // Eight bytes per step, the tail is padded with zeros.
+    std::size_t i { 0 };
+    for(; i + sizeof(std::uint64_t) <= t_size; i += sizeof(std::uint64_t)) {
+      std::uint64_t word_;
+      std::memcpy(&word_, bytes_ + i, sizeof(word_));
+      hash_ = (hash_ ^ mix(word_)) * MULTIPLIER;
+    }
+
+    if(i < t_size) {
+      std::uint64_t word_ { 0 };
+      std::memcpy(&word_, bytes_ + i, t_size - i);
+      hash_ = (hash_ ^ mix(word_)) * MULTIPLIER;
+    }
+
+    return mix(hash_);
+  }
+
+  ResultCache::Key ResultCache::hash(const cv::Mat& t_image) noexcept
+  {
+    const std::uint64_t shape_[3] { static_cast<std::uint64_t>(t_image.rows), static_cast<std::uint64_t>(t_image.cols),
+                                    static_cast<std::uint64_t>(t_image.type()) };
+    Key hash_ = hash(shape_, sizeof(shape_));
+
+    const std::size_t row_ = static_cast<std::size_t>(t_image.cols) * t_image.elemSize();
+    if(t_image.isContinuous()) {
+      return hash(t_image.data, row_ * static_cast<std::size_t>(t_image.rows), hash_);
+    }
+
+    for(int r = 0; r < t_image.rows; ++r) {
+      hash_ = hash(t_image.ptr(r), row_, hash_);
+    }
+    return hash_;
+  }
+
+  std::optional<std::vector<Prediction>> ResultCache::find(Key t_key, std::size_t t_top, std::size_t t_revision)
+  {
+    const Key key_ = combine(t_key, t_top);
+    auto& shard_ = shard(key_);
+
+    std::lock_guard<std::mutex> lock(shard_.mutex);
+    const auto it_ = shard_.index.find(key_);
+    if(it_ == shard_.index.end()) {
+      ++shard_.counters.misses;
+      return std::nullopt;
+    }
+
+    if(it_->second->revision != t_revision) {
+      shard_.entries.erase(it_->second);
+      shard_.index.erase(it_);
+      ++shard_.counters.invalidations;
+      ++shard_.counters.misses;
+      return std::nullopt;
+    }
+
+    shard_.entries.splice(shard_.entries.begin(), shard_.entries, it_->second);
+    ++shard_.counters.hits;
+    return it_->second->predictions;
+  }
+
+  void ResultCache::insert(Key t_key, std::size_t t_top, std::size_t t_revision, std::vector<Prediction> t_predictions)
+  {
+    const Key key_ = combine(t_key, t_top);
+    auto& shard_ = shard(key_);
+
+    std::lock_guard<std::mutex> lock(shard_.mutex);
+    if(const auto it_ = shard_.index.find(key_); it_ != shard_.index.end()) {
+      it_->second->revision    = t_revision;
+      it_->second->predictions = std::move(t_predictions);
+      shard_.entries.splice(shard_.entries.begin(), shard_.entries, it_->second);
+      return;
+    }
+
+    if(shard_.entries.size() >= m_capacity) {
+      shard_.index.erase(shard_.entries.back().key);
+      shard_.entries.pop_back();
+      ++shard_.counters.evictions;
+    }
+
+    shard_.entries.push_front({ key_, t_revision, std::move(t_predictions) });
+    shard_.index.emplace(key_, shard_.entries.begin());
+  }
+
+  void ResultCache::clear()
+  {
+    for(auto& shard : m_shards) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->entries.clear();
+      shard->index.clear();
+    }
+  }
+
+  CacheStatistics ResultCache::statistics() const
+  {
+    CacheStatistics statistics_ { };
+    for(const auto& shard : m_shards) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      auto counters_ = shard->counters;
+      counters_.size = shard->entries.size();
+      statistics_ += counters_;
+    }
+    return statistics_;
+  }
+
+  void ResultCache::resetStatistics()
+  {
+    for(auto& shard : m_shards) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->counters = CacheStatistics { };
+      shard->counters.capacity = m_capacity;
+    }
+  }
+
+  ResultCache::Key ResultCache::combine(Key t_key, std::size_t t_top) noexcept
+  {
+    return t_key ^ mix(static_cast<std::uint64_t>(t_top) + MULTIPLIER);
+  }
+
+  ResultCache::Shard& ResultCache::shard(Key t_key) noexcept
+  {
+    // The low bits pick the bucket of unordered_map, the high bits pick the shard.
+    return *m_shards[static_cast<std::size_t>(t_key >> 32) % m_shards.size()];
+  }
+} // namespace network
@@ -0,0 +1,222 @@
+#include "network_core/utility/Statistics.hpp"
+
+// STL
+#include <algorithm>
+#include <iomanip>
+#include <utility>
+
+namespace network {
+  namespace {
+    std::atomic<std::uint64_t> unique_id_collector_ { 1 };
+
+    constexpr std::size_t index(Mode t_mode)   { return static_cast<std::size_t>(t_mode); }
+    constexpr std::size_t index(Phase t_phase) { return static_cast<std::size_t>(t_phase); }
+
+    std::size_t bucket(std::uint64_t t_nanoseconds) noexcept
+    {
+      std::size_t bucket_ { 0 };
+      while((t_nanoseconds >>= 1) != 0 && bucket_ + 1 < Statistics::BUCKETS) {
+        ++bucket_;
+      }
+      return bucket_;
+    }
+  } // namespace
+
+  const Statistics::Counter& Statistics::phase(Mode t_mode, Phase t_phase) const noexcept
+  {
+    return phases[index(t_mode)][index(t_phase)];
+  }
+
+  double Statistics::samplesPerSecond(Mode t_mode) const noexcept
+  {
+    const auto& counter_ = samples[index(t_mode)];
+    return counter_.nanoseconds ? static_cast<double>(counter_.calls) * 1e9 / static_cast<double>(counter_.nanoseconds) : 0.0;
+  }
+
+  double Statistics::percentile(Mode t_mode, double t_percentile) const noexcept
+  {
+    const auto& histogram_ = latency[index(t_mode)];
+    const std::uint64_t total_ = samples[index(t_mode)].calls;
+    if(total_ == 0) {
+      return 0.0;
+    }
+
+    const auto rank_ = static_cast<std::uint64_t>(std::clamp(t_percentile, 0.0, 1.0) * static_cast<double>(total_ - 1)) + 1;
+
+    std::uint64_t seen_ { 0 };
+    for(std::size_t i = 0; i < BUCKETS; ++i) {
+      seen_ += histogram_[i];
+      if(seen_ >= rank_) {
+        return static_cast<double>(std::uint64_t { 2 } << i) * 1e-9;
+      }
+    }
+
+    return static_cast<double>(std::uint64_t { 1 } << BUCKETS) * 1e-9;
+  }
+
+  double Statistics::allocationsPerSample(Mode t_mode) const noexcept
+  {
+    const std::uint64_t samples_ = samples[index(t_mode)].calls;
+    return samples_ ? static_cast<double>(allocations[index(t_mode)].count) / static_cast<double>(samples_) : 0.0;
+  }
+
+  std::ostream& operator<<(std::ostream& t_stream, const Statistics& t_statistics)
+  {
+    static const std::array<const char*, Statistics::PHASES> phases_ { { "decode", "fill", "forward", "backward", "update" } };
+    static const std::array<const char*, Statistics::MODES>  modes_  { { "education", "perception" } };
+
+    const auto flags_ = t_stream.flags();
+    t_stream << std::fixed << std::setprecision(3);
+
+    bool first_ { true };
+    for(std::size_t m = 0; m < Statistics::MODES; ++m) {
+      const auto mode_ = static_cast<Mode>(m);
+      const auto& samples_ = t_statistics.samples[m];
+      if(samples_.calls == 0) {
+        continue;
+      }
+
+      t_stream << (first_ ? "" : "\n") << modes_[m] << ": " << samples_.calls << " samples, "
+               << t_statistics.samplesPerSecond(mode_) << " samples/sec, p50 <= "
+               << t_statistics.percentile(mode_, 0.50) * 1e3 << " ms, p99 <= "
+               << t_statistics.percentile(mode_, 0.99) * 1e3 << " ms";
+
+      if(allocation::enabled()) {
+        t_stream << ", " << t_statistics.allocationsPerSample(mode_) << " allocations/sample";
+      }
+
+      for(std::size_t p = 0; p < Statistics::PHASES; ++p) {
+        const auto& phase_ = t_statistics.phases[m][p];
+        if(phase_.calls == 0) {
+          continue;
+        }
+
+        const double share_ = samples_.nanoseconds ? 100.0 * static_cast<double>(phase_.nanoseconds) / static_cast<double>(samples_.nanoseconds) : 0.0;
+        t_stream << ", " << phases_[p] << " " << static_cast<double>(phase_.nanoseconds) * 1e-6 << " ms (" << share_ << "%)";
+      }
+      first_ = false;
+    }
+
+    t_stream.flags(flags_);
+    return t_stream;
+  }
+
+  namespace statistics {
+    Collector::Collector() : m_id(unique_id_collector_++) { }
+
+    Collector::Accumulator& Collector::local()
+    {
+      // Collector ids are never reused, so a stale entry of a destroyed collector is never matched.
+      thread_local std::vector<std::pair<std::uint64_t, Accumulator*>> cache_ { };
+
+      for(const auto& [id, accumulator] : cache_) {
+        if(id == m_id) {
+          return *accumulator;
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_accumulators.push_back(std::make_unique<Accumulator>());
+      cache_.emplace_back(m_id, m_accumulators.back().get());
+      return *m_accumulators.back();
+    }
+
+    void Collector::phase(Mode t_mode, Phase t_phase, std::uint64_t t_nanoseconds) noexcept
+    {
+      auto& accumulator_ = local();
+      accumulator_.calls[index(t_mode)][index(t_phase)].fetch_add(1, std::memory_order_relaxed);
+      accumulator_.nanoseconds[index(t_mode)][index(t_phase)].fetch_add(t_nanoseconds, std::memory_order_relaxed);
+    }
+
+    void Collector::sample(Mode t_mode, std::uint64_t t_nanoseconds, const allocation::Counters& t_allocations) noexcept
+    {
+      auto& accumulator_ = local();
+      accumulator_.allocations[index(t_mode)].fetch_add(t_allocations.allocations, std::memory_order_relaxed);
+      accumulator_.allocated[index(t_mode)].fetch_add(t_allocations.bytes, std::memory_order_relaxed);
+      accumulator_.samples[index(t_mode)].fetch_add(1, std::memory_order_relaxed);
+      accumulator_.sample_time[index(t_mode)].fetch_add(t_nanoseconds, std::memory_order_relaxed);
+      accumulator_.latency[index(t_mode)][bucket(t_nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Statistics Collector::snapshot() const
+    {
+      Statistics statistics_ { };
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for(const auto& accumulator : m_accumulators) {
+        for(std::size_t m = 0; m < Statistics::MODES; ++m) {
+          for(std::size_t p = 0; p < Statistics::PHASES; ++p) {
+            statistics_.phases[m][p].calls       += accumulator->calls[m][p].load(std::memory_order_relaxed);
+            statistics_.phases[m][p].nanoseconds += accumulator->nanoseconds[m][p].load(std::memory_order_relaxed);
+          }
+
+          statistics_.samples[m].calls       += accumulator->samples[m].load(std::memory_order_relaxed);
+          statistics_.samples[m].nanoseconds += accumulator->sample_time[m].load(std::memory_order_relaxed);
+          statistics_.allocations[m].count   += accumulator->allocations[m].load(std::memory_order_relaxed);
+          statistics_.allocations[m].bytes   += accumulator->allocated[m].load(std::memory_order_relaxed);
+
+          for(std::size_t b = 0; b < Statistics::BUCKETS; ++b) {
+            statistics_.latency[m][b] += accumulator->latency[m][b].load(std::memory_order_relaxed);
+          }
+        }
+      }
+
+      return statistics_;
+    }
+
+    void Collector::reset() noexcept
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for(const auto& accumulator : m_accumulators) {
+        for(std::size_t m = 0; m < Statistics::MODES; ++m) {
+          for(std::size_t p = 0; p < Statistics::PHASES; ++p) {
+            accumulator->calls[m][p].store(0, std::memory_order_relaxed);
+            accumulator->nanoseconds[m][p].store(0, std::memory_order_relaxed);
+          }
+
+          accumulator->samples[m].store(0, std::memory_order_relaxed);
+          accumulator->sample_time[m].store(0, std::memory_order_relaxed);
+          accumulator->allocations[m].store(0, std::memory_order_relaxed);
+          accumulator->allocated[m].store(0, std::memory_order_relaxed);
+
+          for(auto& bucket : accumulator->latency[m]) {
+            bucket.store(0, std::memory_order_relaxed);
+          }
+        }
+      }
+    }
+
+    ScopedTimer::ScopedTimer(Collector* t_collector, Mode t_mode) noexcept
+    : m_collector(t_collector), m_mode(t_mode), m_start(std::chrono::steady_clock::now()), m_allocations(allocation::counters())
+    {
+    }
+
+    ScopedTimer::ScopedTimer(Collector* t_collector, Mode t_mode, Phase t_phase) noexcept
+    : m_collector(t_collector), m_mode(t_mode), m_phase(t_phase), m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ScopedTimer::~ScopedTimer()
+    {
+      if(!m_collector) {
+        return;
+      }
+
+      const auto elapsed_ = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_start).count());
+
+      if(m_phase == Phase::Size) {
+        const auto counters_ = allocation::counters();
+
+        allocation::Counters allocations_ { };
+        allocations_.allocations   = counters_.allocations - m_allocations.allocations;
+        allocations_.deallocations = counters_.deallocations - m_allocations.deallocations;
+        allocations_.bytes         = counters_.bytes - m_allocations.bytes;
+
+        m_collector->sample(m_mode, elapsed_, allocations_);
+      } else {
+        m_collector->phase(m_mode, m_phase, elapsed_);
+      }
+    }
+  } // namespace statistics
+} // namespace network
@@ -0,0 +1,128 @@
+#include "network_core/utility/ThreadPool.hpp"
+#include "network_core/utility/Numa.hpp"
+
+// STL
+#include <algorithm>
+
+namespace network {
+namespace utility {
+  ThreadPool::ThreadPool(std::size_t t_threads, bool t_pin)
+  {
+    const std::size_t workers_ = std::max<std::size_t>(t_threads, 1) - 1;
+    if(t_pin) {
+      m_cpus = placement(workers_ + 1);
+    }
+
+    m_threads.reserve(workers_);
+    for(std::size_t i = 0; i < workers_; ++i) {
+      m_threads.emplace_back(&ThreadPool::work, this, i + 1);
+    }
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for(auto& thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  void ThreadPool::run(std::size_t t_count, const std::function<void(std::size_t)>& t_task)
+  {
+    // Nothing to share, the caller doesn't wake anybody.
+    if(t_count < 2 || m_threads.empty()) {
+      for(std::size_t i = 0; i < t_count; ++i) {
+        t_task(i);
+      }
+      return;
+    }
+
+    std::lock_guard<std::mutex> run_(m_run);
+
+    Job job_ { };
+    job_.task  = &t_task;
+    job_.count = t_count;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_job = &job_;
+      ++m_runs;
+    }
+    m_wake.notify_all();
+
+    execute(job_, 0);
+
+    // A thread that joined the job may still run its last task, a pinned pool waits for every thread's share.
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_done.wait(lock, [this, &job_] { return job_.workers == 0 && (!pinned() || job_.joined == m_threads.size()); });
+      m_job = nullptr;
+    }
+
+    if(job_.error) {
+      std::rethrow_exception(job_.error);
+    }
+  }
+
+  void ThreadPool::work(std::size_t t_slot)
+  {
+    // Scratch buffers of the tasks are allocated by this thread, after the binding they come from its node.
+    if(pinned()) {
+      pin(m_cpus[t_slot]);
+    }
+
+    std::uint64_t seen_ { 0 };
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for(;;) {
+      m_wake.wait(lock, [this, &seen_] {
+        return m_stop || (m_job && m_runs != seen_ && (pinned() || m_job->next.load() < m_job->count));
+      });
+      if(m_stop) {
+        return;
+      }
+
+      seen_ = m_runs;
+      Job* job_ = m_job;
+      ++job_->workers;
+      ++job_->joined;
+      lock.unlock();
+
+      execute(*job_, t_slot);
+
+      lock.lock();
+      if(--job_->workers == 0) {
+        m_done.notify_all();
+      }
+    }
+  }
+
+  void ThreadPool::execute(Job& t_job, std::size_t t_slot)
+  {
+    const auto call = [this, &t_job](std::size_t t_index) {
+      try {
+        (*t_job.task)(t_index);
+      } catch(...) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!t_job.error) {
+          t_job.error = std::current_exception();
+        }
+      }
+    };
+
+    if(pinned()) {
+      for(std::size_t i = t_slot; i < t_job.count; i += size()) {
+        call(i);
+      }
+      return;
+    }
+
+    for(std::size_t i = t_job.next++; i < t_job.count; i = t_job.next++) {
+      call(i);
+    }
+  }
+} // namespace utility
+} // namespace network
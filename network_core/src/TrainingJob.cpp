@@ -0,0 +1,145 @@
+#include "network_core/TrainingJob.hpp"
+#include "network_core/Network.hpp"
+
+// STL
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+
+namespace network {
+  class TrainingJob::Control final : public EducationControl {
+    public:
+      explicit Control(std::size_t t_interval)
+      : m_interval(t_interval)
+      {
+      }
+
+      bool proceed(const EducationProgress& t_progress) override
+      {
+        if(t_progress.end || (m_interval && t_progress.samples % m_interval == 0)) {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          if(m_queue.size() == CAPACITY) {
+            m_queue.pop_front();
+          }
+          m_queue.push_back(t_progress);
+        }
+
+        // Only a pause takes the lock, a running education reads two flags per sample.
+        if(m_paused.load(std::memory_order_acquire) && !m_cancelled.load(std::memory_order_acquire)) {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_state = State::Paused;
+          m_resumed.wait(lock, [this] { return !m_paused.load() || m_cancelled.load(); });
+          m_state = State::Running;
+        }
+
+        return !m_cancelled.load(std::memory_order_acquire);
+      }
+
+      void pause() noexcept
+      {
+        m_paused.store(true, std::memory_order_release);
+      }
+
+      void resume() noexcept
+      {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_paused.store(false, std::memory_order_release);
+        }
+        m_resumed.notify_all();
+      }
+
+      void cancel() noexcept
+      {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_cancelled.store(true, std::memory_order_release);
+        }
+        m_resumed.notify_all();
+      }
+
+      void finish(State t_state) noexcept
+      {
+        m_state = t_state;
+      }
+
+      State state() const noexcept
+      {
+        return m_state.load();
+      }
+
+      std::vector<EducationProgress> poll()
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<EducationProgress> progress_(m_queue.begin(), m_queue.end());
+        m_queue.clear();
+        return progress_;
+      }
+
+    private:
+      const std::size_t             m_interval  { 0 };
+      std::mutex                    m_mutex     { };
+      std::condition_variable       m_resumed   { };
+      std::deque<EducationProgress> m_queue     { }; // Guarded by m_mutex
+      std::atomic<bool>             m_paused    { false };
+      std::atomic<bool>             m_cancelled { false };
+      std::atomic<State>            m_state     { State::Running };
+  };
+
+  TrainingJob::TrainingJob(const NetworkPtr& t_network, std::size_t t_interval)
+  : m_network(t_network), m_control(std::make_shared<Control>(t_interval))
+  {
+    std::promise<bool> promise_ { };
+    m_result = promise_.get_future().share();
+    m_network->setEducationControl(m_control);
+
+    m_thread = std::thread([network = m_network, control = m_control, promise = std::move(promise_)]() mutable {
+      // The state is final before the result is ready, a loop that sees the result reads the right state.
+      try {
+        const bool educated_ = network->education();
+        network->setEducationControl(nullptr);
+        control->finish(educated_ ? State::Finished : State::Cancelled);
+        promise.set_value(educated_);
+      } catch(...) {
+        network->setEducationControl(nullptr);
+        control->finish(State::Failed);
+        promise.set_exception(std::current_exception());
+      }
+    });
+  }
+
+  TrainingJob::~TrainingJob()
+  {
+    m_control->cancel();
+    if(m_thread.joinable()) {
+      m_thread.join();
+    }
+  }
+
+  void TrainingJob::pause() noexcept
+  {
+    m_control->pause();
+  }
+
+  void TrainingJob::resume() noexcept
+  {
+    m_control->resume();
+  }
+
+  void TrainingJob::cancel() noexcept
+  {
+    m_control->cancel();
+  }
+
+  TrainingJob::State TrainingJob::state() const noexcept
+  {
+    return m_control->state();
+  }
+
+  std::vector<EducationProgress> TrainingJob::poll()
+  {
+    return m_control->poll();
+  }
+} // namespace network
@@ -0,0 +1,126 @@
+#include "network_core/Dataset.hpp"
+#include "network_core/Evaluation.hpp"
+#include "network_core/InferenceModel.hpp"
+#include "network_core/utility/ThreadPool.hpp"
+#include "network_io/io.hpp"
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  int usage(const char* t_name)
+  {
+    std::cout << "Usage: " << t_name << " --dataset path --config config.json --model network.model\n"
+              << "        [--threads n] [--batch 64] [--decoded] [--min-accuracy 0.9] [--output report.json]" << std::endl;
+    return 1;
+  }
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+  std::string dataset_ { };
+  std::string config_  { };
+  std::string model_   { };
+  std::string output_  { };
+  std::size_t threads_ { 0 };
+  std::size_t batch_   { 64 };
+  bool        decoded_ { false };
+  double      minimum_ { 0.0 };
+
+  // Malformed numbers end in the usage instead of an uncaught exception.
+  try {
+    for(int i = 1; i < argc; ++i) {
+      const std::string arg_ { argv[i] };
+      if(arg_ == "--dataset" && i + 1 < argc) {
+        dataset_ = argv[++i];
+      } else if(arg_ == "--config" && i + 1 < argc) {
+        config_ = argv[++i];
+      } else if(arg_ == "--model" && i + 1 < argc) {
+        model_ = argv[++i];
+      } else if(arg_ == "--threads" && i + 1 < argc) {
+        threads_ = std::stoul(argv[++i]);
+      } else if(arg_ == "--batch" && i + 1 < argc) {
+        batch_ = std::max<std::size_t>(1, std::stoul(argv[++i]));
+      } else if(arg_ == "--decoded") {
+        decoded_ = true;
+      } else if(arg_ == "--min-accuracy" && i + 1 < argc) {
+        minimum_ = std::stod(argv[++i]);
+      } else if(arg_ == "--output" && i + 1 < argc) {
+        output_ = argv[++i];
+      } else {
+        return usage(argv[0]);
+      }
+    }
+  } catch(const std::invalid_argument&) {
+    return usage(argv[0]);
+  } catch(const std::out_of_range&) {
+    return usage(argv[0]);
+  }
+
+  if(dataset_.empty() || config_.empty() || model_.empty()) {
+    return usage(argv[0]);
+  }
+
+  network::Evaluation evaluation_ { };
+  try {
+    auto errors_ = std::make_shared<network::ErrorMessages>();
+    auto network_ = network::load(dataset_, config_, errors_);
+    if(!network_ || !errors_->empty()) {
+      for(const auto& error : *errors_) {
+        std::cout << "\x1b[31m[ERROR] " << error << "\x1b[0m" << std::endl;
+      }
+      return 1;
+    }
+
+    network::restore(*network_->get(), model_);
+    const auto model_ptr_ = network_->get()->freeze();
+
+    // Categories of the model in the order of its outputs, a category of several outputs is scored once.
+    std::vector<std::string> categorys_ { };
+    for(const auto& label : model_ptr_->labels()) {
+      if(std::find(categorys_.begin(), categorys_.end(), label) == categorys_.end()) {
+        categorys_.push_back(label);
+      }
+    }
+
+    const std::size_t threads_used_ = threads_ ? threads_ : std::max(1u, std::thread::hardware_concurrency());
+    const auto pool_ = threads_used_ > 1 ? std::make_shared<network::utility::ThreadPool>(threads_used_) : nullptr;
+    std::cout << "\x1b[32m[INFO] Scoring " << dataset_ << " on " << threads_used_ << " threads in batches of " << batch_ << "\x1b[0m" << std::endl;
+
+    if(decoded_) {
+      const auto start_ = std::chrono::steady_clock::now();
+      const network::Dataset dataset_images_(dataset_, categorys_, pool_);
+      const double seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+      std::cout << "\x1b[32m[INFO] Decoded " << dataset_images_.samples().size() << " images (" << dataset_images_.bytes() / 1024
+                << " KiB) in " << seconds_ << " s\x1b[0m" << std::endl;
+
+      evaluation_ = network::evaluate(*model_ptr_, dataset_images_, pool_, batch_);
+    } else {
+      evaluation_ = network::evaluate(*model_ptr_, dataset_, categorys_, pool_, batch_);
+    }
+  } catch(const std::exception& e) {
+    std::cout << "\x1b[31m[ERROR] " << e.what() << "\x1b[0m" << std::endl;
+    return 1;
+  }
+
+  std::cout << std::endl << evaluation_ << std::endl;
+
+  if(!output_.empty()) {
+    std::ofstream file_(output_);
+    network::write(file_, evaluation_);
+  }
+
+  if(evaluation_.accuracy() < minimum_) {
+    std::cout << "\x1b[31m[ERROR] Accuracy " << evaluation_.accuracy() << " is below " << minimum_ << "\x1b[0m" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -1,5 +1,9 @@
 #include "network_core/Network.hpp"
+#include "network_core/Evaluation.hpp"
+#include "network_core/InferenceModel.hpp"
+#include "network_core/utility/ThreadPool.hpp"
 #include "network_io/io.hpp"
+#include "network_log/SqliteSink.hpp"
 
 // Boost
 #include <boost/filesystem.hpp>
@@ -12,6 +16,7 @@
 #include <array>
 #include <iostream>
 #include <map>
+#include <thread>
 
 namespace fs = boost::filesystem;
 
@@ -26,52 +31,28 @@ auto main(void) -> int
 
   auto [dataset, config] = getPathToDataSet();
   auto error = std::make_shared<network::ErrorMessages>();
+
+  std::cout << "\x1b[32m[INFO] Network memory: " << network::total(network::estimate(config, error)) << "\x1b[0m" << std::endl;
+
   auto network = network::load(dataset, config, error);
 
   assert(error->empty());
 
   if(network) {
     std::cout << "\x1b[32m[INFO] Create network successfully.\x1b[0m" << std::endl;
+    network->get()->setLogSink(std::make_shared<network::SqliteSink>("education.db"));
     bool success = network->get()->education();
 
     if(success) {
       std::cout << "\x1b[32m[INFO] Network successfully educated.\x1b[0m" << std::endl;
+      network::save(*network->get(), "network.model");
 
-      auto categorys_network = network->get()->getCategorys();
-      std::string current_category {""};
-
-      for (fs::recursive_directory_iterator it(dataset), end; it != end; ++it) {
-        if(!boost::filesystem::is_regular_file(it->path())) {
-          continue;
-        }
-
-        if(it->path().filename() == "config.json") {
-          continue;
-        }
-
-        current_category = fs::path(it->path().string()).parent_path().filename().string();
-
-        auto find_categorys_network_it = std::find_if(categorys_network.begin(), categorys_network.end(), [&](auto& category_network){
-          return category_network == current_category;
-        });
-
-        if(find_categorys_network_it == categorys_network.end()) {
-          continue;
-        }
-
-        std::vector<std::string> category_result = network->get()->perception(it->path().string());
-
-        auto find_category_itr_ = std::find_if(category_result.begin(), category_result.end(), [&](auto& e){
-          return e == current_category;
-        });
-
-        if(find_category_itr_ != category_result.end()) {
-          std::cout << "\x1b[32m[INFO] Yes! " << it->path().filename() << " is correct.\x1b[0m" << std::endl;
-        } else {
-          std::cout << "\x1b[31m[ERROR] No! " << it->path().filename() << " isn't correct.\x1b[0m" << std::endl;
-        }
-      }
+      // The educated network scores its dataset in parallel batches.
+      const auto model = network->get()->freeze();
+      const auto pool  = std::make_shared<network::utility::ThreadPool>(std::max(1u, std::thread::hardware_concurrency()));
+      const auto evaluation = network::evaluate(*model, dataset, network->get()->getCategorys(), pool);
 
+      std::cout << evaluation << std::endl;
     } else {
         std::cout << "\x1b[31m[ERROR] Network successfully educated.\x1b[0m" << std::endl;
         return 1;
@@ -41,5 +41,39 @@ namespace network {
    * @throws Network::IOError If the file was not found or the content of the file is incorrect.
    */
   std::optional<NetworkUPtr> load(const std::string& dataset, const std::string& config, std::shared_ptr<ErrorMessages> errors = std::make_shared<ErrorMessages>());
+
+  /**
+   * @brief Load the neural network architecture from a parsed configuration.
+   * @param dataset Path to the neural network dataset.
+   * @param root Configuration with the contents of config.json, for example with some values replaced.
+   * @return Returns a Network type object. The pointer is valid, otherwise an exception will be thrown.
+   * @throws Network::IOError If the dataset was not found or the content of the configuration is incorrect.
+   */
+  std::optional<NetworkUPtr> load(const std::string& dataset, const pt::ptree& root, std::shared_ptr<ErrorMessages> errors = std::make_shared<ErrorMessages>());
+
+  /**
+   * @brief Estimate the memory of the neural network without creating it.
+   * @param config Path to the neural network configuration.
+   * @return Bytes held by every layer, the sizes follow the same rules as load(dataset, config).
+   * @throws Network::IOError If the file was not found or the content of the file is incorrect.
+   */
+  std::vector<LayerMemory> estimate(const std::string& config, std::shared_ptr<ErrorMessages> errors = std::make_shared<ErrorMessages>());
+
+  /**
+   * @brief Save the labels and trainable parameters of the neural network.
+   * @param network Educated network.
+   * @param model Path to the model file.
+   * @throws Network::IOError If the file can't be written.
+   */
+  void save(Network& network, const std::string& model);
+
+  /**
+   * @brief Restore the labels and trainable parameters written by save().
+   * @param network Network created from the configuration the model was educated with.
+   * @param model Path to the model file.
+   * @throws Network::FileNotFoundError If the file was not found.
+   * @throws Network::ParseError If the file is damaged or doesn't match the topology of the network.
+   */
+  void restore(Network& network, const std::string& model);
 } // namespace network
 #endif // NETWORK_IO_HPP_
\ No newline at end of file
@@ -1,6 +1,314 @@
 #include <network_io/io.hpp>
 
+// STL
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+
 namespace network {
+  namespace {
+    /**
+     * @brief Reads convolution and pooling layers from "topology.layers.feature".
+     * @param root Parsed configuration.
+     * @return Feature layers, empty if the configuration doesn't declare them.
+     * @throws ParseError If a layer is unknown or doesn't fit into the dimensions of the image.
+     */
+    FeatureLayer getFeature(const pt::ptree& root)
+    {
+      FeatureLayer feature { };
+
+      const auto data = root.get_child_optional("topology.layers.feature");
+      if(!data || data->empty()) {
+        return feature;
+      }
+
+      try {
+        primitives::Shape shape { 1, root.get<std::size_t>("dimensions.height"), root.get<std::size_t>("dimensions.width") };
+
+        for(const auto& row : *data) {
+          const pt::ptree& layer = row.second;
+          const std::string type = layer.get<std::string>("type");
+
+          FeatureLayer::PrimitiveTPtr primitive { };
+          if(type == "convolution") {
+            primitive = std::make_shared<primitives::Convolution>(shape,
+              layer.get<std::size_t>("filters"), layer.get<std::size_t>("kernel"), layer.get<std::size_t>("stride", 1));
+          } else if(type == "pooling") {
+            const std::string mode = layer.get<std::string>("mode", "max");
+            if(mode != "max" && mode != "average") throw ParseError("unknown pooling mode " + mode);
+
+            primitive = std::make_shared<primitives::Pooling>(shape,
+              layer.get<std::size_t>("size"), mode == "max" ? primitives::Pooling::Mode::Max : primitives::Pooling::Mode::Average);
+          } else {
+            throw ParseError("unknown feature layer type " + type);
+          }
+
+          shape = primitive->output();
+          feature.create(primitive);
+        }
+      } catch(const pt::ptree_error& e) {
+        throw ParseError(e.what());
+      } catch(const std::out_of_range& e) {
+        throw ParseError(e.what());
+      }
+
+      return feature;
+    }
+
+    // Header of a model file written by save(), restore() rejects other files and other versions.
+    constexpr char          MODEL_MAGIC[8] { 'N', 'E', 'T', 'W', 'O', 'R', 'K', '\0' };
+    constexpr std::uint64_t MODEL_VERSION  { 1 };
+
+    /**
+     * @brief Writes the bytes of a trivially copyable value to the model file.
+     */
+    template<typename T>
+    void write(std::ofstream& stream, const T& value)
+    {
+      stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /**
+     * @brief Reads a trivially copyable value from the model file.
+     * @throws ParseError If the file ends before the value.
+     */
+    template<typename T>
+    T read(std::ifstream& stream)
+    {
+      T value { };
+      if(!stream.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw ParseError("unexpected end of the model file");
+      }
+      return value;
+    }
+
+    /**
+     * @brief Reads the function of the output layer from "topology.activation.output".
+     * @param root Parsed configuration.
+     * @return OutputFunction::Sigmoid if the configuration doesn't declare it.
+     * @throws ParseError If the function is unknown.
+     */
+    OutputFunction getOutputFunction(const pt::ptree& root)
+    {
+      const std::string function = root.get<std::string>("topology.activation.output", "sigmoid");
+
+      if(function == "sigmoid") return OutputFunction::Sigmoid;
+      if(function == "softmax") return OutputFunction::Softmax;
+
+      throw ParseError("unknown output function " + function);
+    }
+
+    /**
+     * @brief Reads the evaluation of the sigmoids and of the softmax from "topology.activation.approximation".
+     * @param root Parsed configuration.
+     * @return computation::Approximation::Exact if the configuration doesn't declare it.
+     * @throws ParseError If the approximation is unknown.
+     */
+    computation::Approximation getApproximation(const pt::ptree& root)
+    {
+      const std::string approximation = root.get<std::string>("topology.activation.approximation", "exact");
+
+      if(approximation == "exact")      return computation::Approximation::Exact;
+      if(approximation == "polynomial") return computation::Approximation::Polynomial;
+      if(approximation == "table")      return computation::Approximation::Table;
+
+      throw ParseError("unknown approximation " + approximation);
+    }
+
+    /**
+     * @brief Hidden layers declared by "topology.graph"
+     */
+    struct Topology {
+      std::vector<std::string> names { }; // In topological order
+      std::vector<std::size_t> sizes { };
+      Graph                    graph { };
+    };
+
+    /**
+     * @brief Reads the hidden layers and their connections from "topology.graph".
+     * @param root Parsed configuration.
+     * @return std::nullopt if the configuration declares a chain in "topology.layers.hidden".
+     * @throws ParseError If a layer is unknown or declared twice, the output layer is missing or the layers form a cycle.
+     *
+     * Every layer has a name, a size and the names of its inputs. "input" names the input layer, or the output of
+     * the feature layers, and the layer named "output" declares only the inputs of the output layer.
+     */
+    std::optional<Topology> getGraph(const pt::ptree& root)
+    {
+      const auto data = root.get_child_optional("topology.graph");
+      if(!data || data->empty()) {
+        return std::nullopt;
+      }
+
+      struct Node {
+        std::string              name   { };
+        std::size_t              size   { 0 };
+        std::vector<std::string> inputs { };
+      };
+
+      std::vector<Node> nodes { };
+      std::optional<Node> output { };
+      try {
+        for(const auto& row : *data) {
+          Node node { row.second.get<std::string>("name"), 0, { } };
+          for(const auto& input : row.second.get_child("inputs")) {
+            node.inputs.push_back(input.second.get_value<std::string>());
+          }
+
+          if(node.name == "output") {
+            if(output) throw ParseError("layer output is declared twice");
+            output = std::move(node);
+            continue;
+          }
+
+          if(node.name == "input") throw ParseError("layer input can't be declared in the graph");
+          node.size = row.second.get<std::size_t>("size");
+          nodes.push_back(std::move(node));
+        }
+      } catch(const pt::ptree_error& e) {
+        throw ParseError(e.what());
+      }
+
+      if(!output) {
+        throw ParseError("graph doesn't declare the inputs of the output layer");
+      }
+
+      /* Упорядочиваем слои так, чтобы каждый шёл после всех своих входов, сохраняя порядок объявления. */
+      std::map<std::string, std::size_t> index { { "input", Graph::SOURCE } };
+      for(const auto& node : nodes) {
+        if(index.count(node.name)) throw ParseError("layer " + node.name + " is declared twice");
+        index.emplace(node.name, 0);
+      }
+
+      auto find = [&index](const std::string& name) {
+        const auto it = index.find(name);
+        if(it == index.end()) throw ParseError("unknown layer " + name);
+        return it;
+      };
+
+      Topology topology { };
+      std::vector<bool> placed(nodes.size(), false);
+      while(topology.names.size() < nodes.size()) {
+        const auto ready = std::find_if(nodes.begin(), nodes.end(), [&](const Node& node) {
+          return !placed[static_cast<std::size_t>(&node - nodes.data())] && std::all_of(node.inputs.begin(), node.inputs.end(), [&](const auto& input) {
+            const auto it = find(input);
+            return it->second == Graph::SOURCE || std::find(topology.names.begin(), topology.names.end(), input) != topology.names.end();
+          });
+        });
+
+        if(ready == nodes.end()) {
+          throw ParseError("layers of the graph form a cycle");
+        }
+
+        placed[static_cast<std::size_t>(ready - nodes.begin())] = true;
+        index[ready->name] = topology.names.size();
+        topology.names.push_back(ready->name);
+        topology.sizes.push_back(ready->size);
+      }
+
+      for(const auto& name : topology.names) {
+        const auto& node = *std::find_if(nodes.begin(), nodes.end(), [&name](const Node& e) { return e.name == name; });
+        topology.graph.inputs.emplace_back();
+        for(const auto& input : node.inputs) {
+          topology.graph.inputs.back().push_back(find(input)->second);
+        }
+      }
+
+      topology.graph.inputs.emplace_back();
+      for(const auto& input : output->inputs) {
+        topology.graph.inputs.back().push_back(find(input)->second);
+      }
+
+      for(auto inputs : topology.graph.inputs) {
+        std::sort(inputs.begin(), inputs.end());
+        if(inputs.empty() || std::adjacent_find(inputs.begin(), inputs.end()) != inputs.end()) {
+          throw ParseError("layer of the graph has no inputs or the same input twice");
+        }
+      }
+
+      return topology;
+    }
+
+    /**
+     * @brief Reads the pruning during education from the optional "pruning" section.
+     * @param root Parsed configuration.
+     * @return Disabled pruning if the configuration doesn't declare it.
+     * @throws ParseError If the sparsity is outside [0, 1) or there are no steps.
+     */
+    Pruning getPruning(const pt::ptree& root)
+    {
+      Pruning pruning { };
+      pruning.sparsity = root.get<double>("pruning.sparsity", pruning.sparsity);
+      pruning.steps    = root.get<std::size_t>("pruning.steps", pruning.steps);
+      pruning.global   = root.get<bool>("pruning.global", pruning.global);
+
+      if(pruning.sparsity < 0.0 || pruning.sparsity >= 1.0 || pruning.steps == 0) {
+        throw ParseError("pruning.sparsity must be in [0, 1) and pruning.steps positive");
+      }
+
+      return pruning;
+    }
+
+    /**
+     * @brief Reads the rehearsal of online education from the optional "replay" section.
+     * @param root Parsed configuration.
+     * @return Disabled rehearsal if the configuration doesn't declare it.
+     */
+    Replay getReplay(const pt::ptree& root)
+    {
+      Replay replay { };
+      replay.capacity = root.get<std::size_t>("replay.capacity", replay.capacity);
+      replay.replayed = root.get<std::size_t>("replay.replayed", replay.replayed);
+      return replay;
+    }
+
+    /**
+     * @brief Reads the sampling of the output neurons with a small error from the optional "output_sampling" section.
+     * @param root Parsed configuration.
+     * @return Disabled sampling if the configuration doesn't declare it.
+     * @throws ParseError If the threshold is negative or the rate is outside [0, 1].
+     */
+    OutputSampling getOutputSampling(const pt::ptree& root)
+    {
+      OutputSampling sampling { };
+      sampling.threshold = root.get<double>("output_sampling.threshold", sampling.threshold);
+      sampling.rate      = root.get<double>("output_sampling.rate", sampling.rate);
+
+      if(sampling.threshold < 0.0 || sampling.rate < 0.0 || sampling.rate > 1.0) {
+        throw ParseError("output_sampling.threshold must be non-negative and output_sampling.rate in [0, 1]");
+      }
+
+      return sampling;
+    }
+
+    /**
+     * @brief Reads the random transformation of the samples from the optional "augmentation" section.
+     * @param root Parsed configuration.
+     * @return Disabled augmentation if the configuration doesn't declare it.
+     * @throws ParseError If a probability is outside [0, 1] or an amount is negative.
+     */
+    Augmentation getAugmentation(const pt::ptree& root)
+    {
+      Augmentation augmentation { };
+      augmentation.flip       = root.get<double>("augmentation.flip", augmentation.flip);
+      augmentation.shift      = root.get<std::size_t>("augmentation.shift", augmentation.shift);
+      augmentation.rotation   = root.get<double>("augmentation.rotation", augmentation.rotation);
+      augmentation.brightness = root.get<double>("augmentation.brightness", augmentation.brightness);
+      augmentation.contrast   = root.get<double>("augmentation.contrast", augmentation.contrast);
+      augmentation.noise      = root.get<double>("augmentation.noise", augmentation.noise);
+      augmentation.seed       = root.get<std::uint64_t>("augmentation.seed", augmentation.seed);
+
+      if(augmentation.flip < 0.0 || augmentation.flip > 1.0 || augmentation.rotation < 0.0 || augmentation.brightness < 0.0
+      || augmentation.contrast < 0.0 || augmentation.noise < 0.0) {
+        throw ParseError("augmentation.flip must be in [0, 1] and the other amounts non-negative");
+      }
+
+      return augmentation;
+    }
+  } // namespace
+
   std::optional<NetworkUPtr> load(const std::string& config, std::shared_ptr<ErrorMessages> errors)
   {
     if (!fs::exists(fs::path(config))) {
@@ -12,9 +320,13 @@ namespace network {
     pt::ptree root;
     pt::read_json(config, root);
 
-    InputLayer  input  { };
-    HiddenLayer hidden { };
-    OutputLayer output { };
+    InputLayer   input   { };
+    FeatureLayer feature { };
+    HiddenLayer  hidden  { };
+    OutputLayer  output  { };
+    OutputFunction function { };
+    computation::Approximation approximation { };
+    std::optional<Topology> topology { };
 
     auto getData = [&root](auto& layer, auto&& topic) mutable -> decltype(auto) {
       try {
@@ -24,12 +336,12 @@ namespace network {
         if(exist) {
           int size_ = root.get<int>(std::forward<decltype(topic)>(topic));
           if(size_<0) throw ParseError("size neurons in layer is < 0");
-          layer.create(size_, std::conditional_t<is_single_layer<decltype(layer)>::value, std::true_type, std::false_type>{});
+          layer.create(size_, std::conditional_t<is_single_layer<std::remove_reference_t<decltype(layer)>>::value, std::true_type, std::false_type>{});
         } else {
           for(const auto& row : data | boost::adaptors::indexed(0)) {
             int size_ = row.value().second.get_value<int>();
             if(size_<0) throw ParseError("size neurons in layer is < 0");
-            layer.create(std::move(size_), std::conditional_t<is_single_layer<decltype(layer)>::value, std::true_type, std::false_type>{});
+            layer.create(std::move(size_), std::conditional_t<is_single_layer<std::remove_reference_t<decltype(layer)>>::value, std::true_type, std::false_type>{});
           }
         }
       } catch(const pt::ptree_bad_path& e) {
@@ -39,18 +351,46 @@ namespace network {
 
     try {
       getData(input, "topology.layers.input");
-      getData(hidden, "topology.layers.hidden");
+      feature = getFeature(root);
+      if(topology = getGraph(root); topology) {
+        for(const auto& size : topology->sizes) {
+          hidden.create(size, std::false_type{});
+        }
+      } else {
+        getData(hidden, "topology.layers.hidden");
+      }
       getData(output, "topology.layers.output");
+      function = getOutputFunction(root);
+      approximation = getApproximation(root);
     } catch(const ParseError& e) {
       errors->push_back(e.what());
       return {};
     }
 
-    auto network = std::make_unique<Network>(std::move(input), std::move(hidden), std::move(output));
+    auto network = std::make_unique<Network>(std::move(input), std::move(feature), std::move(hidden), std::move(output), topology ? topology->graph : Graph());
+    network->setApproximation(approximation);
+    network->setOutputFunction(function);
+    if(const auto threads = root.get<std::size_t>("threads", 1); threads > 1) {
+      network->setThreadPool(std::make_shared<utility::ThreadPool>(threads, root.get<bool>("pin", false)));
+    }
     return network;
   }
 
   std::optional<NetworkUPtr> load(const std::string& dataset, const std::string& config, std::shared_ptr<ErrorMessages> errors)
+  {
+    if (!fs::exists(fs::path(config))) {
+      errors->push_back("Could not find config file " + config);
+      throw FileNotFoundError("Could not find config file " + config);
+      return {};
+    }
+
+    pt::ptree root;
+    pt::read_json(config, root);
+
+    return load(dataset, root, errors);
+  }
+
+  std::optional<NetworkUPtr> load(const std::string& dataset, const pt::ptree& root, std::shared_ptr<ErrorMessages> errors)
   {
     std::optional<NetworkUPtr> network;
 
@@ -60,23 +400,14 @@ namespace network {
       return network;
     }
 
-    if (!fs::exists(fs::path(config))) {
-      errors->push_back("Could not find config file " + config);
-      throw FileNotFoundError("Could not find config file " + config);
-      return network;
-    }
-
     /* Считываем информацию о dimensions и category. */
-    pt::ptree root;
-    pt::read_json(config, root);
-
     const int width = root.get<int>("dimensions.width");
     const int height = root.get<int>("dimensions.height");
 
     std::vector<std::string> categorys { };
     const pt::ptree categorys_tree = root.get_child("category");
 
-    if((categorys_tree.empty())||(width<0)||(height<0)) throw ParseError("config file is error: " + config);
+    if((categorys_tree.empty())||(width<0)||(height<0)) throw ParseError("config file is error: category or dimensions");
 
     for(const auto& row : categorys_tree) {
       categorys.emplace_back(std::move(row.second.get_value<std::string>()));
@@ -86,11 +417,12 @@ namespace network {
     const int size_nerons_input_  = root.get<int>("topology.layers.input");
     const int size_nerons_output_ = root.get<int>("topology.layers.output");
 
-    if((size_nerons_input_<0)||(size_nerons_output_<0)) throw ParseError("config file is error: " + config);
+    if((size_nerons_input_<0)||(size_nerons_output_<0)) throw ParseError("config file is error: topology.layers");
 
-    InputLayer  input  { };
-    HiddenLayer hidden { };
-    OutputLayer output { };
+    InputLayer   input   { };
+    FeatureLayer feature { };
+    HiddenLayer  hidden  { };
+    OutputLayer  output  { };
 
     {
       const int size_dimensions_ = width*height;
@@ -110,8 +442,43 @@ namespace network {
       output.create(size_categorys_, std::conditional_t<is_single_layer<decltype(output)>::value, std::true_type, std::false_type>{});
     }
 
-    /* Получаем информацию о скрытом слое. */
-    {
+    /* Получаем информацию о свёрточных слоях, функции выходного слоя, прореживании, повторении, искажении образов и выборке выходов. */
+    OutputFunction function { };
+    computation::Approximation approximation { };
+    Pruning pruning { };
+    Replay replay { };
+    Augmentation augmentation { };
+    OutputSampling sampling { };
+    try {
+      feature = getFeature(root);
+      function = getOutputFunction(root);
+      approximation = getApproximation(root);
+      pruning = getPruning(root);
+      replay = getReplay(root);
+      augmentation = getAugmentation(root);
+      sampling = getOutputSampling(root);
+    } catch(const ParseError& e) {
+      errors->push_back(e.what());
+      return network;
+    } catch(const pt::ptree_bad_data& e) {
+      errors->push_back(e.what());
+      return network;
+    }
+
+    /* Получаем информацию о скрытых слоях: цепочка или граф. */
+    std::optional<Topology> topology { };
+    try {
+      topology = getGraph(root);
+    } catch(const ParseError& e) {
+      errors->push_back(e.what());
+      return network;
+    }
+
+    if(topology) {
+      for(const auto& size : topology->sizes) {
+        hidden.create(size, std::false_type{});
+      }
+    } else {
       auto getData = [&root](auto& layer, auto&& topic) mutable -> decltype(auto) {
         try {
           const pt::ptree data = root.get_child(topic);
@@ -120,12 +487,12 @@ namespace network {
           if(exist) {
             int size_ = root.get<int>(std::forward<decltype(topic)>(topic));
             if(size_<0) throw ParseError("size neurons in layer is < 0");
-            layer.create(size_, std::conditional_t<is_single_layer<decltype(layer)>::value, std::true_type, std::false_type>{});
+            layer.create(size_, std::conditional_t<is_single_layer<std::remove_reference_t<decltype(layer)>>::value, std::true_type, std::false_type>{});
           } else {
             for(const auto& row : data | boost::adaptors::indexed(0)) {
               int size_ = row.value().second.get_value<int>();
               if(size_<0) throw ParseError("size neurons in layer is < 0");
-              layer.create(std::move(size_), std::conditional_t<is_single_layer<decltype(layer)>::value, std::true_type, std::false_type>{});
+              layer.create(std::move(size_), std::conditional_t<is_single_layer<std::remove_reference_t<decltype(layer)>>::value, std::true_type, std::false_type>{});
             }
           }
         } catch(const pt::ptree_bad_path& e) {
@@ -141,15 +508,196 @@ namespace network {
       }
     }
 
-    /* Получаем количество эпох на обучение. */
+    /* Получаем количество эпох на обучение и шаг обновления весов. */
     std::size_t epoch_ = root.get<std::size_t>("epoch");
+    const double learning_rate_ = root.get<double>("learning_rate", Constants::LEARNING_RATE_DEFAULT);
 
-    if(network = std::make_unique<Network>(std::move(input), std::move(hidden), std::move(output))) {
+    if(learning_rate_ <= 0.0) {
+      errors->push_back("learning_rate must be positive");
+      return network;
+    }
+
+    if(network = std::make_unique<Network>(std::move(input), std::move(feature), std::move(hidden), std::move(output), topology ? topology->graph : Graph())) {
       (*network)->setDataset(dataset);
       (*network)->setCategorys(std::move(categorys));
       (*network)->setEpoch(std::move(epoch_));
+      (*network)->setLearningRate(learning_rate_);
+      (*network)->setApproximation(approximation);
+      (*network)->setOutputFunction(function);
+      (*network)->setPruning(pruning);
+      (*network)->setReplay(replay);
+      (*network)->setAugmentation(augmentation);
+      (*network)->setOutputSampling(sampling);
+      /* Изображения размера dimensions декодируются в переиспользуемые буферы. */
+      (*network)->setImagePool(std::make_shared<ImagePool>(static_cast<std::size_t>(width), static_cast<std::size_t>(height)));
+      if(const auto threads = root.get<std::size_t>("threads", 1); threads > 1) {
+        (*network)->setThreadPool(std::make_shared<utility::ThreadPool>(threads, root.get<bool>("pin", false)));
+      }
     }
 
     return network;
   }
-} // namespace network
\ No newline at end of file
+
+  std::vector<LayerMemory> estimate(const std::string& config, std::shared_ptr<ErrorMessages> errors)
+  {
+    using Layer = primitives::Layer<primitives::Neuron>;
+
+    if (!fs::exists(fs::path(config))) {
+      errors->push_back("Could not find config file " + config);
+      throw FileNotFoundError("Could not find config file " + config);
+    }
+
+    pt::ptree root;
+    pt::read_json(config, root);
+
+    std::vector<LayerMemory> layers { };
+
+    try {
+      /* Размер входного слоя определяется dimensions, если они заданы. */
+      std::size_t inputs = root.get<std::size_t>("topology.layers.input");
+      if(root.get_child_optional("dimensions")) {
+        inputs = root.get<std::size_t>("dimensions.width") * root.get<std::size_t>("dimensions.height");
+      }
+      layers.push_back({ "input", inputs, Layer::estimate(inputs, 0) });
+
+      const FeatureLayer feature = getFeature(root);
+      for(std::size_t i = 0; i < feature.layers().size(); ++i) {
+        const auto& primitive = feature.layers()[i];
+
+        LayerMemory layer { "feature " + std::to_string(i), primitive->output().size(), primitive->memory() };
+        layer.usage.activations += primitive->output().size() * sizeof(primitives::Feature::TypeValueFeature);
+        layer.usage.gradients   += primitive->input().size() * sizeof(primitives::Feature::TypeValueFeature);
+        layers.push_back(std::move(layer));
+
+        inputs = primitive->output().size();
+      }
+
+      if(!feature.empty()) {
+        layers.push_back({ "feature output", inputs, Layer::estimate(inputs, 0) });
+      }
+
+      /* Без графа скрытые слои образуют цепочку, каждый соединён с предыдущим. */
+      std::optional<Topology> topology = getGraph(root);
+      if(!topology) {
+        topology.emplace();
+        const pt::ptree hidden = root.get_child("topology.layers.hidden");
+        if(hidden.empty()) {
+          topology->sizes.push_back(root.get<std::size_t>("topology.layers.hidden"));
+        } else {
+          for(const auto& row : hidden) {
+            topology->sizes.push_back(row.second.get_value<std::size_t>());
+          }
+        }
+
+        for(std::size_t i = 0; i <= topology->sizes.size(); ++i) {
+          topology->graph.inputs.push_back({ i == 0 ? Graph::SOURCE : i - 1 });
+        }
+      }
+
+      /* Размер выходного слоя определяется количеством категорий, если они заданы. */
+      std::size_t outputs = root.get<std::size_t>("topology.layers.output");
+      if(const auto categorys = root.get_child_optional("category")) {
+        outputs = categorys->size();
+      }
+
+      const auto& sizes = topology->sizes;
+      for(std::size_t i = 0; i <= sizes.size(); ++i) {
+        std::size_t synapses = 0;
+        for(const auto& input : topology->graph.inputs[i]) {
+          synapses += (input == Graph::SOURCE) ? inputs : sizes[input];
+        }
+
+        if(i < sizes.size()) {
+          layers.push_back({ "hidden " + std::to_string(i), sizes[i], Layer::estimate(sizes[i], synapses) });
+        } else {
+          layers.push_back({ "output", outputs, Layer::estimate(outputs, synapses) });
+        }
+      }
+    } catch(const pt::ptree_error& e) {
+      errors->push_back(e.what());
+      throw ParseError(e.what());
+    } catch(const ParseError& e) {
+      errors->push_back(e.what());
+      throw;
+    }
+
+    return layers;
+  }
+
+  void save(Network& network, const std::string& model)
+  {
+    std::ofstream stream(model, std::ios::binary | std::ios::trunc);
+    if(!stream) {
+      throw IOError("Could not open model file " + model);
+    }
+
+    /* Заголовок, категории выходных нейронов и параметры всех слоёв. */
+    const auto& labels = network.getLabels();
+    const auto parameters = network.parameters();
+
+    stream.write(MODEL_MAGIC, sizeof(MODEL_MAGIC));
+    write(stream, MODEL_VERSION);
+    write(stream, static_cast<std::uint64_t>(labels.size()));
+    for(const auto& label : labels) {
+      write(stream, static_cast<std::uint64_t>(label.size()));
+      stream.write(label.data(), static_cast<std::streamsize>(label.size()));
+    }
+    write(stream, static_cast<std::uint64_t>(parameters.size()));
+    stream.write(reinterpret_cast<const char*>(parameters.data()), static_cast<std::streamsize>(parameters.size() * sizeof(double)));
+
+    if(!stream.flush()) {
+      throw IOError("Could not write model file " + model);
+    }
+  }
+
+  void restore(Network& network, const std::string& model)
+  {
+    if (!fs::exists(fs::path(model))) {
+      throw FileNotFoundError("Could not find model file " + model);
+    }
+
+    std::ifstream stream(model, std::ios::binary);
+
+    char magic[sizeof(MODEL_MAGIC)] { };
+    if(!stream.read(magic, sizeof(magic)) || std::memcmp(magic, MODEL_MAGIC, sizeof(magic)) != 0) {
+      throw ParseError("model file is error: " + model);
+    }
+
+    if(read<std::uint64_t>(stream) != MODEL_VERSION) {
+      throw ParseError("unsupported version of the model file " + model);
+    }
+
+    const std::size_t remaining = static_cast<std::size_t>(fs::file_size(fs::path(model)));
+
+    const auto count = read<std::uint64_t>(stream);
+    if(count > remaining) throw ParseError("model file is error: " + model);
+
+    std::vector<std::string> labels(count);
+    for(auto& label : labels) {
+      const auto size = read<std::uint64_t>(stream);
+      if(size > remaining) throw ParseError("model file is error: " + model);
+
+      label.resize(size);
+      if(!stream.read(label.data(), static_cast<std::streamsize>(size))) {
+        throw ParseError("unexpected end of the model file");
+      }
+    }
+
+    const auto size = read<std::uint64_t>(stream);
+    if(size > remaining / sizeof(double)) throw ParseError("model file is error: " + model);
+
+    std::vector<double> parameters(size);
+    if(!stream.read(reinterpret_cast<char*>(parameters.data()), static_cast<std::streamsize>(size * sizeof(double)))) {
+      throw ParseError("unexpected end of the model file");
+    }
+
+    try {
+      network.setParameters(parameters);
+      if(!labels.empty()) {
+        network.setLabels(labels);
+      }
+    } catch(const std::out_of_range& e) {
+      throw ParseError("model file doesn't match the network: " + std::string(e.what()));
+    }
+  }
+} // namespace network
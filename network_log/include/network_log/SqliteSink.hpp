@@ -0,0 +1,90 @@
+#pragma once
+
+#ifndef NETWORK_SQLITE_SINK_HPP_
+#define NETWORK_SQLITE_SINK_HPP_
+
+#include "network_core/LogSink.hpp"
+#include "network_core/Exeption.hpp"
+#include "network_core/utility/RingBuffer.hpp"
+
+// STL
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// SQLite
+#include <sqlite3.h>
+
+namespace network {
+  /**
+   * @brief Education history stored in a local SQLite database.
+   *
+   * push() only copies the record into a lock-free ring buffer, networks educating on several threads may
+   * share one sink and push at the same time. A background thread drains the buffer
+   * and writes the records in batches, each batch in a single transaction. Records are dropped
+   * instead of blocking the education when the buffer is full.
+   */
+  class SqliteSink final : public LogSink {
+    public:
+      /**
+       * @param t_path Path to the database file, it is created if it doesn't exist.
+       * @param t_run Name of the education run stored with every record, the current time if empty.
+       * @param t_capacity Number of records the ring buffer holds.
+       * @param t_batch Maximal number of records written in one transaction.
+       * @throws DatabaseError If the database can't be opened or the table can't be created.
+       */
+      explicit SqliteSink(const std::string& t_path, const std::string& t_run = "",
+                          std::size_t t_capacity = 1024, std::size_t t_batch = 64);
+
+      SqliteSink(const SqliteSink&) = delete;
+      SqliteSink& operator=(const SqliteSink&) = delete;
+
+      /**
+       * @brief Writes the remaining records and stops the writer.
+       */
+      ~SqliteSink() override;
+
+      bool push(const EpochRecord& t_record) noexcept override;
+
+      /**
+       * @brief Blocks until every accepted record is written.
+       */
+      void flush();
+
+      inline const std::string& run() const noexcept { return m_run; }
+      inline std::size_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+      inline std::size_t failed()  const noexcept { return m_failed.load(std::memory_order_relaxed); }
+
+    private:
+      void work();
+      void write(const std::vector<EpochRecord>& t_batch);
+
+    private:
+      using Database  = std::unique_ptr<sqlite3, decltype(&sqlite3_close)>;
+      using Statement = std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)>;
+
+      Database    m_database  { nullptr, &sqlite3_close };
+      Statement   m_insert    { nullptr, &sqlite3_finalize };
+      std::string m_run       { };
+      std::size_t m_batch     { 64 };
+
+      utility::RingBuffer<EpochRecord> m_buffer;
+
+      std::atomic<bool>        m_stop     { false };
+      std::atomic<std::size_t> m_accepted { 0 };
+      std::atomic<std::size_t> m_written  { 0 };
+      std::atomic<std::size_t> m_dropped  { 0 };
+      std::atomic<std::size_t> m_failed   { 0 };
+
+      std::mutex              m_mutex   { };
+      std::condition_variable m_wake    { };
+      std::condition_variable m_flushed { };
+      std::thread             m_writer  { };
+  };
+} // namespace network
+#endif // NETWORK_SQLITE_SINK_HPP_
@@ -0,0 +1,149 @@
+#include <network_log/SqliteSink.hpp>
+
+// STL
+#include <chrono>
+
+namespace network {
+  SqliteSink::SqliteSink(const std::string& t_path, const std::string& t_run, std::size_t t_capacity, std::size_t t_batch)
+  : m_run(t_run), m_batch(t_batch ? t_batch : 1), m_buffer(t_capacity)
+  {
+    sqlite3* database_ { nullptr };
+    const int status_ = sqlite3_open(t_path.c_str(), &database_);
+    m_database.reset(database_);
+
+    if(status_ != SQLITE_OK) {
+      throw DatabaseError("Could not open database " + t_path + ": " + sqlite3_errmsg(database_));
+    }
+
+    const char* schema_ =
+      "CREATE TABLE IF NOT EXISTS epochs ("
+      "  id            INTEGER PRIMARY KEY AUTOINCREMENT,"
+      "  run           TEXT    NOT NULL,"
+      "  epoch         INTEGER NOT NULL,"
+      "  samples       INTEGER NOT NULL,"
+      "  loss          REAL    NOT NULL,"
+      "  accuracy      REAL    NOT NULL,"
+      "  seconds       REAL    NOT NULL,"
+      "  learning_rate REAL    NOT NULL,"
+      "  timestamp     INTEGER NOT NULL);";
+
+    if(sqlite3_exec(m_database.get(), schema_, nullptr, nullptr, nullptr) != SQLITE_OK) {
+      throw DatabaseError("Could not create table in " + t_path + ": " + sqlite3_errmsg(m_database.get()));
+    }
+
+    sqlite3_stmt* insert_ { nullptr };
+    const char* query_ =
+      "INSERT INTO epochs (run, epoch, samples, loss, accuracy, seconds, learning_rate, timestamp) "
+      "VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8);";
+
+    if(sqlite3_prepare_v2(m_database.get(), query_, -1, &insert_, nullptr) != SQLITE_OK) {
+      throw DatabaseError("Could not prepare insert in " + t_path + ": " + sqlite3_errmsg(m_database.get()));
+    }
+    m_insert.reset(insert_);
+
+    if(m_run.empty()) {
+      m_run = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    m_writer = std::thread(&SqliteSink::work, this);
+  }
+
+  SqliteSink::~SqliteSink()
+  {
+    m_stop.store(true, std::memory_order_release);
+    m_wake.notify_one();
+
+    if(m_writer.joinable()) {
+      m_writer.join();
+    }
+  }
+
+  bool SqliteSink::push(const EpochRecord& t_record) noexcept
+  {
+    if(!m_buffer.push(t_record)) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    m_accepted.fetch_add(1, std::memory_order_release);
+    m_wake.notify_one();
+    return true;
+  }
+
+  void SqliteSink::flush()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const std::size_t accepted_ = m_accepted.load(std::memory_order_acquire);
+
+    m_wake.notify_one();
+    m_flushed.wait(lock, [&]() { return m_written.load(std::memory_order_acquire) >= accepted_; });
+  }
+
+  void SqliteSink::work()
+  {
+    std::vector<EpochRecord> batch_ { };
+    batch_.reserve(m_batch);
+
+    for(;;) {
+      EpochRecord record_ { };
+      while(batch_.size() < m_batch && m_buffer.pop(record_)) {
+        batch_.push_back(record_);
+      }
+
+      if(!batch_.empty()) {
+        write(batch_);
+
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_written.fetch_add(batch_.size(), std::memory_order_release);
+        }
+        m_flushed.notify_all();
+
+        batch_.clear();
+        continue;
+      }
+
+      if(m_stop.load(std::memory_order_acquire)) {
+        break;
+      }
+
+      // push() doesn't take the mutex, so a wake-up can be missed and the timeout bounds the delay.
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait_for(lock, std::chrono::milliseconds(100));
+    }
+  }
+
+  void SqliteSink::write(const std::vector<EpochRecord>& t_batch)
+  {
+    sqlite3* database_ = m_database.get();
+    sqlite3_stmt* insert_ = m_insert.get();
+
+    if(sqlite3_exec(database_, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+      m_failed.fetch_add(t_batch.size(), std::memory_order_relaxed);
+      return;
+    }
+
+    for(const auto& record : t_batch) {
+      sqlite3_bind_text(insert_, 1, m_run.c_str(), -1, SQLITE_STATIC);
+      sqlite3_bind_int64(insert_, 2, static_cast<sqlite3_int64>(record.epoch));
+      sqlite3_bind_int64(insert_, 3, static_cast<sqlite3_int64>(record.samples));
+      sqlite3_bind_double(insert_, 4, record.loss);
+      sqlite3_bind_double(insert_, 5, record.accuracy);
+      sqlite3_bind_double(insert_, 6, record.seconds);
+      sqlite3_bind_double(insert_, 7, record.learning_rate);
+      sqlite3_bind_int64(insert_, 8, static_cast<sqlite3_int64>(record.timestamp));
+
+      if(sqlite3_step(insert_) != SQLITE_DONE) {
+        m_failed.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      sqlite3_reset(insert_);
+    }
+
+    if(sqlite3_exec(database_, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+      m_failed.fetch_add(t_batch.size(), std::memory_order_relaxed);
+      sqlite3_exec(database_, "ROLLBACK;", nullptr, nullptr, nullptr);
+    }
+  }
+} // namespace network
@@ -0,0 +1,211 @@
+#include "Batcher.hpp"
+
+// STL
+#include <algorithm>
+#include <iomanip>
+
+namespace network {
+namespace server {
+  namespace {
+    constexpr std::size_t MAX_LATENCIES { 1u << 20 }; // Samples kept between reports
+
+    double percentile(std::vector<std::uint64_t>& t_values, double t_percentile)
+    {
+      if(t_values.empty()) {
+        return 0.0;
+      }
+
+      const auto rank_ = static_cast<std::size_t>(t_percentile * static_cast<double>(t_values.size() - 1));
+      std::nth_element(t_values.begin(), t_values.begin() + static_cast<std::ptrdiff_t>(rank_), t_values.end());
+      return static_cast<double>(t_values[rank_]) * 1e-9;
+    }
+  } // namespace
+
+  std::ostream& operator<<(std::ostream& t_stream, const Report& t_report)
+  {
+    const auto flags_ = t_stream.flags();
+    t_stream << std::fixed << std::setprecision(3)
+             << t_report.requests << " requests, " << t_report.throughput() << " requests/sec, "
+             << t_report.meanBatch() << " mean batch, p50 " << t_report.p50 * 1e3 << " ms, p99 "
+             << t_report.p99 * 1e3 << " ms, max " << t_report.max * 1e3 << " ms, "
+             << t_report.rejected << " rejected";
+    if(t_report.cache) {
+      t_stream << ", " << *t_report.cache;
+    }
+    t_stream.flags(flags_);
+    return t_stream;
+  }
+
+  Batcher::Batcher(NetworkPtr t_network, const Options& t_options)
+  : m_network(std::move(t_network)), m_options(t_options)
+  {
+    if(!m_network) {
+      throw NotInitializeError("Not initialize network for the batcher.");
+    }
+
+    m_options.max_batch = std::max<std::size_t>(m_options.max_batch, 1);
+    m_thread = std::thread(&Batcher::run, this);
+  }
+
+  Batcher::~Batcher()
+  {
+    stop();
+    if(m_thread.joinable()) {
+      m_thread.join();
+    }
+  }
+
+  std::future<Result> Batcher::submit(cv::Mat t_image, std::size_t t_top)
+  {
+    Request request_ { std::move(t_image), t_top, Clock::now(), std::promise<Result>() };
+    auto future_ = request_.promise.get_future();
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if(!m_stopped && m_queue.size() < m_options.max_queue) {
+        m_queue.push_back(std::move(request_));
+        m_ready.notify_one();
+        return future_;
+      }
+      ++m_rejected;
+    }
+
+    Result result_ { };
+    result_.status = Status::Overloaded;
+    request_.promise.set_value(std::move(result_));
+    return future_;
+  }
+
+  Report Batcher::report()
+  {
+    std::vector<std::uint64_t> latencies_ { };
+    Report report_ { };
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      const auto now_ = Clock::now();
+
+      latencies_.swap(m_latencies);
+      report_.rejected = m_rejected;
+      report_.batches  = m_batches;
+      report_.seconds  = std::chrono::duration<double>(now_ - m_window).count();
+
+      m_rejected = 0;
+      m_batches  = 0;
+      m_window   = now_;
+    }
+
+    report_.requests = latencies_.size();
+    report_.p50 = percentile(latencies_, 0.50);
+    report_.p99 = percentile(latencies_, 0.99);
+    report_.max = latencies_.empty() ? 0.0 : static_cast<double>(*std::max_element(latencies_.begin(), latencies_.end())) * 1e-9;
+
+    if(const auto& cache_ = m_network->getCache()) {
+      report_.cache = cache_->statistics();
+      cache_->resetStatistics();
+    }
+    return report_;
+  }
+
+  void Batcher::stop() noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopped = true;
+    m_ready.notify_all();
+  }
+
+  void Batcher::run()
+  {
+    std::vector<Request> batch_ { };
+    batch_.reserve(m_options.max_batch);
+
+    for(;;) {
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_ready.wait(lock, [this]() { return m_stopped || !m_queue.empty(); });
+
+        if(m_queue.empty()) {
+          return;
+        }
+
+        // The deadline belongs to the oldest request, later arrivals only fill the batch.
+        const auto deadline_ = m_queue.front().arrival + m_options.max_delay;
+        m_ready.wait_until(lock, deadline_, [this]() { return m_stopped || m_queue.size() >= m_options.max_batch; });
+
+        const std::size_t size_ = std::min(m_queue.size(), m_options.max_batch);
+        for(std::size_t i = 0; i < size_; ++i) {
+          batch_.push_back(std::move(m_queue.front()));
+          m_queue.pop_front();
+        }
+        ++m_batches;
+      }
+
+      process(batch_);
+      batch_.clear();
+    }
+  }
+
+  void Batcher::process(std::vector<Request>& t_batch)
+  {
+    std::vector<cv::Mat> images_ { };
+    images_.reserve(t_batch.size());
+    for(const auto& request : t_batch) {
+      images_.push_back(request.image);
+    }
+
+    std::vector<std::vector<Prediction>> predictions_ { };
+    try {
+      predictions_ = m_network->perception(images_, 0);
+    } catch(const std::out_of_range&) {
+      // One of the images doesn't fit, run them alone to answer the others.
+      predictions_.clear();
+    } catch(const std::exception&) {
+      for(auto& request : t_batch) {
+        Result result_ { };
+        result_.status = Status::Error;
+        complete(request, std::move(result_));
+      }
+      return;
+    }
+
+    for(std::size_t i = 0; i < t_batch.size(); ++i) {
+      Result result_ { };
+      result_.batch = t_batch.size();
+
+      if(!predictions_.empty()) {
+        result_.predictions = std::move(predictions_[i]);
+      } else {
+        try {
+          result_.predictions = std::move(m_network->perception(std::vector<cv::Mat> { t_batch[i].image }, 0).front());
+        } catch(const std::out_of_range&) {
+          result_.status = Status::BadRequest;
+        } catch(const std::exception&) {
+          result_.status = Status::Error;
+        }
+      }
+
+      const std::size_t top_ = t_batch[i].top;
+      if(top_ != 0 && result_.predictions.size() > top_) {
+        result_.predictions.resize(top_);
+      }
+
+      complete(t_batch[i], std::move(result_));
+    }
+  }
+
+  void Batcher::complete(Request& t_request, Result t_result)
+  {
+    t_result.latency_ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      Clock::now() - t_request.arrival).count());
+
+    if(t_result.status == Status::Ok) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if(m_latencies.size() < MAX_LATENCIES) {
+        m_latencies.push_back(t_result.latency_ns);
+      }
+    }
+
+    t_request.promise.set_value(std::move(t_result));
+  }
+} // namespace server
+} // namespace network
@@ -0,0 +1,122 @@
+#pragma once
+
+#ifndef NETWORK_SERVER_BATCHER_HPP_
+#define NETWORK_SERVER_BATCHER_HPP_
+
+#include "network_core/Network.hpp"
+#include "network_core/ResultCache.hpp"
+#include "Protocol.hpp"
+
+// STL
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+namespace network {
+namespace server {
+  using Clock = std::chrono::steady_clock;
+
+  struct Options {
+    std::size_t               max_batch { 32 };   // Requests processed in one forward pass
+    std::chrono::microseconds max_delay { 2000 }; // Longest wait of the first request of a batch for the others
+    std::size_t               max_queue { 1024 }; // Requests waiting for a batch, the rest are rejected
+  };
+
+  struct Result {
+    Status                  status      { Status::Ok };
+    std::vector<Prediction> predictions { };
+    std::size_t             batch       { 0 };
+    std::uint64_t           latency_ns  { 0 };
+  };
+
+  /**
+   * @brief Latency and throughput of the requests completed since the previous report
+   */
+  struct Report {
+    std::uint64_t requests   { 0 };
+    std::uint64_t rejected   { 0 };
+    std::uint64_t batches    { 0 };
+    double        seconds    { 0.0 };
+    double        p50        { 0.0 }; // Seconds
+    double        p99        { 0.0 }; // Seconds
+    double        max        { 0.0 }; // Seconds
+
+    std::optional<CacheStatistics> cache { }; // Lookups since the previous report if the network has a cache
+
+    double throughput() const noexcept { return seconds > 0.0 ? static_cast<double>(requests) / seconds : 0.0; }
+    double meanBatch() const noexcept { return batches ? static_cast<double>(requests) / static_cast<double>(batches) : 0.0; }
+  };
+
+  std::ostream& operator<<(std::ostream& t_stream, const Report& t_report);
+
+  /**
+   * @brief Groups concurrent requests into micro-batches for Network::perception().
+   *
+   * A batch is run as soon as it is full or when its first request has waited max_delay,
+   * so a single request is never delayed by more than max_delay plus one forward pass.
+   * The network is used only by the thread of the batcher.
+   */
+  class Batcher {
+    public:
+      Batcher(NetworkPtr t_network, const Options& t_options);
+      Batcher(const Batcher&) = delete;
+      Batcher& operator=(const Batcher&) = delete;
+      ~Batcher();
+
+      /**
+       * @brief Queue an image for perception
+       * @param t_image Decoded image.
+       * @param t_top Number of the best categories to return, 0 returns all of them.
+       * @return Result of the request, Status::Overloaded at once if the queue is full.
+       */
+      std::future<Result> submit(cv::Mat t_image, std::size_t t_top);
+
+      /**
+       * @brief Report of the requests completed since the previous call
+       */
+      Report report();
+
+      void stop() noexcept;
+
+    private:
+      struct Request {
+        cv::Mat              image   { };
+        std::size_t          top     { 1 };
+        Clock::time_point    arrival { };
+        std::promise<Result> promise { };
+      };
+
+      void run();
+      void process(std::vector<Request>& t_batch);
+      void complete(Request& t_request, Result t_result);
+
+    private:
+      NetworkPtr m_network { };
+      Options    m_options { };
+
+      std::mutex              m_mutex    { };
+      std::condition_variable m_ready    { };
+      std::deque<Request>     m_queue    { };
+      bool                    m_stopped  { false };
+
+      // Guarded by m_mutex, reset by report().
+      std::vector<std::uint64_t> m_latencies { };
+      std::uint64_t              m_rejected  { 0 };
+      std::uint64_t              m_batches   { 0 };
+      Clock::time_point          m_window    { Clock::now() };
+
+      std::thread m_thread { };
+  };
+} // namespace server
+} // namespace network
+#endif // NETWORK_SERVER_BATCHER_HPP_
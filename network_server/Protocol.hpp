@@ -0,0 +1,204 @@
+#pragma once
+
+#ifndef NETWORK_SERVER_PROTOCOL_HPP_
+#define NETWORK_SERVER_PROTOCOL_HPP_
+
+#include "network_core/Exeption.hpp"
+
+// STL
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// POSIX
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace network {
+namespace server {
+  /**
+   * Requests and responses are fixed headers followed by a payload, both sides run on the same host,
+   * so the integers are in host byte order. A connection may carry any number of requests one after another.
+   */
+  constexpr std::uint32_t REQUEST_MAGIC  { 0x5254454e }; // "NETR"
+  constexpr std::uint32_t RESPONSE_MAGIC { 0x5354454e }; // "NETS"
+  constexpr std::uint64_t MAX_PAYLOAD    { 64u << 20 };
+
+  /**
+   * @brief Encoding of the image in the payload of a request
+   */
+  enum class Format : std::uint32_t {
+    Encoded = 0, // File contents (png, jpeg), decoded by the server
+    Raw     = 1  // 8-bit pixels, rows x cols x channels
+  };
+
+  enum class Status : std::uint32_t {
+    Ok         = 0,
+    BadRequest = 1, // The image can't be decoded or doesn't fit into the network
+    Overloaded = 2, // The queue of the server is full, the request may be retried
+    Error      = 3
+  };
+
+  struct RequestHeader {
+    std::uint32_t magic    { REQUEST_MAGIC };
+    std::uint32_t format   { static_cast<std::uint32_t>(Format::Encoded) };
+    std::uint32_t rows     { 0 }; // Raw only
+    std::uint32_t cols     { 0 }; // Raw only
+    std::uint32_t channels { 0 }; // Raw only
+    std::uint32_t top      { 1 }; // Number of the best categories to return, 0 returns all of them
+    std::uint64_t size     { 0 }; // Bytes of the payload
+  };
+
+  /**
+   * @brief Header of a response, followed by count entries of (double probability, uint32 length, category)
+   */
+  struct ResponseHeader {
+    std::uint32_t magic      { RESPONSE_MAGIC };
+    std::uint32_t status     { static_cast<std::uint32_t>(Status::Ok) };
+    std::uint32_t count      { 0 };
+    std::uint32_t batch      { 0 }; // Size of the batch the request was processed in
+    std::uint64_t latency_ns { 0 }; // Time from the arrival of the request to its result
+  };
+
+  /**
+   * @brief Address of the server: a Unix domain socket or, with a port, TCP on the loopback interface
+   */
+  struct Endpoint {
+    std::string   socket { "/tmp/network_server.sock" };
+    std::uint16_t port   { 0 };
+
+    std::string str() const { return port ? "127.0.0.1:" + std::to_string(port) : socket; }
+  };
+
+  inline bool readAll(int t_descriptor, void* t_data, std::size_t t_size) noexcept
+  {
+    auto* data_ = static_cast<char*>(t_data);
+    while(t_size != 0) {
+      const ssize_t read_ = ::recv(t_descriptor, data_, t_size, 0);
+      if(read_ < 0 && errno == EINTR) continue;
+      if(read_ <= 0) return false;
+
+      data_  += read_;
+      t_size -= static_cast<std::size_t>(read_);
+    }
+    return true;
+  }
+
+  inline bool writeAll(int t_descriptor, const void* t_data, std::size_t t_size) noexcept
+  {
+    const auto* data_ = static_cast<const char*>(t_data);
+    while(t_size != 0) {
+      // A closed peer must not kill the process with SIGPIPE.
+      const ssize_t written_ = ::send(t_descriptor, data_, t_size, MSG_NOSIGNAL);
+      if(written_ < 0 && errno == EINTR) continue;
+      if(written_ <= 0) return false;
+
+      data_  += written_;
+      t_size -= static_cast<std::size_t>(written_);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Opens the listening socket of the endpoint, a stale Unix socket file is replaced
+   * @throws Network::IOError If the socket can't be bound.
+   */
+  inline int listen(const Endpoint& t_endpoint, int t_backlog = 128)
+  {
+    int descriptor_ { -1 };
+
+    if(t_endpoint.port) {
+      descriptor_ = ::socket(AF_INET, SOCK_STREAM, 0);
+      if(descriptor_ < 0) throw IOError("Could not create socket: " + std::string(std::strerror(errno)));
+
+      const int enable_ { 1 };
+      ::setsockopt(descriptor_, SOL_SOCKET, SO_REUSEADDR, &enable_, sizeof(enable_));
+
+      sockaddr_in address_ { };
+      address_.sin_family      = AF_INET;
+      address_.sin_port        = htons(t_endpoint.port);
+      address_.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+      if(::bind(descriptor_, reinterpret_cast<const sockaddr*>(&address_), sizeof(address_)) != 0) {
+        ::close(descriptor_);
+        throw IOError("Could not bind " + t_endpoint.str() + ": " + std::strerror(errno));
+      }
+    } else {
+      sockaddr_un address_ { };
+      if(t_endpoint.socket.size() >= sizeof(address_.sun_path)) {
+        throw IOError("Socket path is too long: " + t_endpoint.socket);
+      }
+
+      descriptor_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      if(descriptor_ < 0) throw IOError("Could not create socket: " + std::string(std::strerror(errno)));
+
+      address_.sun_family = AF_UNIX;
+      std::strncpy(address_.sun_path, t_endpoint.socket.c_str(), sizeof(address_.sun_path) - 1);
+      ::unlink(t_endpoint.socket.c_str());
+
+      if(::bind(descriptor_, reinterpret_cast<const sockaddr*>(&address_), sizeof(address_)) != 0) {
+        ::close(descriptor_);
+        throw IOError("Could not bind " + t_endpoint.str() + ": " + std::strerror(errno));
+      }
+    }
+
+    if(::listen(descriptor_, t_backlog) != 0) {
+      ::close(descriptor_);
+      throw IOError("Could not listen on " + t_endpoint.str() + ": " + std::strerror(errno));
+    }
+
+    return descriptor_;
+  }
+
+  /**
+   * @brief Connects to the endpoint
+   * @throws Network::IOError If the server doesn't accept the connection.
+   */
+  inline int connect(const Endpoint& t_endpoint)
+  {
+    int descriptor_ { -1 };
+    int result_     { -1 };
+
+    if(t_endpoint.port) {
+      descriptor_ = ::socket(AF_INET, SOCK_STREAM, 0);
+      if(descriptor_ < 0) throw IOError("Could not create socket: " + std::string(std::strerror(errno)));
+
+      // Requests are small and answered one by one, Nagle would only add latency.
+      const int enable_ { 1 };
+      ::setsockopt(descriptor_, IPPROTO_TCP, TCP_NODELAY, &enable_, sizeof(enable_));
+
+      sockaddr_in address_ { };
+      address_.sin_family      = AF_INET;
+      address_.sin_port        = htons(t_endpoint.port);
+      address_.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      result_ = ::connect(descriptor_, reinterpret_cast<const sockaddr*>(&address_), sizeof(address_));
+    } else {
+      sockaddr_un address_ { };
+      if(t_endpoint.socket.size() >= sizeof(address_.sun_path)) {
+        throw IOError("Socket path is too long: " + t_endpoint.socket);
+      }
+
+      descriptor_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      if(descriptor_ < 0) throw IOError("Could not create socket: " + std::string(std::strerror(errno)));
+
+      address_.sun_family = AF_UNIX;
+      std::strncpy(address_.sun_path, t_endpoint.socket.c_str(), sizeof(address_.sun_path) - 1);
+      result_ = ::connect(descriptor_, reinterpret_cast<const sockaddr*>(&address_), sizeof(address_));
+    }
+
+    if(result_ != 0) {
+      const std::string error_ { std::strerror(errno) };
+      ::close(descriptor_);
+      throw IOError("Could not connect to " + t_endpoint.str() + ": " + error_);
+    }
+
+    return descriptor_;
+  }
+} // namespace server
+} // namespace network
+#endif // NETWORK_SERVER_PROTOCOL_HPP_
@@ -0,0 +1,153 @@
+#include "Server.hpp"
+
+// STL
+#include <iostream>
+#include <thread>
+
+// POSIX
+#include <poll.h>
+
+namespace network {
+namespace server {
+  namespace {
+    constexpr int POLL_TIMEOUT_MS { 100 }; // How often the loops notice stop()
+
+    bool respond(int t_descriptor, const Result& t_result)
+    {
+      ResponseHeader header_ { };
+      header_.status     = static_cast<std::uint32_t>(t_result.status);
+      header_.count      = static_cast<std::uint32_t>(t_result.predictions.size());
+      header_.batch      = static_cast<std::uint32_t>(t_result.batch);
+      header_.latency_ns = t_result.latency_ns;
+
+      std::string payload_ { reinterpret_cast<const char*>(&header_), sizeof(header_) };
+      for(const auto& prediction : t_result.predictions) {
+        const auto length_ = static_cast<std::uint32_t>(prediction.category.size());
+        payload_.append(reinterpret_cast<const char*>(&prediction.probability), sizeof(prediction.probability));
+        payload_.append(reinterpret_cast<const char*>(&length_), sizeof(length_));
+        payload_.append(prediction.category);
+      }
+
+      return writeAll(t_descriptor, payload_.data(), payload_.size());
+    }
+
+    bool reject(int t_descriptor, Status t_status)
+    {
+      Result result_ { };
+      result_.status = t_status;
+      return respond(t_descriptor, result_);
+    }
+  } // namespace
+
+  Server::Server(Batcher& t_batcher, const Endpoint& t_endpoint)
+  : m_batcher(t_batcher), m_endpoint(t_endpoint), m_descriptor(listen(t_endpoint))
+  {
+  }
+
+  Server::~Server()
+  {
+    stop();
+
+    {
+      // Wake the connections waiting for a request and wait until their threads are done.
+      std::unique_lock<std::mutex> lock(m_mutex);
+      for(const int descriptor : m_connections) {
+        ::shutdown(descriptor, SHUT_RDWR);
+      }
+      m_closed.wait(lock, [this]() { return m_connections.empty(); });
+    }
+
+    ::close(m_descriptor);
+    if(!m_endpoint.port) {
+      ::unlink(m_endpoint.socket.c_str());
+    }
+  }
+
+  void Server::run(double t_interval)
+  {
+    std::cout << "\x1b[32m[INFO] Listening on " << m_endpoint.str() << "\x1b[0m" << std::endl;
+
+    auto report_time_ = Clock::now();
+    while(m_running.load(std::memory_order_relaxed)) {
+      pollfd poll_ { m_descriptor, POLLIN, 0 };
+      if(::poll(&poll_, 1, POLL_TIMEOUT_MS) > 0 && (poll_.revents & POLLIN)) {
+        const int connection_ = ::accept(m_descriptor, nullptr, nullptr);
+        if(connection_ >= 0) {
+          if(m_endpoint.port) {
+            const int enable_ { 1 };
+            ::setsockopt(connection_, IPPROTO_TCP, TCP_NODELAY, &enable_, sizeof(enable_));
+          }
+
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_connections.insert(connection_);
+          std::thread(&Server::serve, this, connection_).detach();
+        }
+      }
+
+      if(t_interval > 0.0 && Clock::now() - report_time_ >= std::chrono::duration<double>(t_interval)) {
+        report_time_ = Clock::now();
+        const auto report_ = m_batcher.report();
+        if(report_.requests || report_.rejected) {
+          std::cout << "\x1b[32m[INFO] " << report_ << "\x1b[0m" << std::endl;
+        }
+      }
+    }
+  }
+
+  void Server::stop() noexcept
+  {
+    m_running.store(false, std::memory_order_relaxed);
+  }
+
+  void Server::serve(int t_descriptor)
+  {
+    while(m_running.load(std::memory_order_relaxed)) {
+      pollfd poll_ { t_descriptor, POLLIN, 0 };
+      const int ready_ = ::poll(&poll_, 1, POLL_TIMEOUT_MS);
+      if(ready_ == 0) continue;
+      if(ready_ < 0 || !handle(t_descriptor)) break;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_connections.erase(t_descriptor);
+    ::close(t_descriptor);
+    m_closed.notify_all();
+  }
+
+  bool Server::handle(int t_descriptor)
+  {
+    RequestHeader header_ { };
+    if(!readAll(t_descriptor, &header_, sizeof(header_))) {
+      return false;
+    }
+
+    // The stream can't be resynchronized after a broken header.
+    if(header_.magic != REQUEST_MAGIC || header_.size > MAX_PAYLOAD) {
+      reject(t_descriptor, Status::BadRequest);
+      return false;
+    }
+
+    std::vector<unsigned char> payload_(header_.size);
+    if(!readAll(t_descriptor, payload_.data(), payload_.size())) {
+      return false;
+    }
+
+    cv::Mat image_ { };
+    if(header_.format == static_cast<std::uint32_t>(Format::Encoded)) {
+      image_ = cv::imdecode(payload_, cv::IMREAD_COLOR);
+    } else if(header_.format == static_cast<std::uint32_t>(Format::Raw)) {
+      const std::uint64_t expected_ = static_cast<std::uint64_t>(header_.rows) * header_.cols * header_.channels;
+      if(header_.channels >= 1 && header_.channels <= 4 && expected_ == payload_.size()) {
+        image_ = cv::Mat(static_cast<int>(header_.rows), static_cast<int>(header_.cols),
+                         CV_8UC(static_cast<int>(header_.channels)), payload_.data()).clone();
+      }
+    }
+
+    if(image_.empty()) {
+      return reject(t_descriptor, Status::BadRequest);
+    }
+
+    return respond(t_descriptor, m_batcher.submit(std::move(image_), header_.top).get());
+  }
+} // namespace server
+} // namespace network
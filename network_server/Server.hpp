@@ -0,0 +1,56 @@
+#pragma once
+
+#ifndef NETWORK_SERVER_SERVER_HPP_
+#define NETWORK_SERVER_SERVER_HPP_
+
+#include "Batcher.hpp"
+#include "Protocol.hpp"
+
+// STL
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+
+namespace network {
+namespace server {
+  /**
+   * @brief Accepts local connections and hands their requests to the batcher, one thread per connection
+   */
+  class Server {
+    public:
+      /**
+       * @throws Network::IOError If the endpoint can't be bound.
+       */
+      Server(Batcher& t_batcher, const Endpoint& t_endpoint);
+      Server(const Server&) = delete;
+      Server& operator=(const Server&) = delete;
+      ~Server();
+
+      /**
+       * @brief Serve until stop(), reporting every t_interval seconds (0 disables the reports)
+       */
+      void run(double t_interval);
+
+      /**
+       * @brief Request the end of run(), safe to call from a signal handler
+       */
+      void stop() noexcept;
+
+    private:
+      void serve(int t_descriptor);
+      bool handle(int t_descriptor);
+
+    private:
+      Batcher&          m_batcher;
+      Endpoint          m_endpoint   { };
+      int               m_descriptor { -1 };
+      std::atomic<bool> m_running    { true };
+
+      std::mutex              m_mutex       { };
+      std::condition_variable m_closed      { };
+      std::set<int>           m_connections { }; // Open connections, each served by a detached thread
+  };
+} // namespace server
+} // namespace network
+#endif // NETWORK_SERVER_SERVER_HPP_
@@ -0,0 +1,325 @@
+#include "network_core/Network.hpp"
+#include "network_core/ResultCache.hpp"
+#include "network_core/utility/Kernels.hpp"
+#include "network_io/io.hpp"
+#include "Batcher.hpp"
+#include "Protocol.hpp"
+#include "Server.hpp"
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+// STL
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  std::atomic<network::server::Server*> running_server_ { nullptr };
+
+  void onSignal(int)
+  {
+    if(auto server_ = running_server_.load()) {
+      server_->stop();
+    }
+  }
+
+  /**
+   * @brief Port given on the command line
+   * @throws std::invalid_argument If the value isn't a number.
+   * @throws std::out_of_range If the value isn't a TCP port.
+   */
+  std::uint16_t port(const std::string& t_value)
+  {
+    const unsigned long port_ = std::stoul(t_value);
+    if(port_ > std::numeric_limits<std::uint16_t>::max()) {
+      throw std::out_of_range("port " + t_value + " is out of range");
+    }
+    return static_cast<std::uint16_t>(port_);
+  }
+
+  int usage(const char* t_name)
+  {
+    std::cout << "Usage:\n"
+              << "  " << t_name << " serve --config config.json [--dataset path] [--model network.model] [--socket path | --port port]\n"
+              << "        [--max-batch 32] [--max-delay-us 2000] [--max-queue 1024] [--cache entries] [--report seconds]\n"
+              << "  " << t_name << " client --image file [--socket path | --port port]\n"
+              << "        [--requests 1000] [--concurrency 8] [--top 1] [--raw]" << std::endl;
+    return 1;
+  }
+
+  int serve(int argc, char* argv[])
+  {
+    std::string config_  { };
+    std::string dataset_ { };
+    std::string model_   { };
+    double report_ { 5.0 };
+    std::size_t cache_ { 0 };
+    network::server::Endpoint endpoint_ { };
+    network::server::Options options_ { };
+
+    // Malformed numbers end in the usage instead of an uncaught exception.
+    try {
+      for(int i = 2; i < argc; ++i) {
+        const std::string arg_ { argv[i] };
+        if(arg_ == "--config" && i + 1 < argc) {
+          config_ = argv[++i];
+        } else if(arg_ == "--dataset" && i + 1 < argc) {
+          dataset_ = argv[++i];
+        } else if(arg_ == "--model" && i + 1 < argc) {
+          model_ = argv[++i];
+        } else if(arg_ == "--socket" && i + 1 < argc) {
+          endpoint_.socket = argv[++i];
+        } else if(arg_ == "--port" && i + 1 < argc) {
+          endpoint_.port = port(argv[++i]);
+        } else if(arg_ == "--max-batch" && i + 1 < argc) {
+          options_.max_batch = std::stoul(argv[++i]);
+        } else if(arg_ == "--max-delay-us" && i + 1 < argc) {
+          options_.max_delay = std::chrono::microseconds(std::stoul(argv[++i]));
+        } else if(arg_ == "--max-queue" && i + 1 < argc) {
+          options_.max_queue = std::stoul(argv[++i]);
+        } else if(arg_ == "--cache" && i + 1 < argc) {
+          cache_ = std::stoul(argv[++i]);
+        } else if(arg_ == "--report" && i + 1 < argc) {
+          report_ = std::stod(argv[++i]);
+        } else {
+          return usage(argv[0]);
+        }
+      }
+    } catch(const std::invalid_argument&) {
+      return usage(argv[0]);
+    } catch(const std::out_of_range&) {
+      return usage(argv[0]);
+    }
+
+    if(config_.empty()) {
+      return usage(argv[0]);
+    }
+
+    auto errors_ = std::make_shared<network::ErrorMessages>();
+    // The dataset sizes the layers from the categories and dimensions, as it did during education.
+    auto network_ = dataset_.empty() ? network::load(config_, errors_) : network::load(dataset_, config_, errors_);
+    if(!network_ || !errors_->empty()) {
+      for(const auto& error : *errors_) {
+        std::cout << "\x1b[31m[ERROR] " << error << "\x1b[0m" << std::endl;
+      }
+      return 1;
+    }
+
+    if(model_.empty()) {
+      std::cout << "\x1b[33m[WARN] No model is given, the network answers with random weights.\x1b[0m" << std::endl;
+    } else {
+      network::restore(*network_->get(), model_);
+    }
+
+    if(cache_) {
+      network_->get()->setCache(std::make_shared<network::ResultCache>(cache_));
+    }
+
+    // The batches go through gemm, its panels are sized for this host before the first request.
+    const auto tiles_ = network::computation::tune();
+    std::cout << "\x1b[32m[INFO] Kernel tiles gemv:" << tiles_.gemv << " gemm:" << tiles_.m << "x" << tiles_.n << "x" << tiles_.k
+              << "\x1b[0m" << std::endl;
+
+    network::server::Batcher batcher_(network::NetworkPtr(std::move(*network_)), options_);
+    network::server::Server server_(batcher_, endpoint_);
+
+    running_server_.store(&server_);
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    server_.run(report_);
+
+    running_server_.store(nullptr);
+    std::cout << "\x1b[32m[INFO] " << batcher_.report() << "\x1b[0m" << std::endl;
+    return 0;
+  }
+
+  int client(int argc, char* argv[])
+  {
+    std::string image_ { };
+    std::size_t requests_ { 1000 };
+    std::size_t concurrency_ { 8 };
+    std::uint32_t top_ { 1 };
+    bool raw_ { false };
+    network::server::Endpoint endpoint_ { };
+
+    try {
+      for(int i = 2; i < argc; ++i) {
+        const std::string arg_ { argv[i] };
+        if(arg_ == "--image" && i + 1 < argc) {
+          image_ = argv[++i];
+        } else if(arg_ == "--socket" && i + 1 < argc) {
+          endpoint_.socket = argv[++i];
+        } else if(arg_ == "--port" && i + 1 < argc) {
+          endpoint_.port = port(argv[++i]);
+        } else if(arg_ == "--requests" && i + 1 < argc) {
+          requests_ = std::stoul(argv[++i]);
+        } else if(arg_ == "--concurrency" && i + 1 < argc) {
+          concurrency_ = std::max<std::size_t>(1, std::stoul(argv[++i]));
+        } else if(arg_ == "--top" && i + 1 < argc) {
+          top_ = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+        } else if(arg_ == "--raw") {
+          raw_ = true;
+        } else {
+          return usage(argv[0]);
+        }
+      }
+    } catch(const std::invalid_argument&) {
+      return usage(argv[0]);
+    } catch(const std::out_of_range&) {
+      return usage(argv[0]);
+    }
+
+    if(image_.empty()) {
+      return usage(argv[0]);
+    }
+
+    network::server::RequestHeader header_ { };
+    header_.top = top_;
+    std::vector<unsigned char> payload_ { };
+
+    if(raw_) {
+      const cv::Mat decoded_ = cv::imread(image_);
+      if(decoded_.empty()) {
+        std::cout << "\x1b[31m[ERROR] Could not decode " << image_ << "\x1b[0m" << std::endl;
+        return 1;
+      }
+
+      const cv::Mat continuous_ = decoded_.isContinuous() ? decoded_ : decoded_.clone();
+      header_.format   = static_cast<std::uint32_t>(network::server::Format::Raw);
+      header_.rows     = static_cast<std::uint32_t>(continuous_.rows);
+      header_.cols     = static_cast<std::uint32_t>(continuous_.cols);
+      header_.channels = static_cast<std::uint32_t>(continuous_.channels());
+      payload_.assign(continuous_.data, continuous_.data + continuous_.total() * continuous_.elemSize());
+    } else {
+      std::ifstream file_(image_, std::ios::binary);
+      if(!file_) {
+        std::cout << "\x1b[31m[ERROR] Could not open " << image_ << "\x1b[0m" << std::endl;
+        return 1;
+      }
+      payload_.assign(std::istreambuf_iterator<char>(file_), std::istreambuf_iterator<char>());
+    }
+    header_.size = payload_.size();
+
+    std::vector<std::vector<double>> latencies_(concurrency_);
+    std::vector<std::size_t> failed_(concurrency_, 0);
+    std::vector<std::uint64_t> batches_(concurrency_, 0);
+    std::vector<std::string> answer_(concurrency_);
+    std::atomic<std::size_t> next_ { 0 };
+
+    const auto begin_ = network::server::Clock::now();
+    std::vector<std::thread> workers_ { };
+    for(std::size_t t = 0; t < concurrency_; ++t) {
+      workers_.emplace_back([&, t]() {
+        int descriptor_ { -1 };
+        try {
+          descriptor_ = network::server::connect(endpoint_);
+        } catch(const network::IOError& e) {
+          std::cout << "\x1b[31m[ERROR] " << e.what() << "\x1b[0m" << std::endl;
+          return;
+        }
+
+        while(next_.fetch_add(1) < requests_) {
+          const auto start_ = network::server::Clock::now();
+          network::server::ResponseHeader response_ { };
+
+          if(!network::server::writeAll(descriptor_, &header_, sizeof(header_))
+          || !network::server::writeAll(descriptor_, payload_.data(), payload_.size())
+          || !network::server::readAll(descriptor_, &response_, sizeof(response_))) {
+            ++failed_[t];
+            break;
+          }
+
+          std::string categories_ { };
+          bool complete_ { true };
+          for(std::uint32_t i = 0; i < response_.count && complete_; ++i) {
+            double probability_ { 0.0 };
+            std::uint32_t length_ { 0 };
+            complete_ = network::server::readAll(descriptor_, &probability_, sizeof(probability_))
+                     && network::server::readAll(descriptor_, &length_, sizeof(length_));
+
+            std::string category_(length_, '\0');
+            complete_ = complete_ && network::server::readAll(descriptor_, category_.data(), category_.size());
+            categories_ += (i ? ", " : "") + category_ + " " + std::to_string(probability_);
+          }
+
+          if(!complete_) {
+            ++failed_[t];
+            break;
+          }
+
+          if(response_.status != static_cast<std::uint32_t>(network::server::Status::Ok)) {
+            ++failed_[t];
+            continue;
+          }
+
+          latencies_[t].push_back(std::chrono::duration<double>(network::server::Clock::now() - start_).count());
+          batches_[t] += response_.batch;
+          answer_[t] = categories_;
+        }
+
+        ::close(descriptor_);
+      });
+    }
+
+    for(auto& worker : workers_) {
+      worker.join();
+    }
+    const double elapsed_ = std::chrono::duration<double>(network::server::Clock::now() - begin_).count();
+
+    std::vector<double> all_ { };
+    std::size_t failed_total_ { 0 };
+    std::uint64_t batch_total_ { 0 };
+    std::string answer_any_ { };
+    for(std::size_t t = 0; t < concurrency_; ++t) {
+      all_.insert(all_.end(), latencies_[t].begin(), latencies_[t].end());
+      failed_total_ += failed_[t];
+      batch_total_  += batches_[t];
+      if(!answer_[t].empty()) answer_any_ = answer_[t];
+    }
+
+    if(all_.empty()) {
+      std::cout << "\x1b[31m[ERROR] No request succeeded, " << failed_total_ << " failed.\x1b[0m" << std::endl;
+      return 1;
+    }
+
+    std::sort(all_.begin(), all_.end());
+    auto percentile_ = [&all_](double t_percentile) {
+      return all_[static_cast<std::size_t>(t_percentile * static_cast<double>(all_.size() - 1))];
+    };
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "\x1b[32m[INFO] " << answer_any_ << "\x1b[0m\n"
+              << "\x1b[32m[INFO] " << all_.size() << " requests, " << static_cast<double>(all_.size()) / elapsed_
+              << " requests/sec, " << static_cast<double>(batch_total_) / static_cast<double>(all_.size())
+              << " mean batch, p50 " << percentile_(0.50) * 1e3 << " ms, p99 " << percentile_(0.99) * 1e3
+              << " ms, max " << all_.back() * 1e3 << " ms, " << failed_total_ << " failed\x1b[0m" << std::endl;
+
+    return failed_total_ ? 1 : 0;
+  }
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+  const std::string mode_ { argc > 1 ? argv[1] : "" };
+
+  try {
+    if(mode_ == "serve") return serve(argc, argv);
+    if(mode_ == "client") return client(argc, argv);
+  } catch(const network::NetworkError& e) {
+    std::cout << "\x1b[31m[ERROR] " << e.what() << "\x1b[0m" << std::endl;
+    return 1;
+  }
+
+  return usage(argv[0]);
+}
@@ -0,0 +1,319 @@
+#include "Sweep.hpp"
+#include "network_core/Exeption.hpp"
+#include "network_core/LogSink.hpp"
+#include "network_core/utility/Json.hpp"
+#include "network_core/utility/ThreadPool.hpp"
+#include "network_io/io.hpp"
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+#include <regex>
+#include <sstream>
+
+namespace network {
+namespace sweep {
+  namespace {
+    constexpr std::size_t SCORE_BATCH { 64 }; // Images of the batched perception while scoring
+
+    /**
+     * @brief Keeps the record of the last epoch
+     */
+    class LastEpoch final : public LogSink {
+      public:
+        bool push(const EpochRecord& t_record) noexcept override
+        {
+          record = t_record;
+          return true;
+        }
+
+        EpochRecord record { };
+    };
+
+    /**
+     * @brief Whether the text is a finite number as JSON writes it, strtod() alone also takes nan, inf, hex and "+1"
+     */
+    bool number(const std::string& t_text)
+    {
+      static const std::regex grammar_ { R"(-?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?)" };
+      return std::regex_match(t_text, grammar_) && std::isfinite(std::strtod(t_text.c_str(), nullptr));
+    }
+
+    /**
+     * @brief Value of a parameter as JSON, the values of a tree are strings and are left unquoted if they are numbers
+     */
+    std::string render(const pt::ptree& t_value)
+    {
+      if(t_value.empty()) {
+        const std::string& data_ = t_value.data();
+        const bool literal_ = number(data_) || data_ == "true" || data_ == "false" || data_ == "null";
+        return literal_ ? data_ : utility::quote(data_);
+      }
+
+      const bool array_ = std::all_of(t_value.begin(), t_value.end(), [](const auto& t_child) { return t_child.first.empty(); });
+
+      std::string text_ { array_ ? "[" : "{" };
+      for(auto it = t_value.begin(); it != t_value.end(); ++it) {
+        text_ += (it == t_value.begin() ? "" : ",") + (array_ ? "" : utility::quote(it->first) + ":") + render(it->second);
+      }
+      return text_ + (array_ ? "]" : "}");
+    }
+
+    pt::ptree leaf(double t_value)
+    {
+      std::ostringstream stream_ { };
+      stream_ << std::setprecision(6) << t_value;
+      return pt::ptree(stream_.str());
+    }
+  } // namespace
+
+  std::string Trial::describe() const
+  {
+    std::string text_ { };
+    for(const auto& [key, value] : values) {
+      text_ += (text_.empty() ? "" : " ") + key + "=" + render(value);
+    }
+    return text_;
+  }
+
+  Spec parse(const pt::ptree& t_root)
+  {
+    Spec spec_ { };
+
+    try {
+      const std::string search_ = t_root.get<std::string>("search", "grid");
+      if(search_ != "grid" && search_ != "random") throw ParseError("unknown search " + search_);
+
+      spec_.search     = search_ == "grid" ? Spec::Search::Grid : Spec::Search::Random;
+      spec_.trials     = t_root.get<std::size_t>("trials", 0);
+      spec_.seed       = t_root.get<std::uint64_t>("seed", spec_.seed);
+      spec_.jobs       = t_root.get<std::size_t>("jobs", 0);
+      spec_.validation = t_root.get<std::string>("validation", "");
+
+      for(const auto& [key, values] : t_root.get_child("parameters")) {
+        Parameter parameter_ { key, { }, std::nullopt };
+
+        if(values.get_optional<double>("min") && values.get_optional<double>("max")) {
+          parameter_.range = Range { values.get<double>("min"), values.get<double>("max"), values.get<bool>("log", false) };
+          if(parameter_.range->min > parameter_.range->max || (parameter_.range->log && parameter_.range->min <= 0.0)) {
+            throw ParseError("range of " + key + " is empty or not positive on a logarithmic scale");
+          }
+        } else {
+          for(const auto& value : values) {
+            parameter_.values.push_back(value.second);
+          }
+          if(parameter_.values.empty()) throw ParseError("parameter " + key + " has no values");
+        }
+
+        spec_.parameters.push_back(std::move(parameter_));
+      }
+    } catch(const pt::ptree_error& e) {
+      throw ParseError(e.what());
+    }
+
+    if(spec_.search == Spec::Search::Random && spec_.trials == 0) {
+      throw ParseError("random search needs the number of trials");
+    }
+
+    return spec_;
+  }
+
+  std::vector<Trial> expand(const Spec& t_spec)
+  {
+    std::vector<Trial> trials_ { };
+
+    if(t_spec.search == Spec::Search::Grid) {
+      std::size_t count_ { 1 };
+      for(const auto& parameter : t_spec.parameters) {
+        if(parameter.range) throw ParseError("the grid can't search the range of " + parameter.key);
+        count_ *= parameter.values.size();
+      }
+
+      // Every combination, the last parameter changes fastest.
+      for(std::size_t t = 0; t < count_; ++t) {
+        Trial trial_ { t, { } };
+        std::size_t rest_ = t;
+        for(std::size_t p = t_spec.parameters.size(); p != 0; --p) {
+          const auto& parameter_ = t_spec.parameters[p - 1];
+          trial_.values.emplace_back(parameter_.key, parameter_.values[rest_ % parameter_.values.size()]);
+          rest_ /= parameter_.values.size();
+        }
+        std::reverse(trial_.values.begin(), trial_.values.end());
+        trials_.push_back(std::move(trial_));
+      }
+
+      return trials_;
+    }
+
+    std::mt19937_64 random_ { t_spec.seed };
+    for(std::size_t t = 0; t < t_spec.trials; ++t) {
+      Trial trial_ { t, { } };
+      for(const auto& parameter : t_spec.parameters) {
+        if(parameter.range) {
+          const auto& [min, max, log] = *parameter.range;
+          std::uniform_real_distribution<double> value_(log ? std::log(min) : min, log ? std::log(max) : max);
+          trial_.values.emplace_back(parameter.key, leaf(log ? std::exp(value_(random_)) : value_(random_)));
+        } else {
+          std::uniform_int_distribution<std::size_t> index_(0, parameter.values.size() - 1);
+          trial_.values.emplace_back(parameter.key, parameter.values[index_(random_)]);
+        }
+      }
+      trials_.push_back(std::move(trial_));
+    }
+
+    return trials_;
+  }
+
+  double accuracy(Network& t_network, const Dataset& t_dataset)
+  {
+    const auto& samples_ = t_dataset.samples();
+    if(samples_.empty()) {
+      return 0.0;
+    }
+
+    std::size_t correct_ { 0 };
+    std::vector<cv::Mat> batch_ { };
+    for(std::size_t begin = 0; begin < samples_.size(); begin += SCORE_BATCH) {
+      const std::size_t end_ = std::min(begin + SCORE_BATCH, samples_.size());
+
+      batch_.clear();
+      for(std::size_t i = begin; i < end_; ++i) {
+        batch_.push_back(samples_[i].first);
+      }
+
+      const auto predictions_ = t_network.perception(batch_, 1);
+      for(std::size_t i = begin; i < end_; ++i) {
+        const auto& best_ = predictions_[i - begin];
+        correct_ += (!best_.empty() && best_.front().category == t_dataset.categorys()[samples_[i].second]) ? 1 : 0;
+      }
+    }
+
+    return static_cast<double>(correct_) / static_cast<double>(samples_.size());
+  }
+
+  Runner::Runner(pt::ptree t_config, std::string t_dataset, DatasetPtr t_train, DatasetPtr t_validation)
+  : m_config(std::move(t_config)), m_dataset(std::move(t_dataset)), m_train(std::move(t_train)), m_validation(std::move(t_validation))
+  {
+  }
+
+  std::vector<Score> Runner::run(const std::vector<Trial>& t_trials, std::size_t t_jobs, std::ostream& t_progress)
+  {
+    m_best.reset();
+    m_score = Score { };
+
+    std::vector<Score> scores_(t_trials.size());
+    std::size_t finished_ { 0 };
+
+    utility::ThreadPool pool_(std::max<std::size_t>(1, std::min(t_jobs, t_trials.size())));
+    pool_.run(t_trials.size(), [&](std::size_t t_index) {
+      scores_[t_index] = evaluate(t_trials[t_index]);
+
+      const auto& score_ = scores_[t_index];
+      std::lock_guard<std::mutex> lock(m_mutex);
+      t_progress << "[" << ++finished_ << "/" << t_trials.size() << "] trial " << score_.trial.index << ": ";
+      if(score_.failed()) {
+        t_progress << "failed, " << score_.error;
+      } else {
+        t_progress << std::fixed << std::setprecision(4) << "accuracy " << score_.accuracy << ", loss " << score_.loss
+                   << std::setprecision(2) << ", " << score_.seconds << " s";
+      }
+      t_progress << ", " << score_.trial.describe() << std::endl;
+    });
+
+    std::stable_sort(scores_.begin(), scores_.end(), better);
+    return scores_;
+  }
+
+  Score Runner::evaluate(const Trial& t_trial)
+  {
+    Score score_ { t_trial, 0.0, 0.0, 0.0, { } };
+    const auto start_ = std::chrono::steady_clock::now();
+
+    try {
+      pt::ptree config_ = m_config;
+      for(const auto& [key, value] : t_trial.values) {
+        config_.put_child(key, value);
+      }
+
+      auto errors_ = std::make_shared<ErrorMessages>();
+      auto network_ = load(m_dataset, config_, errors_);
+      if(!network_ || !errors_->empty()) {
+        score_.error = errors_->empty() ? "the network can't be created" : errors_->front();
+        return score_;
+      }
+
+      NetworkPtr educated_ { std::move(*network_) };
+      auto epoch_ = std::make_shared<LastEpoch>();
+      educated_->setDataset(m_train);
+      educated_->setLogSink(epoch_);
+      educated_->education();
+
+      score_.loss     = epoch_->record.loss;
+      score_.accuracy = accuracy(*educated_, m_validation ? *m_validation : *m_train);
+      score_.seconds  = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if(!m_best || better(score_, m_score)) {
+        m_best  = educated_;
+        m_score = score_;
+      }
+    } catch(const std::exception& e) {
+      score_.error = e.what();
+    }
+
+    return score_;
+  }
+
+  bool better(const Score& t_a, const Score& t_b) noexcept
+  {
+    if(t_a.failed() != t_b.failed()) return !t_a.failed();
+    if(t_a.accuracy != t_b.accuracy) return t_a.accuracy > t_b.accuracy;
+    return t_a.loss < t_b.loss;
+  }
+
+  void print(std::ostream& t_stream, const std::vector<Score>& t_scores, std::size_t t_top)
+  {
+    const auto flags_ = t_stream.flags();
+    t_stream << std::left << std::setw(6) << "rank" << std::setw(7) << "trial" << std::setw(10) << "accuracy"
+             << std::setw(10) << "loss" << std::setw(10) << "seconds" << "parameters" << "\n";
+
+    const std::size_t count_ = t_top ? std::min(t_top, t_scores.size()) : t_scores.size();
+    for(std::size_t r = 0; r < count_; ++r) {
+      const auto& score_ = t_scores[r];
+      t_stream << std::setw(6) << r + 1 << std::setw(7) << score_.trial.index;
+      if(score_.failed()) {
+        t_stream << std::setw(30) << "failed" << score_.trial.describe() << " (" << score_.error << ")\n";
+        continue;
+      }
+      t_stream << std::fixed << std::setprecision(4) << std::setw(10) << score_.accuracy << std::setw(10) << score_.loss
+               << std::setprecision(2) << std::setw(10) << score_.seconds << score_.trial.describe() << "\n";
+    }
+
+    t_stream.flags(flags_);
+  }
+
+  void write(std::ostream& t_stream, const std::vector<Score>& t_scores)
+  {
+    t_stream << "{\n  \"leaderboard\": [";
+    for(std::size_t r = 0; r < t_scores.size(); ++r) {
+      const auto& score_ = t_scores[r];
+      t_stream << (r ? "," : "") << "\n    {\"rank\": " << r + 1 << ", \"trial\": " << score_.trial.index
+               << ", \"accuracy\": " << score_.accuracy << ", \"loss\": " << score_.loss << ", \"seconds\": " << score_.seconds
+               << ", \"parameters\": {";
+      for(std::size_t p = 0; p < score_.trial.values.size(); ++p) {
+        t_stream << (p ? ", " : "") << utility::quote(score_.trial.values[p].first) << ": " << render(score_.trial.values[p].second);
+      }
+      t_stream << "}";
+      if(score_.failed()) {
+        t_stream << ", \"error\": " << utility::quote(score_.error);
+      }
+      t_stream << "}";
+    }
+    t_stream << "\n  ]\n}\n";
+  }
+} // namespace sweep
+} // namespace network
@@ -0,0 +1,161 @@
+#pragma once
+
+#ifndef NETWORK_SWEEP_SWEEP_HPP_
+#define NETWORK_SWEEP_SWEEP_HPP_
+
+#include "network_core/Network.hpp"
+#include "network_core/Dataset.hpp"
+#include "network_core/Forward.hpp"
+
+// STL
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Boost
+#include <boost/property_tree/ptree.hpp>
+
+namespace network {
+namespace sweep {
+  namespace pt = boost::property_tree;
+
+  /**
+   * @brief Continuous values of a parameter, only the random search draws from it
+   */
+  struct Range {
+    double min { 0.0 };
+    double max { 0.0 };
+    bool   log { false }; // Uniform in the logarithm, for learning rates and other scales
+  };
+
+  /**
+   * @brief Values of one key of config.json tried by the sweep
+   */
+  struct Parameter {
+    std::string            key    { }; // Path in config.json, e.g. "topology.layers.hidden"
+    std::vector<pt::ptree> values { }; // Every value replaces the whole subtree of the key
+    std::optional<Range>   range  { };
+  };
+
+  /**
+   * @brief Search over the parameters, read from the sweep file
+   */
+  struct Spec {
+    enum class Search { Grid, Random };
+
+    Search                 search     { Search::Grid };
+    std::size_t            trials     { 0 };  // Configurations drawn by the random search
+    std::uint64_t          seed       { 1 };
+    std::size_t            jobs       { 0 };  // Networks educated at the same time, 0 uses every core
+    std::string            validation { };    // Dataset folder the networks are scored on, the education dataset otherwise
+    std::vector<Parameter> parameters { };
+  };
+
+  /**
+   * @brief One configuration of the sweep
+   */
+  struct Trial {
+    std::size_t                                    index  { 0 };
+    std::vector<std::pair<std::string, pt::ptree>> values { }; // Key of config.json with the value it gets
+
+    /**
+     * @brief Values as "key=value", separated by spaces
+     */
+    std::string describe() const;
+  };
+
+  /**
+   * @brief Education and score of a trial
+   */
+  struct Score {
+    Trial       trial    { };
+    double      accuracy { 0.0 }; // Share of the scored images whose best category is right
+    double      loss     { 0.0 }; // Mean loss of the last epoch
+    double      seconds  { 0.0 }; // Education and scoring
+    std::string error    { };     // Why the trial failed, empty on success
+
+    inline bool failed() const noexcept { return !error.empty(); }
+  };
+
+  /**
+   * @brief Read the sweep file
+   * @throws Network::ParseError If a key is missing or a parameter has neither values nor a range.
+   */
+  Spec parse(const pt::ptree& t_root);
+
+  /**
+   * @brief Configurations of the search, every combination for the grid and Spec::trials draws otherwise
+   * @throws Network::ParseError If the grid has a range or a parameter without values.
+   */
+  std::vector<Trial> expand(const Spec& t_spec);
+
+  /**
+   * @brief Share of the images of the dataset whose best category is right
+   * @param t_network Educated network whose labels contain the categories of the dataset.
+   */
+  double accuracy(Network& t_network, const Dataset& t_dataset);
+
+  /**
+   * @brief Educates a network for every trial on datasets decoded once and ranks them.
+   *
+   * Every trial builds its network with network::load() from config.json with the values of the trial,
+   * the networks share the decoded images and only read them.
+   */
+  class Runner {
+    public:
+      /**
+       * @param t_config Contents of config.json.
+       * @param t_dataset Path of the education dataset, network::load() checks it.
+       * @param t_train Decoded education dataset.
+       * @param t_validation Decoded dataset the networks are scored on, nullptr scores on t_train.
+       */
+      Runner(pt::ptree t_config, std::string t_dataset, DatasetPtr t_train, DatasetPtr t_validation);
+
+      /**
+       * @brief Educate and score all trials
+       * @param t_jobs Networks educated at the same time.
+       * @param t_progress Receives a line for every finished trial.
+       * @return Scores ranked by accuracy, then by loss, failed trials last.
+       */
+      std::vector<Score> run(const std::vector<Trial>& t_trials, std::size_t t_jobs, std::ostream& t_progress);
+
+      /**
+       * @brief Network of the best trial of the last run(), nullptr if all of them failed
+       */
+      inline const NetworkPtr& best() const noexcept { return m_best; }
+
+    private:
+      Score evaluate(const Trial& t_trial);
+
+    private:
+      pt::ptree   m_config     { };
+      std::string m_dataset    { };
+      DatasetPtr  m_train      { };
+      DatasetPtr  m_validation { };
+
+      std::mutex  m_mutex      { }; // Guards m_best, m_score and the progress
+      NetworkPtr  m_best       { };
+      Score       m_score      { };
+  };
+
+  /**
+   * @brief Whether a ranks before b
+   */
+  bool better(const Score& t_a, const Score& t_b) noexcept;
+
+  /**
+   * @brief Ranked scores as a table
+   */
+  void print(std::ostream& t_stream, const std::vector<Score>& t_scores, std::size_t t_top);
+
+  /**
+   * @brief Ranked scores as JSON
+   */
+  void write(std::ostream& t_stream, const std::vector<Score>& t_scores);
+} // namespace sweep
+} // namespace network
+#endif // NETWORK_SWEEP_SWEEP_HPP_
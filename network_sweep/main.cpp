@@ -0,0 +1,133 @@
+#include "network_core/Dataset.hpp"
+#include "network_core/utility/ThreadPool.hpp"
+#include "network_io/io.hpp"
+#include "Sweep.hpp"
+
+// Boost
+#include <boost/property_tree/json_parser.hpp>
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  int usage(const char* t_name)
+  {
+    std::cout << "Usage: " << t_name << " --dataset path --config config.json --sweep sweep.json\n"
+              << "        [--jobs n] [--top 10] [--output leaderboard.json] [--model best.model]" << std::endl;
+    return 1;
+  }
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+  std::string dataset_ { };
+  std::string config_  { };
+  std::string sweep_   { };
+  std::string output_  { };
+  std::string model_   { };
+  std::size_t jobs_    { 0 };
+  std::size_t top_     { 10 };
+
+  // Malformed numbers end in the usage instead of an uncaught exception.
+  try {
+    for(int i = 1; i < argc; ++i) {
+      const std::string arg_ { argv[i] };
+      if(arg_ == "--dataset" && i + 1 < argc) {
+        dataset_ = argv[++i];
+      } else if(arg_ == "--config" && i + 1 < argc) {
+        config_ = argv[++i];
+      } else if(arg_ == "--sweep" && i + 1 < argc) {
+        sweep_ = argv[++i];
+      } else if(arg_ == "--jobs" && i + 1 < argc) {
+        jobs_ = std::stoul(argv[++i]);
+      } else if(arg_ == "--top" && i + 1 < argc) {
+        top_ = std::stoul(argv[++i]);
+      } else if(arg_ == "--output" && i + 1 < argc) {
+        output_ = argv[++i];
+      } else if(arg_ == "--model" && i + 1 < argc) {
+        model_ = argv[++i];
+      } else {
+        return usage(argv[0]);
+      }
+    }
+  } catch(const std::invalid_argument&) {
+    return usage(argv[0]);
+  } catch(const std::out_of_range&) {
+    return usage(argv[0]);
+  }
+
+  if(dataset_.empty() || config_.empty() || sweep_.empty()) {
+    return usage(argv[0]);
+  }
+
+  pt::ptree config_root_ { };
+  pt::ptree sweep_root_  { };
+  std::vector<network::sweep::Trial> trials_ { };
+  network::sweep::Spec spec_ { };
+  std::vector<std::string> categorys_ { };
+
+  try {
+    pt::read_json(config_, config_root_);
+    pt::read_json(sweep_, sweep_root_);
+    spec_   = network::sweep::parse(sweep_root_);
+    trials_ = network::sweep::expand(spec_);
+
+    for(const auto& row : config_root_.get_child("category")) {
+      categorys_.push_back(row.second.get_value<std::string>());
+    }
+  } catch(const std::exception& e) {
+    std::cout << "\x1b[31m[ERROR] " << e.what() << "\x1b[0m" << std::endl;
+    return 1;
+  }
+
+  const std::size_t hardware_ = std::max(1u, std::thread::hardware_concurrency());
+  const std::size_t jobs_used_ = jobs_ ? jobs_ : (spec_.jobs ? spec_.jobs : hardware_);
+
+  // The images are decoded once, every network of the sweep reads the same pixels.
+  network::DatasetPtr train_ { };
+  network::DatasetPtr validation_ { };
+  try {
+    const auto start_ = std::chrono::steady_clock::now();
+    const auto pool_ = std::make_shared<network::utility::ThreadPool>(hardware_);
+
+    train_ = std::make_shared<const network::Dataset>(dataset_, categorys_, pool_);
+    if(!spec_.validation.empty()) {
+      validation_ = std::make_shared<const network::Dataset>(spec_.validation, categorys_, pool_);
+    }
+
+    const double seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    std::cout << "\x1b[32m[INFO] Decoded " << train_->samples().size() << " images"
+              << (validation_ ? " and " + std::to_string(validation_->samples().size()) + " validation images" : "")
+              << " (" << (train_->bytes() + (validation_ ? validation_->bytes() : 0)) / 1024 << " KiB) in " << seconds_ << " s\x1b[0m" << std::endl;
+  } catch(const std::exception& e) {
+    std::cout << "\x1b[31m[ERROR] " << e.what() << "\x1b[0m" << std::endl;
+    return 1;
+  }
+
+  std::cout << "\x1b[32m[INFO] " << trials_.size() << " trials on " << std::min(jobs_used_, trials_.size()) << " jobs\x1b[0m" << std::endl;
+
+  network::sweep::Runner runner_(config_root_, dataset_, train_, validation_);
+  const auto scores_ = runner_.run(trials_, jobs_used_, std::cout);
+
+  std::cout << std::endl;
+  network::sweep::print(std::cout, scores_, top_);
+
+  if(!output_.empty()) {
+    std::ofstream file_(output_);
+    network::sweep::write(file_, scores_);
+  }
+
+  if(!model_.empty() && runner_.best()) {
+    network::save(*runner_.best(), model_);
+    std::cout << "\x1b[32m[INFO] Saved the network of trial " << scores_.front().trial.index << " to " << model_ << "\x1b[0m" << std::endl;
+  }
+
+  return scores_.empty() || scores_.front().failed() ? 1 : 0;
+}
@@ -0,0 +1,167 @@
+#include "network_core/Network.hpp"
+#include "network_core/Dataset.hpp"
+#include "network_core/EducationControl.hpp"
+#include "network_core/ImagePool.hpp"
+#include "network_core/utility/Memory.hpp"
+
+// Boost
+#include <boost/filesystem.hpp>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+// STL
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = boost::filesystem;
+
+namespace {
+  constexpr int         SIDE      { 10 };
+  constexpr std::size_t IMAGES    { 8 };  // Images per category
+  constexpr std::size_t EPOCHS    { 4 };
+  constexpr std::size_t WARM_UP   { 2 };  // Epochs that size the buffers and fill the pools
+  constexpr int         SKIPPED   { 77 }; // Return code ctest reports as skipped
+
+  const std::vector<std::string> CATEGORYS { "c0", "c1" };
+
+  /**
+   * @brief Folder with one subfolder of random images per category, removed with the object
+   */
+  struct Folder {
+    fs::path path { fs::temp_directory_path() / fs::unique_path("network_test_%%%%-%%%%") };
+
+    Folder()
+    {
+      for(const auto& category : CATEGORYS) {
+        fs::create_directories(path / category);
+        for(std::size_t i = 0; i < IMAGES; ++i) {
+          cv::Mat image_(SIDE, SIDE, CV_8UC3);
+          cv::randu(image_, 0, 255);
+          cv::imwrite((path / category / (std::to_string(i) + ".png")).string(), image_);
+        }
+      }
+    }
+
+    Folder(const Folder&) = delete;
+    Folder& operator=(const Folder&) = delete;
+
+    ~Folder()
+    {
+      boost::system::error_code error;
+      fs::remove_all(path, error);
+    }
+  };
+
+  /**
+   * @brief Counts the allocations of the educating thread between two samples after the warm-up
+   */
+  class Probe final : public network::EducationControl {
+    public:
+      bool proceed(const network::EducationProgress& t_progress) override
+      {
+        const std::uint64_t allocations_ = network::allocation::counters().allocations;
+
+        // The first call of an epoch follows its setup, the last one the logging of the epoch.
+        if(t_progress.epoch >= WARM_UP && !t_progress.end && t_progress.samples > 1) {
+          allocations += allocations_ - m_last;
+          ++samples;
+        }
+
+        m_last = network::allocation::counters().allocations;
+        return true;
+      }
+
+      std::uint64_t allocations { 0 };
+      std::uint64_t samples     { 0 };
+
+    private:
+      std::uint64_t m_last { 0 };
+  };
+
+  std::unique_ptr<network::Network> makeNetwork()
+  {
+    network::InputLayer  input  { };
+    network::HiddenLayer hidden { };
+    network::OutputLayer output { };
+
+    input.create(SIDE * SIDE, std::true_type{});
+    hidden.create(16, std::false_type{});
+    output.create(CATEGORYS.size(), std::true_type{});
+
+    auto network_ = std::make_unique<network::Network>(input, hidden, output);
+    network_->setCategorys(CATEGORYS);
+    network_->setEpoch(EPOCHS);
+    network_->setImagePool(std::make_shared<network::ImagePool>(SIDE, SIDE));
+
+    // The first epoch clones every sample into the replay buffer, the rehearsal stays off.
+    network_->setReplay({ 0, 1 });
+    return network_;
+  }
+
+  /**
+   * @brief Most allocations the decoder of OpenCV makes for one image of the folder, decoding into a buffer of the right size
+   *
+   * The network can't avoid them, a real OpenCV build creates the state of its decoder on every call.
+   */
+  std::uint64_t decoder(const Folder& t_folder)
+  {
+    std::vector<unsigned char> bytes_ { };
+    cv::Mat image_(SIDE, SIDE, CV_8UC3);
+    std::uint64_t most_ { 0 };
+
+    for(fs::recursive_directory_iterator it(t_folder.path), end; it != end; ++it) {
+      if(!fs::is_regular_file(it->path()) || !network::ImagePool::load(it->path().string(), bytes_)) {
+        continue;
+      }
+
+      image_ = cv::imdecode(bytes_, cv::IMREAD_COLOR, &image_);
+      const std::uint64_t before_ = network::allocation::counters().allocations;
+      image_ = cv::imdecode(bytes_, cv::IMREAD_COLOR, &image_);
+      most_ = std::max(most_, network::allocation::counters().allocations - before_);
+    }
+
+    return most_;
+  }
+
+  /**
+   * @param t_decoder Allocations of the decoder allowed per sample.
+   * @return Whether the samples after the warm-up made no allocations of their own.
+   */
+  bool check(const std::string& t_name, network::Network& t_network, std::uint64_t t_decoder)
+  {
+    const auto probe_ = std::make_shared<Probe>();
+    t_network.setEducationControl(probe_);
+    t_network.education();
+
+    const bool passed_ = probe_->samples > 0 && probe_->allocations <= probe_->samples * t_decoder;
+    std::cout << (passed_ ? "\x1b[32m[INFO] " : "\x1b[31m[ERROR] ") << t_name << ": " << probe_->allocations
+              << " allocations over " << probe_->samples << " samples, " << t_decoder << " per sample allowed for the decoder\x1b[0m" << std::endl;
+    return passed_;
+  }
+} // namespace
+
+auto main() -> int
+{
+  if(!network::allocation::enabled()) {
+    std::cout << "\x1b[33m[WARN] network_core is built without NETWORK_COUNT_ALLOCATIONS, nothing is counted.\x1b[0m" << std::endl;
+    return SKIPPED;
+  }
+
+  const Folder folder_ { };
+  bool passed_ { true };
+
+  auto folder_network_ = makeNetwork();
+  folder_network_->setDataset(folder_.path.string());
+  passed_ &= check("folder", *folder_network_, decoder(folder_));
+
+  auto decoded_network_ = makeNetwork();
+  decoded_network_->setDataset(std::make_shared<const network::Dataset>(folder_.path.string(), CATEGORYS));
+  passed_ &= check("decoded", *decoded_network_, 0);
+
+  return passed_ ? 0 : 1;
+}
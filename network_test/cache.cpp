@@ -0,0 +1,99 @@
+#include "network_core/Network.hpp"
+#include "network_core/ResultCache.hpp"
+
+// Boost
+#include <boost/filesystem.hpp>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+// STL
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = boost::filesystem;
+
+namespace {
+  constexpr int SIDE { 10 };
+
+  /**
+   * @brief One random image, removed with the object
+   */
+  struct Image {
+    fs::path path { fs::temp_directory_path() / fs::unique_path("network_test_%%%%-%%%%.png") };
+
+    Image()
+    {
+      cv::Mat image_(SIDE, SIDE, CV_8UC3);
+      cv::randu(image_, 0, 255);
+      cv::imwrite(path.string(), image_);
+    }
+
+    Image(const Image&) = delete;
+    Image& operator=(const Image&) = delete;
+
+    ~Image()
+    {
+      boost::system::error_code error;
+      fs::remove(path, error);
+    }
+  };
+
+  std::unique_ptr<network::Network> makeNetwork()
+  {
+    network::InputLayer  input  { };
+    network::HiddenLayer hidden { };
+    network::OutputLayer output { };
+
+    input.create(SIDE * SIDE, std::true_type{});
+    hidden.create(8, std::false_type{});
+    output.create(2, std::true_type{});
+
+    return std::make_unique<network::Network>(input, hidden, output);
+  }
+
+  /**
+   * @return Whether every prediction carries one of the labels.
+   */
+  bool labelled(const std::vector<network::Prediction>& t_predictions, const std::vector<std::string>& t_labels)
+  {
+    return !t_predictions.empty() && std::all_of(t_predictions.begin(), t_predictions.end(), [&](const auto& e) {
+      return std::find(t_labels.begin(), t_labels.end(), e.category) != t_labels.end();
+    });
+  }
+
+  bool check(const std::string& t_name, bool t_passed)
+  {
+    std::cout << (t_passed ? "\x1b[32m[INFO] " : "\x1b[31m[ERROR] ") << t_name << "\x1b[0m" << std::endl;
+    return t_passed;
+  }
+} // namespace
+
+auto main() -> int
+{
+  const Image image_ { };
+  const std::vector<std::string> before_ { "before0", "before1" };
+  const std::vector<std::string> after_  { "after0", "after1" };
+
+  auto network_ = makeNetwork();
+  const auto cache_ = std::make_shared<network::ResultCache>(8);
+  network_->setCache(cache_);
+  network_->setLabels(before_);
+
+  bool passed_ { true };
+
+  const auto first_  = network_->perception(image_.path.string(), 0);
+  const auto second_ = network_->perception(image_.path.string(), 0);
+  passed_ &= check("the first perception carries the labels", labelled(first_, before_));
+  passed_ &= check("the same image is answered from the cache", cache_->statistics().hits == 1 && labelled(second_, before_));
+
+  // New labels change the answer as much as new weights, the cached predictions are stale.
+  network_->setLabels(after_);
+  const auto relabelled_ = network_->perception(image_.path.string(), 0);
+  passed_ &= check("a relabel drops the cached predictions", labelled(relabelled_, after_));
+
+  return passed_ ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+#include "ParameterServer.hpp"
+#include "network_core/Exeption.hpp"
+
+// STL
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <string>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace network {
+namespace trainer {
+  namespace {
+    constexpr std::size_t ALIGNMENT { 64 };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared parameters need lock-free 64-bit atomics");
+
+    inline std::size_t align(std::size_t t_bytes) noexcept
+    {
+      return (t_bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    inline std::uint64_t bits(double t_value) noexcept
+    {
+      std::uint64_t bits_ { 0 };
+      std::memcpy(&bits_, &t_value, sizeof(bits_));
+      return bits_;
+    }
+
+    inline double value(std::uint64_t t_bits) noexcept
+    {
+      double value_ { 0.0 };
+      std::memcpy(&value_, &t_bits, sizeof(value_));
+      return value_;
+    }
+  } // namespace
+
+  ParameterServer::ParameterServer(std::size_t t_parameters, std::size_t t_workers)
+  : m_size(t_parameters), m_workers(t_workers)
+  {
+    const std::size_t reports_    = align(sizeof(Header));
+    const std::size_t parameters_ = reports_ + align(sizeof(WorkerReport) * t_workers);
+    m_bytes = parameters_ + sizeof(std::atomic<std::uint64_t>) * t_parameters;
+
+    const std::string name_ = "/network-parameters-" + std::to_string(::getpid());
+    const int descriptor_ = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(descriptor_ < 0) {
+      throw IOError("Could not create shared memory " + name_ + ": " + std::strerror(errno));
+    }
+
+    // Forked workers inherit the mapping, the name isn't needed any more.
+    ::shm_unlink(name_.c_str());
+
+    if(::ftruncate(descriptor_, static_cast<off_t>(m_bytes)) != 0) {
+      ::close(descriptor_);
+      throw IOError("Could not size shared memory " + name_ + ": " + std::strerror(errno));
+    }
+
+    m_segment = ::mmap(nullptr, m_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor_, 0);
+    ::close(descriptor_);
+    if(m_segment == MAP_FAILED) {
+      m_segment = nullptr;
+      throw IOError("Could not map shared memory " + name_ + ": " + std::strerror(errno));
+    }
+
+    auto* bytes_ = static_cast<unsigned char*>(m_segment);
+    m_header     = new (bytes_) Header();
+    m_reports    = reinterpret_cast<WorkerReport*>(bytes_ + reports_);
+    m_parameters = reinterpret_cast<std::atomic<std::uint64_t>*>(bytes_ + parameters_);
+    for(std::size_t w = 0; w < t_workers; ++w) new (m_reports + w) WorkerReport();
+    for(std::size_t i = 0; i < t_parameters; ++i) new (m_parameters + i) std::atomic<std::uint64_t>(0);
+
+    // A worker that dies while it holds the mutex doesn't block the others.
+    pthread_mutexattr_t mutex_attributes_;
+    pthread_mutexattr_init(&mutex_attributes_);
+    pthread_mutexattr_setpshared(&mutex_attributes_, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&mutex_attributes_, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&m_header->mutex, &mutex_attributes_);
+    pthread_mutexattr_destroy(&mutex_attributes_);
+
+    pthread_condattr_t cond_attributes_;
+    pthread_condattr_init(&cond_attributes_);
+    pthread_condattr_setpshared(&cond_attributes_, PTHREAD_PROCESS_SHARED);
+    pthread_cond_init(&m_header->changed, &cond_attributes_);
+    pthread_condattr_destroy(&cond_attributes_);
+  }
+
+  ParameterServer::~ParameterServer()
+  {
+    if(m_segment) {
+      ::munmap(m_segment, m_bytes);
+    }
+  }
+
+  void ParameterServer::write(const std::vector<double>& t_parameters) noexcept
+  {
+    for(std::size_t i = 0; i < m_size && i < t_parameters.size(); ++i) {
+      m_parameters[i].store(bits(t_parameters[i]), std::memory_order_relaxed);
+    }
+  }
+
+  void ParameterServer::read(std::vector<double>& t_parameters) const
+  {
+    t_parameters.resize(m_size);
+    for(std::size_t i = 0; i < m_size; ++i) {
+      t_parameters[i] = value(m_parameters[i].load(std::memory_order_relaxed));
+    }
+  }
+
+  void ParameterServer::add(const std::vector<double>& t_delta) noexcept
+  {
+    for(std::size_t i = 0; i < m_size && i < t_delta.size(); ++i) {
+      if(t_delta[i] == 0.0) {
+        continue;
+      }
+
+      // Other workers may add to the same parameter, the addition is retried on their result.
+      std::uint64_t expected_ = m_parameters[i].load(std::memory_order_relaxed);
+      while(!m_parameters[i].compare_exchange_weak(expected_, bits(value(expected_) + t_delta[i]), std::memory_order_relaxed)) {
+      }
+    }
+  }
+
+  bool ParameterServer::await(std::uint64_t t_epoch)
+  {
+    lock();
+    while(!m_header->stopped && !(m_header->started && m_header->epoch >= t_epoch)) {
+      if(pthread_cond_wait(&m_header->changed, &m_header->mutex) == EOWNERDEAD) {
+        pthread_mutex_consistent(&m_header->mutex);
+      }
+    }
+    const bool stopped_ = m_header->stopped;
+    unlock();
+    return !stopped_;
+  }
+
+  void ParameterServer::arrive(std::size_t t_worker, const WorkerReport& t_report)
+  {
+    lock();
+    m_reports[t_worker] = t_report;
+    ++m_header->arrived;
+    pthread_cond_broadcast(&m_header->changed);
+    unlock();
+  }
+
+  void ParameterServer::release(std::uint64_t t_epoch)
+  {
+    lock();
+    m_header->epoch   = t_epoch;
+    m_header->started = true;
+    m_header->arrived = 0;
+    pthread_cond_broadcast(&m_header->changed);
+    unlock();
+  }
+
+  bool ParameterServer::gather(std::vector<WorkerReport>& t_reports, const std::function<bool()>& t_alive)
+  {
+    lock();
+    while(m_header->arrived < m_workers) {
+      timespec deadline_ { };
+      ::clock_gettime(CLOCK_REALTIME, &deadline_);
+      deadline_.tv_nsec += 100 * 1000 * 1000;
+      if(deadline_.tv_nsec >= 1000 * 1000 * 1000) {
+        deadline_.tv_nsec -= 1000 * 1000 * 1000;
+        ++deadline_.tv_sec;
+      }
+
+      if(pthread_cond_timedwait(&m_header->changed, &m_header->mutex, &deadline_) == EOWNERDEAD) {
+        pthread_mutex_consistent(&m_header->mutex);
+      }
+      if(m_header->arrived < m_workers && !t_alive()) {
+        unlock();
+        return false;
+      }
+    }
+
+    t_reports.assign(m_reports, m_reports + m_workers);
+    unlock();
+    return true;
+  }
+
+  void ParameterServer::stop()
+  {
+    lock();
+    m_header->stopped = true;
+    pthread_cond_broadcast(&m_header->changed);
+    unlock();
+  }
+
+  void ParameterServer::lock()
+  {
+    if(pthread_mutex_lock(&m_header->mutex) == EOWNERDEAD) {
+      pthread_mutex_consistent(&m_header->mutex);
+    }
+  }
+
+  void ParameterServer::unlock()
+  {
+    pthread_mutex_unlock(&m_header->mutex);
+  }
+} // namespace trainer
+} // namespace network
@@ -0,0 +1,122 @@
+#pragma once
+
+#ifndef NETWORK_TRAINER_PARAMETER_SERVER_HPP_
+#define NETWORK_TRAINER_PARAMETER_SERVER_HPP_
+
+// STL
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// POSIX
+#include <pthread.h>
+
+namespace network {
+namespace trainer {
+  /**
+   * @brief What a worker did in one epoch
+   */
+  struct WorkerReport {
+    std::uint64_t samples { 0 };
+    std::uint64_t pushes  { 0 };   // Deltas added to the shared parameters
+    double        loss    { 0.0 }; // Sum of the losses before the updates
+  };
+
+  /**
+   * @brief Parameters of a network in a POSIX shared-memory segment, shared by forked worker processes.
+   *
+   * The parameters are doubles in the order of Network::parameters(). Workers add the deltas of their
+   * local updates without locks, one atomic addition per parameter, and read the sum of everybody's
+   * deltas back. A process-shared barrier separates the epochs: the coordinator releases an epoch,
+   * every worker arrives with its report and the coordinator gathers the reports before the next one.
+   *
+   * The segment is unlinked as soon as it is mapped, it lives as long as the coordinator or a worker
+   * forked after the construction maps it, and nothing is left behind if a process dies.
+   */
+  class ParameterServer {
+    public:
+      /**
+       * @param t_parameters Number of parameters of the network.
+       * @param t_workers Number of worker processes.
+       * @throws Network::IOError If the segment can't be created or mapped.
+       */
+      ParameterServer(std::size_t t_parameters, std::size_t t_workers);
+
+      ParameterServer(const ParameterServer&) = delete;
+      ParameterServer& operator=(const ParameterServer&) = delete;
+      ~ParameterServer();
+
+      inline std::size_t size() const noexcept { return m_size; }
+      inline std::size_t workers() const noexcept { return m_workers; }
+
+      /**
+       * @brief Replace all parameters, only while no worker adds
+       */
+      void write(const std::vector<double>& t_parameters) noexcept;
+
+      /**
+       * @brief Current parameters, concurrent additions may be seen in part
+       */
+      void read(std::vector<double>& t_parameters) const;
+
+      /**
+       * @brief Add a delta to every parameter
+       */
+      void add(const std::vector<double>& t_delta) noexcept;
+
+      /**
+       * @brief Worker: wait until the coordinator releases the epoch
+       * @return False if the coordinator stopped the education.
+       */
+      bool await(std::uint64_t t_epoch);
+
+      /**
+       * @brief Worker: hand over the report of the released epoch
+       */
+      void arrive(std::size_t t_worker, const WorkerReport& t_report);
+
+      /**
+       * @brief Coordinator: start an epoch, the reports of the previous one are dropped
+       */
+      void release(std::uint64_t t_epoch);
+
+      /**
+       * @brief Coordinator: wait until every worker arrived
+       * @param t_reports Report of every worker.
+       * @param t_alive Checked while waiting, false gives up.
+       * @return False if t_alive gave up before all workers arrived.
+       */
+      bool gather(std::vector<WorkerReport>& t_reports, const std::function<bool()>& t_alive);
+
+      /**
+       * @brief Coordinator: let every waiting worker return from await()
+       */
+      void stop();
+
+    private:
+      struct Header {
+        pthread_mutex_t mutex   { };
+        pthread_cond_t  changed { };
+        std::uint64_t   epoch   { 0 };
+        std::uint64_t   arrived { 0 }; // Workers done with the released epoch
+        bool            started { false };
+        bool            stopped { false };
+      };
+
+      void lock();
+      void unlock();
+
+    private:
+      std::size_t                 m_size       { 0 };
+      std::size_t                 m_workers    { 0 };
+      std::size_t                 m_bytes      { 0 };
+      void*                       m_segment    { nullptr };
+      Header*                     m_header     { nullptr };
+      WorkerReport*               m_reports    { nullptr };
+      std::atomic<std::uint64_t>* m_parameters { nullptr }; // Bits of the doubles
+  };
+} // namespace trainer
+} // namespace network
+#endif // NETWORK_TRAINER_PARAMETER_SERVER_HPP_
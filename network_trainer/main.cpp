@@ -0,0 +1,285 @@
+#include "network_core/Dataset.hpp"
+#include "network_core/utility/Numa.hpp"
+#include "network_core/utility/ThreadPool.hpp"
+#include "network_io/io.hpp"
+#include "ParameterServer.hpp"
+
+// Boost
+#include <boost/property_tree/json_parser.hpp>
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// POSIX
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+  struct Options {
+    std::string dataset    { };
+    std::string config     { };
+    std::string checkpoint { };     // Model written by the coordinator, empty writes none
+    std::size_t every      { 1 };   // Epochs between checkpoints, the last epoch is always written
+    std::size_t workers    { 0 };   // Worker processes, 0 uses every core
+    std::size_t sync       { 32 };  // Samples a worker educates between pushes of its delta
+    bool        pin        { false }; // Bind worker i to utility::placement(workers)[i]
+  };
+
+  int usage(const char* t_name)
+  {
+    std::cout << "Usage: " << t_name << " --dataset path --config config.json [--workers n] [--sync 32] [--pin]\n"
+              << "        [--checkpoint network.model] [--checkpoint-every 1]" << std::endl;
+    return 1;
+  }
+
+  /**
+   * @brief Network of a process, built from the configuration without pruning: the shared parameters have a fixed size
+   */
+  network::NetworkPtr create(const Options& t_options, const pt::ptree& t_config, const network::Dataset& t_dataset)
+  {
+    auto errors_ = std::make_shared<network::ErrorMessages>();
+    auto network_ = network::load(t_options.dataset, t_config, errors_);
+    if(!network_ || !errors_->empty()) {
+      throw network::ParseError(errors_->empty() ? "the network can't be created" : errors_->front());
+    }
+
+    network::NetworkPtr created_ { std::move(*network_) };
+    created_->setPruning(network::Pruning { });
+    created_->setLabels(t_dataset.categorys());
+    return created_;
+  }
+
+  /**
+   * @brief Educate the shard of a worker epoch by epoch, pushing the delta of the local updates every t_options.sync samples
+   */
+  int work(std::size_t t_worker, const Options& t_options, const pt::ptree& t_config, const network::Dataset& t_dataset,
+           network::trainer::ParameterServer& t_server)
+  {
+    try {
+      // The replica of the network is built after the binding, its pages come from the worker's node.
+      if(t_options.pin && !network::utility::pin(network::utility::placement(t_server.workers())[t_worker])) {
+        std::cout << "\x1b[33m[WARN] Worker " << t_worker << " could not be bound to its CPU\x1b[0m" << std::endl;
+      }
+
+      auto network_ = create(t_options, t_config, t_dataset);
+
+      std::vector<double> base_ { };
+      std::vector<double> delta_ { };
+      network::trainer::WorkerReport report_ { };
+
+      const auto push = [&]() {
+        delta_ = network_->parameters();
+        for(std::size_t i = 0; i < delta_.size(); ++i) {
+          delta_[i] -= base_[i];
+        }
+        t_server.add(delta_);
+        ++report_.pushes;
+
+        // The next updates start from the sum of every worker's deltas.
+        t_server.read(base_);
+        network_->setParameters(base_);
+      };
+
+      const auto& samples_ = t_dataset.samples();
+      for(std::uint64_t epoch = 0; t_server.await(epoch); ++epoch) {
+        report_ = network::trainer::WorkerReport { };
+        t_server.read(base_);
+        network_->setParameters(base_);
+
+        // Samples are dealt round-robin, the shards are disjoint and mix the categories.
+        std::size_t pending_ { 0 };
+        for(std::size_t i = t_worker; i < samples_.size(); i += t_server.workers()) {
+          const auto& [image, label] = samples_[i];
+          report_.loss += network_->learn(image, t_dataset.categorys()[label]);
+          ++report_.samples;
+
+          if(++pending_ == t_options.sync) {
+            push();
+            pending_ = 0;
+          }
+        }
+
+        if(pending_) {
+          push();
+        }
+
+        t_server.arrive(t_worker, report_);
+      }
+    } catch(const std::exception& e) {
+      std::cout << "\x1b[31m[ERROR] Worker " << t_worker << ": " << e.what() << "\x1b[0m" << std::endl;
+      return 1;
+    }
+
+    return 0;
+  }
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+  Options options_ { };
+
+  // Malformed numbers end in the usage instead of an uncaught exception.
+  try {
+    for(int i = 1; i < argc; ++i) {
+      const std::string arg_ { argv[i] };
+      if(arg_ == "--dataset" && i + 1 < argc) {
+        options_.dataset = argv[++i];
+      } else if(arg_ == "--config" && i + 1 < argc) {
+        options_.config = argv[++i];
+      } else if(arg_ == "--workers" && i + 1 < argc) {
+        options_.workers = std::stoul(argv[++i]);
+      } else if(arg_ == "--sync" && i + 1 < argc) {
+        options_.sync = std::max<std::size_t>(1, std::stoul(argv[++i]));
+      } else if(arg_ == "--checkpoint" && i + 1 < argc) {
+        options_.checkpoint = argv[++i];
+      } else if(arg_ == "--checkpoint-every" && i + 1 < argc) {
+        options_.every = std::max<std::size_t>(1, std::stoul(argv[++i]));
+      } else if(arg_ == "--pin") {
+        options_.pin = true;
+      } else {
+        return usage(argv[0]);
+      }
+    }
+  } catch(const std::invalid_argument&) {
+    return usage(argv[0]);
+  } catch(const std::out_of_range&) {
+    return usage(argv[0]);
+  }
+
+  if(options_.dataset.empty() || options_.config.empty()) {
+    return usage(argv[0]);
+  }
+
+  const std::size_t hardware_ = std::max(1u, std::thread::hardware_concurrency());
+  const std::size_t workers_ = options_.workers ? options_.workers : hardware_;
+
+  pt::ptree config_ { };
+  std::size_t epochs_ { 0 };
+  network::DatasetPtr dataset_ { };
+  std::size_t parameters_ { 0 };
+
+  try {
+    pt::read_json(options_.config, config_);
+    epochs_ = config_.get<std::size_t>("epoch");
+
+    if(config_.get<double>("pruning.sparsity", 0.0) > 0.0) {
+      std::cout << "\x1b[33m[WARN] Pruning changes the number of parameters, it is disabled.\x1b[0m" << std::endl;
+    }
+
+    std::vector<std::string> categorys_ { };
+    for(const auto& row : config_.get_child("category")) {
+      categorys_.push_back(row.second.get_value<std::string>());
+    }
+
+    // Decoded before the fork, the workers share the pages of the images.
+    dataset_ = std::make_shared<const network::Dataset>(options_.dataset, categorys_, std::make_shared<network::utility::ThreadPool>(hardware_));
+
+    // The coordinator's network is built after the fork, only its size is needed now.
+    parameters_ = create(options_, config_, *dataset_)->parameters().size();
+  } catch(const std::exception& e) {
+    std::cout << "\x1b[31m[ERROR] " << e.what() << "\x1b[0m" << std::endl;
+    return 1;
+  }
+
+  std::unique_ptr<network::trainer::ParameterServer> shared_ { };
+  try {
+    shared_ = std::make_unique<network::trainer::ParameterServer>(parameters_, workers_);
+  } catch(const network::IOError& e) {
+    std::cout << "\x1b[31m[ERROR] " << e.what() << "\x1b[0m" << std::endl;
+    return 1;
+  }
+
+  auto& server_ = *shared_;
+  std::cout << "\x1b[32m[INFO] " << parameters_ << " shared parameters, " << dataset_->samples().size() << " images, "
+            << workers_ << " workers, " << epochs_ << " epochs, " << network::utility::numaNodes().size()
+            << " NUMA nodes\x1b[0m" << std::endl;
+
+  std::vector<pid_t> children_ { };
+  for(std::size_t w = 0; w < workers_; ++w) {
+    const pid_t child_ = ::fork();
+    if(child_ == 0) {
+      ::_exit(work(w, options_, config_, *dataset_, server_));
+    }
+    if(child_ < 0) {
+      std::cout << "\x1b[31m[ERROR] Could not start worker " << w << "\x1b[0m" << std::endl;
+      server_.stop();
+      break;
+    }
+    children_.push_back(child_);
+  }
+
+  const auto alive = [&children_]() {
+    for(const auto child : children_) {
+      int status_ { 0 };
+      if(::waitpid(child, &status_, WNOHANG) == child) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  int result_ { children_.size() == workers_ ? 0 : 1 };
+  try {
+    auto network_ = create(options_, config_, *dataset_);
+    server_.write(network_->parameters());
+
+    std::vector<network::trainer::WorkerReport> reports_ { };
+    for(std::size_t epoch = 0; epoch < epochs_ && result_ == 0; ++epoch) {
+      const auto start_ = std::chrono::steady_clock::now();
+
+      server_.release(epoch);
+      if(!server_.gather(reports_, alive)) {
+        std::cout << "\x1b[31m[ERROR] A worker stopped during epoch " << epoch << "\x1b[0m" << std::endl;
+        result_ = 1;
+        break;
+      }
+
+      network::trainer::WorkerReport total_ { };
+      for(const auto& report : reports_) {
+        total_.samples += report.samples;
+        total_.pushes  += report.pushes;
+        total_.loss    += report.loss;
+      }
+
+      const double seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+      std::cout << "\x1b[32m[INFO] Epoch " << epoch << ": " << total_.samples << " samples, loss "
+                << std::fixed << std::setprecision(4) << (total_.samples ? total_.loss / static_cast<double>(total_.samples) : 0.0)
+                << ", " << total_.pushes << " pushes, " << std::setprecision(2) << seconds_ << " s\x1b[0m" << std::endl;
+      std::cout.unsetf(std::ios::floatfield);
+
+      // Workers wait for the next release, the parameters don't change meanwhile.
+      if(!options_.checkpoint.empty() && ((epoch + 1) % options_.every == 0 || epoch + 1 == epochs_)) {
+        std::vector<double> values_ { };
+        server_.read(values_);
+        network_->setParameters(values_);
+
+        const std::string temporary_ = options_.checkpoint + ".tmp";
+        network::save(*network_, temporary_);
+        fs::rename(temporary_, options_.checkpoint);
+      }
+    }
+  } catch(const std::exception& e) {
+    std::cout << "\x1b[31m[ERROR] " << e.what() << "\x1b[0m" << std::endl;
+    result_ = 1;
+  }
+
+  server_.stop();
+  for(const auto child : children_) {
+    int status_ { 0 };
+    if(result_ != 0) {
+      ::kill(child, SIGTERM);
+    }
+    ::waitpid(child, &status_, 0);
+  }
+
+  return result_;
+}